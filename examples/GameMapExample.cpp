@@ -41,22 +41,24 @@ int main()
     std::cout << "Tile size: " << tileSize.x << "x" << tileSize.y << std::endl;
 
     // Trouver le point de départ du joueur
-    auto spawnPoints = gameMap.getObjectsByType("spawn");
+    Core::FrameVector<const Resources::MapObject *> spawnPoints;
+    gameMap.getObjectsByType("spawn", spawnPoints);
     sf::Vector2f playerPos = {400.0f, 300.0f}; // Position par défaut
 
     if (!spawnPoints.empty())
     {
-        playerPos = spawnPoints[0].position;
+        playerPos = spawnPoints[0]->position;
         std::cout << "Player start position: " << playerPos.x << ", " << playerPos.y << std::endl;
     }
 
     // Trouver les ennemis
-    auto enemies = gameMap.getObjectsByType("enemy");
+    Core::FrameVector<const Resources::MapObject *> enemies;
+    gameMap.getObjectsByType("enemy", enemies);
     std::cout << "Found " << enemies.size() << " enemies" << std::endl;
 
-    for (const auto &enemy : enemies)
+    for (const Resources::MapObject *enemy : enemies)
     {
-        std::cout << "Enemy at: " << enemy.position.x << ", " << enemy.position.y << std::endl;
+        std::cout << "Enemy at: " << enemy->position.x << ", " << enemy->position.y << std::endl;
         // On pourrait créer des entités ennemies ici
     }
 
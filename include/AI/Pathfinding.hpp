@@ -8,6 +8,11 @@
 #include <unordered_map>
 #include <unordered_set>
 
+namespace Core
+{
+    class JobSystem;
+}
+
 namespace AI
 {
     namespace Pathfinding
@@ -67,6 +72,16 @@ namespace AI
             }
         };
 
+        /**
+         * @brief One path query of a batch
+         */
+        struct PathRequest
+        {
+            sf::Vector2i start;
+            sf::Vector2i goal;
+            bool allowDiagonal = true;
+        };
+
         /**
          * @brief A* pathfinding algorithm
          */
@@ -123,6 +138,18 @@ namespace AI
              */
             std::vector<sf::Vector2i> findPath(int startX, int startY, int goalX, int goalY, bool allowDiagonal = true);
 
+            /**
+             * @brief Find several paths at once, spread over a job system
+             *
+             * The grid must not be modified while the batch runs, and the
+             * collision function is called from several threads at once.
+             * @param requests Path queries
+             * @param jobSystem Job system to use, nullptr to search on the calling thread
+             * @return One path per request, in the same order
+             */
+            std::vector<std::vector<sf::Vector2i>> findPaths(const std::vector<PathRequest> &requests,
+                                                             Core::JobSystem *jobSystem = nullptr);
+
             /**
              * @brief Clear all obstacles
              */
@@ -131,11 +158,11 @@ namespace AI
         private:
             /**
              * @brief Get neighbors of a node
-             * @param node Current node
+             * @param position Position of the current node
              * @param allowDiagonal Whether to allow diagonal movement
-             * @return Vector of neighbor positions
+             * @param neighbors Filled with the neighbor positions, cleared first
              */
-            std::vector<sf::Vector2i> getNeighbors(const sf::Vector2i &position, bool allowDiagonal) const;
+            void getNeighbors(const sf::Vector2i &position, bool allowDiagonal, std::vector<sf::Vector2i> &neighbors) const;
 
             /**
              * @brief Calculate heuristic (Manhattan distance)
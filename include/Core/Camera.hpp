@@ -2,9 +2,12 @@
 
 #include <SFML/Graphics.hpp>
 #include <functional>
+#include "EntityHandle.hpp"
 
 namespace Core
 {
+    class EntityManager;
+
     // Cette classe gère la caméra du jeu, avec suivi d'entité et effets
     class Camera
     {
@@ -30,6 +33,9 @@ namespace Core
         // Définir une entité à suivre
         void follow(const sf::Vector2f *targetPosition, bool smoothFollow = true);
 
+        // Suivre la position monde (TransformComponent) d'une entité, tant qu'elle existe
+        void follow(EntityManager &entityManager, EntityHandle target, bool smoothFollow = true);
+
         // Arrêter de suivre
         void stopFollowing();
 
@@ -75,6 +81,10 @@ namespace Core
         // Position cible (pour le suivi)
         const sf::Vector2f *m_targetPosition;
 
+        // Entité cible (pour le suivi d'une entité)
+        EntityManager *m_targetManager;
+        EntityHandle m_targetEntity;
+
         // Utiliser un suivi fluide ou non
         bool m_smoothFollow;
 
@@ -97,6 +107,9 @@ namespace Core
         void applyZoomEffect(float deltaTime);
         void applyPanEffect(float deltaTime);
 
+        // Obtenir la position à suivre, false si aucune cible
+        bool getTargetPosition(sf::Vector2f &position) const;
+
         // Méthode pour maintenir la caméra dans les limites
         void keepInBounds();
     };
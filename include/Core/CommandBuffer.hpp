@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ComponentPool.hpp"
+#include "EntityHandle.hpp"
+#include "EntityManager.hpp"
+
+namespace Core
+{
+
+    /**
+     * @brief Records structural ECS changes to apply them later in one batch
+     *
+     * Systems record entity creation/destruction and component
+     * addition/removal while they iterate, and the changes are applied at a
+     * sync point with apply(). Creations are applied first, then component
+     * additions and removals grouped by component type, then destructions.
+     * For a given entity and component type, only the last addition or
+     * removal recorded is applied: "add then remove" leaves the entity
+     * without the component and "remove then add" with the new one.
+     * Destroying an entity always wins.
+     *
+     * Components are constructed when recorded and moved into their pool on
+     * apply. The recording buffers keep their capacity between batches so
+     * that steady-state frames do not allocate.
+     *
+     * A command buffer is not thread-safe: use one buffer per thread.
+     */
+    class CommandBuffer
+    {
+    public:
+        /**
+         * @brief Target of a command: an existing entity or one created by this buffer
+         */
+        class EntityRef
+        {
+        public:
+            /**
+             * @brief Refer to an existing entity
+             * @param handle Entity handle
+             */
+            EntityRef(EntityHandle handle);
+
+            /**
+             * @brief Check if the entity is created by the command buffer
+             * @return true if the entity does not exist yet
+             */
+            bool isPending() const;
+
+        private:
+            friend class CommandBuffer;
+
+            EntityRef() = default;
+
+            EntityHandle m_handle;
+            std::uint32_t m_pendingIndex = EntityHandle::INVALID_INDEX;
+        };
+
+        CommandBuffer();
+        ~CommandBuffer();
+
+        CommandBuffer(const CommandBuffer &) = delete;
+        CommandBuffer &operator=(const CommandBuffer &) = delete;
+
+        /**
+         * @brief Record the creation of an entity
+         * @param name Optional entity name
+         * @return Reference usable as the target of later commands
+         */
+        EntityRef createEntity(const std::string &name = "");
+
+        /**
+         * @brief Record the destruction of an entity
+         * @param entity Entity to destroy
+         */
+        void destroyEntity(EntityRef entity);
+
+        /**
+         * @brief Record the addition of a component
+         * @tparam T Component type
+         * @tparam Args Constructor arguments types
+         * @param entity Entity receiving the component
+         * @param args Constructor arguments
+         */
+        template <typename T, typename... Args>
+        void addComponent(EntityRef entity, Args &&...args)
+        {
+            Staging<T> &staging = getStaging<T>();
+            std::uint32_t slot = static_cast<std::uint32_t>(staging.values.size());
+            staging.values.emplace_back(std::forward<Args>(args)...);
+            record(CommandType::AddComponent, entity, getComponentTypeId<T>(), slot);
+        }
+
+        /**
+         * @brief Record the removal of a component
+         * @tparam T Component type
+         * @param entity Entity owning the component
+         */
+        template <typename T>
+        void removeComponent(EntityRef entity)
+        {
+            record(CommandType::RemoveComponent, entity, getComponentTypeId<T>(), 0);
+        }
+
+        /**
+         * @brief Apply all recorded commands and clear the buffer
+         *
+         * Commands targeting an entity that no longer exists are skipped.
+         * @param entityManager Entity manager to modify
+         */
+        void apply(EntityManager &entityManager);
+
+        /**
+         * @brief Discard all recorded commands
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of recorded commands
+         * @return Number of commands
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Check if no command is recorded
+         * @return true if empty
+         */
+        bool empty() const;
+
+        /**
+         * @brief Get the entities created by the last apply()
+         * @return Handles in createEntity() call order
+         */
+        const std::vector<EntityHandle> &getCreatedEntities() const;
+
+    private:
+        enum class CommandType : std::uint8_t
+        {
+            CreateEntity,
+            RemoveComponent,
+            AddComponent,
+            DestroyEntity
+        };
+
+        struct Command
+        {
+            CommandType type;
+            ComponentTypeId componentType;
+            EntityRef target;
+            std::uint32_t payload;
+            std::uint32_t sequence;
+        };
+
+        struct IStaging
+        {
+            virtual ~IStaging() = default;
+            virtual void moveInto(EntityManager &entityManager, Entity &entity, std::uint32_t slot) = 0;
+            virtual void clear() = 0;
+        };
+
+        template <typename T>
+        struct Staging : IStaging
+        {
+            std::vector<T> values;
+
+            void moveInto(EntityManager &entityManager, Entity &entity, std::uint32_t slot) override
+            {
+                entityManager.addComponent<T>(entity, std::move(values[slot]));
+            }
+
+            void clear() override
+            {
+                values.clear();
+            }
+        };
+
+        template <typename T>
+        Staging<T> &getStaging()
+        {
+            ComponentTypeId typeId = getComponentTypeId<T>();
+            if (typeId >= m_staging.size())
+            {
+                m_staging.resize(typeId + 1);
+            }
+            if (!m_staging[typeId])
+            {
+                m_staging[typeId] = std::make_unique<Staging<T>>();
+            }
+            return *static_cast<Staging<T> *>(m_staging[typeId].get());
+        }
+
+        void record(CommandType type, EntityRef target, ComponentTypeId componentType, std::uint32_t payload);
+
+        // Creations (0), then component additions and removals (1), then destructions (2)
+        static int getPhase(CommandType type);
+
+        // Identifies the target among the existing or among the pending entities
+        static std::uint64_t getTargetKey(const EntityRef &target);
+
+        // Both commands add or remove the same component of the same entity
+        static bool isSameComponentChange(const Command &a, const Command &b);
+        Entity *resolve(EntityManager &entityManager, const EntityRef &target) const;
+
+        std::vector<Command> m_commands;
+        std::vector<std::string> m_pendingNames;
+        std::vector<std::unique_ptr<IStaging>> m_staging;
+        std::vector<EntityHandle> m_createdEntities;
+    };
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,717 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Component.hpp"
+#include "EntityHandle.hpp"
+
+namespace Core
+{
+
+    /**
+     * @brief Identifier assigned to each component type at first use
+     */
+    using ComponentTypeId = std::size_t;
+
+    /**
+     * @brief Maximum number of distinct component types
+     */
+    constexpr std::size_t MAX_COMPONENT_TYPES = 64;
+
+    /**
+     * @brief Bit set describing which component types an entity owns
+     */
+    using ComponentMask = std::bitset<MAX_COMPONENT_TYPES>;
+
+    namespace detail
+    {
+        inline ComponentTypeId nextComponentTypeId()
+        {
+            static std::atomic<ComponentTypeId> counter{0};
+            ComponentTypeId id = counter++;
+            if (id >= MAX_COMPONENT_TYPES)
+            {
+                throw std::length_error("Too many component types, increase MAX_COMPONENT_TYPES");
+            }
+            return id;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Get the type identifier of a component type
+     * @tparam T Component type
+     * @return Dense identifier, stable for the lifetime of the program
+     */
+    template <typename T>
+    ComponentTypeId getComponentTypeId()
+    {
+        static const ComponentTypeId id = detail::nextComponentTypeId();
+        return id;
+    }
+
+    /**
+     * @brief Compile-time list of component types
+     *
+     * Used to register the component types updated in batch by
+     * EntityManager::updateComponents(), in the order they are listed.
+     * @tparam Types Component types
+     */
+    template <typename... Types>
+    struct ComponentList
+    {
+    };
+
+    namespace detail
+    {
+        template <typename T, typename = void>
+        struct HasBatchUpdate : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct HasBatchUpdate<T, std::void_t<decltype(T::updateBatch(std::declval<T *>(), std::size_t(), 0.f))>>
+            : std::true_type
+        {
+        };
+    } // namespace detail
+
+    /**
+     * @brief Updates a contiguous run of components of a single concrete type
+     *
+     * A component type can provide
+     * `static void updateBatch(T *components, std::size_t count, float deltaTime)`
+     * to process a whole run at once, which lets the compiler vectorize
+     * simple components; it is then responsible for skipping inactive ones.
+     * Otherwise each active component's update() is called with a qualified,
+     * non-virtual call that the compiler can inline.
+     *
+     * @tparam T Component type
+     */
+    template <typename T>
+    struct ComponentUpdater
+    {
+        static void update(T *components, std::size_t count, float deltaTime)
+        {
+            if constexpr (detail::HasBatchUpdate<T>::value)
+            {
+                T::updateBatch(components, count, deltaTime);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (components[i].isActive())
+                    {
+                        components[i].T::update(deltaTime);
+                    }
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Heap allocation counters of a component pool
+     *
+     * Comparing two snapshots taken a frame apart tells whether component
+     * storage allocated during that frame.
+     */
+    struct ComponentPoolStats
+    {
+        std::size_t allocations = 0;   // Heap blocks allocated: pages and index arrays
+        std::size_t deallocations = 0; // Heap blocks released
+        std::size_t size = 0;          // Live components
+        std::size_t peakSize = 0;      // Highest number of live components
+        std::size_t capacity = 0;      // Components that fit in the allocated pages
+    };
+
+    /**
+     * @brief Type-erased interface of a component pool
+     */
+    class IComponentPool
+    {
+    public:
+        virtual ~IComponentPool() = default;
+
+        /**
+         * @brief Remove the component owned by an entity
+         * @param entityIndex Entity slot index
+         * @return true if a component was removed
+         */
+        virtual bool remove(unsigned int entityIndex) = 0;
+
+        /**
+         * @brief Check if an entity owns a component in this pool
+         * @param entityIndex Entity slot index
+         * @return true if the component exists
+         */
+        virtual bool contains(unsigned int entityIndex) const = 0;
+
+        /**
+         * @brief Get the component owned by an entity as its base type
+         * @param entityIndex Entity slot index
+         * @return Pointer to the component, or nullptr if not found
+         */
+        virtual Component *getBase(unsigned int entityIndex) = 0;
+
+        /**
+         * @brief Get the number of components stored
+         * @return Number of components
+         */
+        virtual std::size_t size() const = 0;
+
+        /**
+         * @brief Destroy all components, keeping the allocated storage for reuse
+         */
+        virtual void clear() = 0;
+
+        /**
+         * @brief Get the allocation counters of the pool
+         * @return Pool statistics
+         */
+        virtual ComponentPoolStats getStats() const = 0;
+
+        /**
+         * @brief Forget the removals recorded before a tick
+         * @param oldestTick Oldest tick to keep
+         */
+        virtual void pruneRemoved(std::uint32_t oldestTick) = 0;
+
+        /**
+         * @brief Update every component of the pool through its ComponentUpdater
+         * @param deltaTime Time since last frame in seconds
+         */
+        virtual void updateAll(float deltaTime) = 0;
+    };
+
+    /**
+     * @brief Record of a component removed from a pool
+     */
+    struct ComponentRemoval
+    {
+        EntityId entity;    // Entity that owned the component
+        std::uint32_t tick; // Tick of the removal
+    };
+
+    /**
+     * @brief Sparse-set storage for all components of a single type
+     *
+     * Components live in fixed-size pages so that adding a component never
+     * moves the others. The live components are kept densely packed at the
+     * front of the storage: removing one moves the last component of the pool
+     * into the freed slot, so only a pointer to that last component is
+     * invalidated by a removal.
+     *
+     * Pages and index arrays are never released before the pool is
+     * destroyed, so once a pool has reached its peak size adding and
+     * removing components does not touch the heap. reserve() allocates that
+     * storage up front.
+     *
+     * Each component carries the tick at which it was added and the tick at
+     * which it was last marked changed, and the pool logs removals, so that
+     * systems can restrict their work to what happened since their last run.
+     * A single consumer can also enable a change log, listing the entities
+     * whose component was added or marked changed, to visit them without
+     * scanning the pool.
+     *
+     * @tparam T Component type
+     */
+    template <typename T>
+    class ComponentPool : public IComponentPool
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Core::Component");
+        static_assert(std::is_move_constructible<T>::value, "Components must be move constructible to be pooled");
+
+    public:
+        /**
+         * @brief Number of components per storage page
+         */
+        static constexpr std::size_t PAGE_SIZE = 256;
+
+        /**
+         * @brief Constructor
+         * @param tick Current tick of the owning entity manager, stamped on additions and changes
+         */
+        explicit ComponentPool(const std::uint32_t *tick = nullptr)
+            : m_tick(tick)
+        {
+        }
+
+        ComponentPool(const ComponentPool &) = delete;
+        ComponentPool &operator=(const ComponentPool &) = delete;
+
+        ~ComponentPool() override
+        {
+            clear();
+        }
+
+        /**
+         * @brief Construct a component for an entity, replacing any existing one
+         * @param entityIndex Entity slot index
+         * @param args Constructor arguments
+         * @return Reference to the constructed component
+         */
+        template <typename... Args>
+        T &emplace(unsigned int entityIndex, Args &&...args)
+        {
+            if (contains(entityIndex))
+            {
+                // Constructed in place of the old component: if the constructor
+                // throws, the old one is already gone and the entry is removed
+                std::size_t index = m_sparse[entityIndex];
+                T *existing = slot(index);
+                auto *owner = existing->getOwner();
+                EntityId ownerId = owner ? owner->getId() : EntityHandle{entityIndex, 0}.toId();
+                existing->~T();
+                try
+                {
+                    new (existing) T(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    logRemoval(ownerId);
+                    fillHole(index);
+                    m_sparse[entityIndex] = INVALID_INDEX;
+                    throw;
+                }
+                m_ticks[index].changed = currentTick();
+                logChange(index);
+                return *existing;
+            }
+
+            std::size_t index = m_entities.size();
+            if (index == m_pages.size() * PAGE_SIZE)
+            {
+                addPage();
+            }
+
+            T *component = new (slot(index)) T(std::forward<Args>(args)...);
+
+            if (entityIndex >= m_sparse.size())
+            {
+                trackGrowth(m_sparse, entityIndex + 1);
+                m_sparse.resize(entityIndex + 1, INVALID_INDEX);
+            }
+            m_sparse[entityIndex] = static_cast<std::uint32_t>(index);
+            trackGrowth(m_entities, m_entities.size() + 1);
+            m_entities.push_back(entityIndex);
+            trackGrowth(m_ticks, m_ticks.size() + 1);
+            m_ticks.push_back({currentTick(), currentTick(), false});
+            logChange(index);
+
+            if (m_entities.size() > m_peakSize)
+            {
+                m_peakSize = m_entities.size();
+            }
+
+            return *component;
+        }
+
+        /**
+         * @brief Get the component owned by an entity
+         * @param entityIndex Entity slot index
+         * @return Pointer to the component, or nullptr if not found
+         */
+        T *get(unsigned int entityIndex)
+        {
+            return contains(entityIndex) ? slot(m_sparse[entityIndex]) : nullptr;
+        }
+
+        bool remove(unsigned int entityIndex) override
+        {
+            if (!contains(entityIndex))
+            {
+                return false;
+            }
+
+            std::size_t index = m_sparse[entityIndex];
+            auto *owner = slot(index)->getOwner();
+            logRemoval(owner ? owner->getId() : EntityHandle{entityIndex, 0}.toId());
+
+            slot(index)->~T();
+            fillHole(index);
+            m_sparse[entityIndex] = INVALID_INDEX;
+            return true;
+        }
+
+        bool contains(unsigned int entityIndex) const override
+        {
+            return entityIndex < m_sparse.size() && m_sparse[entityIndex] != INVALID_INDEX;
+        }
+
+        Component *getBase(unsigned int entityIndex) override
+        {
+            return get(entityIndex);
+        }
+
+        std::size_t size() const override
+        {
+            return m_entities.size();
+        }
+
+        void clear() override
+        {
+            for (std::size_t i = 0; i < m_entities.size(); ++i)
+            {
+                slot(i)->~T();
+            }
+            m_entities.clear();
+            m_ticks.clear();
+            m_removed.clear();
+            m_changeLog.clear();
+            m_sparse.assign(m_sparse.size(), INVALID_INDEX);
+        }
+
+        void pruneRemoved(std::uint32_t oldestTick) override
+        {
+            // Removals are logged in tick order
+            auto firstKept = std::find_if(m_removed.begin(), m_removed.end(), [oldestTick](const ComponentRemoval &removal)
+                                          { return removal.tick >= oldestTick; });
+            m_removed.erase(m_removed.begin(), firstKept);
+        }
+
+        void updateAll(float deltaTime) override
+        {
+            forEachPage([deltaTime](T *components, std::size_t count)
+                        { ComponentUpdater<T>::update(components, count, deltaTime); });
+        }
+
+        /**
+         * @brief Stamp the component of an entity as changed in the current tick
+         * @param entityIndex Entity slot index
+         * @return true if the entity owns a component in this pool
+         */
+        bool markChanged(unsigned int entityIndex)
+        {
+            if (!contains(entityIndex))
+            {
+                return false;
+            }
+            m_ticks[m_sparse[entityIndex]].changed = currentTick();
+            logChange(m_sparse[entityIndex]);
+            return true;
+        }
+
+        /**
+         * @brief Start logging the entities whose component is added or marked changed
+         *
+         * The components already in the pool are logged right away.
+         */
+        void enableChangeLog()
+        {
+            if (m_changeLogEnabled)
+            {
+                return;
+            }
+            m_changeLogEnabled = true;
+            for (std::size_t i = 0; i < m_entities.size(); ++i)
+            {
+                logChange(i);
+            }
+        }
+
+        /**
+         * @brief Visit and forget the entities logged since the last drain
+         *
+         * Components removed since they were logged are skipped. Each entity
+         * is logged once between two drains, whatever the number of changes.
+         * @param func Callable taking (unsigned int entityIndex, T &component)
+         */
+        template <typename Func>
+        void drainChanged(Func &&func)
+        {
+            // Swapped out, so that func may mark components changed for the next drain
+            m_drainedLog.swap(m_changeLog);
+            for (unsigned int entityIndex : m_drainedLog)
+            {
+                if (contains(entityIndex))
+                {
+                    m_ticks[m_sparse[entityIndex]].logged = false;
+                    func(entityIndex, *slot(m_sparse[entityIndex]));
+                }
+            }
+            m_drainedLog.clear();
+        }
+
+        /**
+         * @brief Get the tick at which the component of an entity was added
+         * @param entityIndex Entity slot index, must own a component in this pool
+         * @return Addition tick
+         */
+        std::uint32_t getAddedTick(unsigned int entityIndex) const
+        {
+            return m_ticks[m_sparse[entityIndex]].added;
+        }
+
+        /**
+         * @brief Get the tick at which the component of an entity was last added or marked changed
+         * @param entityIndex Entity slot index, must own a component in this pool
+         * @return Change tick
+         */
+        std::uint32_t getChangedTick(unsigned int entityIndex) const
+        {
+            return m_ticks[m_sparse[entityIndex]].changed;
+        }
+
+        /**
+         * @brief Get the removals logged since the last pruning, oldest first
+         * @return Removal records
+         */
+        const std::vector<ComponentRemoval> &getRemoved() const
+        {
+            return m_removed;
+        }
+
+        ComponentPoolStats getStats() const override
+        {
+            ComponentPoolStats stats;
+            stats.allocations = m_allocations;
+            stats.deallocations = m_deallocations;
+            stats.size = m_entities.size();
+            stats.peakSize = m_peakSize;
+            stats.capacity = m_pages.size() * PAGE_SIZE;
+            return stats;
+        }
+
+        /**
+         * @brief Allocate storage for a number of components up front
+         * @param count Number of components
+         * @param maxEntityIndex Highest entity slot index expected to own one
+         */
+        void reserve(std::size_t count, unsigned int maxEntityIndex = 0)
+        {
+            while (m_pages.size() * PAGE_SIZE < count)
+            {
+                addPage();
+            }
+
+            trackGrowth(m_entities, count);
+            m_entities.reserve(count);
+            trackGrowth(m_ticks, count);
+            m_ticks.reserve(count);
+
+            std::size_t sparseSize = std::max<std::size_t>(count, std::size_t(maxEntityIndex) + 1);
+            if (sparseSize > m_sparse.size())
+            {
+                trackGrowth(m_sparse, sparseSize);
+                m_sparse.resize(sparseSize, INVALID_INDEX);
+            }
+        }
+
+        /**
+         * @brief Get the dense index of the component owned by an entity
+         * @param entityIndex Entity slot index, must own a component in this pool
+         * @return Dense index, in [0, size())
+         */
+        std::size_t indexOf(unsigned int entityIndex) const
+        {
+            return m_sparse[entityIndex];
+        }
+
+        /**
+         * @brief Reorder the dense storage
+         *
+         * The order is kept until the next removal relocates a component.
+         * Like a removal, sorting invalidates pointers to the components.
+         * @param compare Strict weak ordering taking (const T &, const T &)
+         */
+        template <typename Compare>
+        void sort(Compare compare)
+        {
+            std::size_t count = m_entities.size();
+            std::vector<std::size_t> order(count);
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+                             { return compare(static_cast<const T &>(*slot(a)), static_cast<const T &>(*slot(b))); });
+
+            // Apply the permutation in place, one cycle at a time: position
+            // `current` receives the component currently at order[current]
+            for (std::size_t start = 0; start < count; ++start)
+            {
+                if (order[start] == start)
+                {
+                    continue;
+                }
+
+                T saved(std::move(*slot(start)));
+                slot(start)->~T();
+                unsigned int savedEntity = m_entities[start];
+                Ticks savedTicks = m_ticks[start];
+
+                std::size_t current = start;
+                while (order[current] != start)
+                {
+                    std::size_t next = order[current];
+                    new (slot(current)) T(std::move(*slot(next)));
+                    slot(next)->~T();
+                    m_entities[current] = m_entities[next];
+                    m_ticks[current] = m_ticks[next];
+                    order[current] = current;
+                    current = next;
+                }
+
+                new (slot(current)) T(std::move(saved));
+                m_entities[current] = savedEntity;
+                m_ticks[current] = savedTicks;
+                order[current] = current;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                m_sparse[m_entities[i]] = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        /**
+         * @brief Get the component stored at a dense index
+         * @param index Dense index, in [0, size())
+         * @return Reference to the component
+         */
+        T &at(std::size_t index)
+        {
+            return *slot(index);
+        }
+
+        /**
+         * @brief Get the slot index of the entity owning the component at a dense index
+         * @param index Dense index, in [0, size())
+         * @return Entity slot index
+         */
+        unsigned int entityAt(std::size_t index) const
+        {
+            return m_entities[index];
+        }
+
+        /**
+         * @brief Get the slot indices of all entities owning a component, in storage order
+         * @return Dense array of entity slot indices
+         */
+        const std::vector<unsigned int> &entities() const
+        {
+            return m_entities;
+        }
+
+        /**
+         * @brief Call a function for every contiguous run of components
+         * @param func Callable taking (T *first, std::size_t count)
+         */
+        template <typename Func>
+        void forEachPage(Func &&func)
+        {
+            std::size_t remaining = m_entities.size();
+            for (std::size_t page = 0; remaining > 0; ++page)
+            {
+                std::size_t count = remaining < PAGE_SIZE ? remaining : PAGE_SIZE;
+                func(slot(page * PAGE_SIZE), count);
+                remaining -= count;
+            }
+        }
+
+    private:
+        static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+        struct Ticks
+        {
+            std::uint32_t added;
+            std::uint32_t changed;
+            bool logged; // In m_changeLog
+        };
+
+        std::uint32_t currentTick() const
+        {
+            return m_tick ? *m_tick : 0;
+        }
+
+        struct Page
+        {
+            alignas(T) unsigned char data[sizeof(T) * PAGE_SIZE];
+        };
+
+        void addPage()
+        {
+            m_pages.push_back(std::make_unique<Page>());
+            ++m_allocations;
+        }
+
+        // Count the reallocation a vector is about to make to hold `required` elements
+        template <typename Vector>
+        void trackGrowth(const Vector &vector, std::size_t required)
+        {
+            if (required > vector.capacity())
+            {
+                ++m_allocations;
+                if (vector.capacity() > 0)
+                {
+                    ++m_deallocations;
+                }
+            }
+        }
+
+        void logRemoval(EntityId entity)
+        {
+            trackGrowth(m_removed, m_removed.size() + 1);
+            m_removed.push_back({entity, currentTick()});
+        }
+
+        // Keep the pool dense by relocating the last component into the
+        // slot at `index`, whose component was already destroyed
+        void fillHole(std::size_t index)
+        {
+            std::size_t last = m_entities.size() - 1;
+            if (index != last)
+            {
+                T *moved = slot(last);
+                new (slot(index)) T(std::move(*moved));
+                moved->~T();
+
+                m_entities[index] = m_entities[last];
+                m_ticks[index] = m_ticks[last];
+                m_sparse[m_entities[index]] = static_cast<std::uint32_t>(index);
+            }
+
+            m_entities.pop_back();
+            m_ticks.pop_back();
+        }
+
+        void logChange(std::size_t index)
+        {
+            if (m_changeLogEnabled && !m_ticks[index].logged)
+            {
+                m_ticks[index].logged = true;
+                trackGrowth(m_changeLog, m_changeLog.size() + 1);
+                m_changeLog.push_back(m_entities[index]);
+            }
+        }
+
+        T *slot(std::size_t index)
+        {
+            unsigned char *base = m_pages[index / PAGE_SIZE]->data;
+            return std::launder(reinterpret_cast<T *>(base + (index % PAGE_SIZE) * sizeof(T)));
+        }
+
+        std::vector<std::unique_ptr<Page>> m_pages;
+        std::vector<unsigned int> m_entities;
+        std::vector<std::uint32_t> m_sparse;
+        std::vector<Ticks> m_ticks; // Parallel to m_entities
+        std::vector<ComponentRemoval> m_removed;
+        std::vector<unsigned int> m_changeLog;  // Entity slots, see enableChangeLog()
+        std::vector<unsigned int> m_drainedLog; // Storage of the log being drained
+        bool m_changeLogEnabled = false;
+        const std::uint32_t *m_tick = nullptr;
+
+        std::size_t m_peakSize = 0;
+        std::size_t m_allocations = 0;
+        std::size_t m_deallocations = 0;
+    };
+
+} // namespace Core
\ No newline at end of file
@@ -1,37 +1,64 @@
 #pragma once
 
-#include <memory>
-#include <unordered_map>
-#include <typeindex>
 #include <string>
 #include "Component.hpp"
+#include "ComponentPool.hpp"
+#include "EntityHandle.hpp"
 
 namespace Core
 {
 
+    class EntityManager;
+
     /**
      * @brief Entity class representing a game object with components
+     *
+     * Components are not owned by the entity itself: they are stored in the
+     * per-type pools of the EntityManager that created it. The entity keeps
+     * a mask of the component types it owns.
+     *
+     * Derived classes take the manager and handle first in their
+     * constructor and are created with EntityManager::createEntity<T>().
      */
     class Entity
     {
     public:
         /**
          * @brief Constructor
-         * @param id Unique entity ID
+         * @param manager Entity manager storing the components of this entity
+         * @param handle Generational handle of the entity
          * @param name Optional entity name
          */
-        Entity(unsigned int id, const std::string &name = "");
+        Entity(EntityManager &manager, EntityHandle handle, const std::string &name = "");
 
         /**
          * @brief Destructor
          */
-        ~Entity();
+        virtual ~Entity();
+
+        Entity(const Entity &) = delete;
+        Entity &operator=(const Entity &) = delete;
 
         /**
          * @brief Get the entity ID
-         * @return Entity ID
+         * @return Packed generational handle, unique for the whole session
          */
-        unsigned int getId() const;
+        EntityId getId() const;
+
+        /**
+         * @brief Get the entity handle
+         * @return Generational handle
+         */
+        EntityHandle getHandle() const;
+
+        /**
+         * @brief Get the slot index of the entity
+         *
+         * Unique among live entities only: the index is reused once the
+         * entity is removed. Used as the key of component pools and views.
+         * @return Slot index
+         */
+        unsigned int getIndex() const;
 
         /**
          * @brief Get the entity name
@@ -53,29 +80,20 @@ namespace Core
          * @return Reference to the added component
          */
         template <typename T, typename... Args>
-        T &addComponent(Args &&...args)
-        {
-            auto component = std::make_shared<T>(std::forward<Args>(args)...);
-            component->setOwner(this);
-            m_components[typeid(T)] = component;
-            return *static_cast<T *>(component.get());
-        }
+        T &addComponent(Args &&...args);
 
         /**
          * @brief Get a component by type
+         *
+         * Components are stored in pools that move them when another
+         * component of the type is removed or when the pool is sorted, so
+         * their addresses are not stable: call this at each use instead of
+         * keeping the pointer.
          * @tparam T Component type
          * @return Pointer to the component, or nullptr if not found
          */
         template <typename T>
-        T *getComponent()
-        {
-            auto it = m_components.find(typeid(T));
-            if (it != m_components.end())
-            {
-                return static_cast<T *>(it->second.get());
-            }
-            return nullptr;
-        }
+        T *getComponent();
 
         /**
          * @brief Check if the entity has a component
@@ -83,9 +101,9 @@ namespace Core
          * @return true if the component exists
          */
         template <typename T>
-        bool hasComponent()
+        bool hasComponent() const
         {
-            return m_components.find(typeid(T)) != m_components.end();
+            return m_componentMask.test(getComponentTypeId<T>());
         }
 
         /**
@@ -94,16 +112,15 @@ namespace Core
          * @return true if the component was removed
          */
         template <typename T>
-        bool removeComponent()
-        {
-            auto it = m_components.find(typeid(T));
-            if (it != m_components.end())
-            {
-                m_components.erase(it);
-                return true;
-            }
-            return false;
-        }
+        bool removeComponent();
+
+        /**
+         * @brief Stamp a component as changed in the current tick
+         * @tparam T Component type
+         * @return true if the component exists
+         */
+        template <typename T>
+        bool markChanged();
 
         /**
          * @brief Remove all components
@@ -122,11 +139,23 @@ namespace Core
          */
         bool isActive() const;
 
+        /**
+         * @brief Get the mask of component types owned by the entity
+         * @return Component mask
+         */
+        const ComponentMask &getComponentMask() const;
+
     private:
-        unsigned int m_id;
+        friend class EntityManager;
+
+        EntityManager &m_manager;
+        EntityHandle m_handle;
         std::string m_name;
         bool m_active;
-        std::unordered_map<std::type_index, std::shared_ptr<Component>> m_components;
+        ComponentMask m_componentMask;
     };
 
-} // namespace Core
\ No newline at end of file
+} // namespace Core
+
+// Component access templates need the complete EntityManager
+#include "EntityManager.hpp"
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Core
+{
+
+    /**
+     * @brief Packed form of an EntityHandle, suitable for user data and blackboards
+     */
+    using EntityId = std::uint64_t;
+
+    /**
+     * @brief Generational reference to an entity
+     *
+     * The index addresses a slot of the EntityManager and is recycled once
+     * the entity is removed; the generation is bumped on each removal so that
+     * handles to a removed entity are detected as stale instead of silently
+     * resolving to the slot's next occupant.
+     */
+    struct EntityHandle
+    {
+        static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+        std::uint32_t index = INVALID_INDEX;
+        std::uint32_t generation = 0;
+
+        /**
+         * @brief Check if the handle was ever assigned
+         * @return true if the handle refers to a slot
+         */
+        bool isValid() const
+        {
+            return index != INVALID_INDEX;
+        }
+
+        /**
+         * @brief Pack the handle into a single integer
+         * @return Packed entity ID
+         */
+        EntityId toId() const
+        {
+            return (static_cast<EntityId>(generation) << 32) | index;
+        }
+
+        /**
+         * @brief Unpack a handle from an integer produced by toId()
+         * @param id Packed entity ID
+         * @return Entity handle
+         */
+        static EntityHandle fromId(EntityId id)
+        {
+            return EntityHandle{static_cast<std::uint32_t>(id & 0xFFFFFFFFu),
+                                static_cast<std::uint32_t>(id >> 32)};
+        }
+
+        bool operator==(const EntityHandle &other) const
+        {
+            return index == other.index && generation == other.generation;
+        }
+
+        bool operator!=(const EntityHandle &other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+} // namespace Core
+
+namespace std
+{
+    template <>
+    struct hash<Core::EntityHandle>
+    {
+        std::size_t operator()(const Core::EntityHandle &handle) const
+        {
+            return std::hash<Core::EntityId>()(handle.toId());
+        }
+    };
+} // namespace std
\ No newline at end of file
@@ -5,10 +5,14 @@
 #include <vector>
 #include <functional>
 #include "Entity.hpp"
+#include "ComponentPool.hpp"
+#include "View.hpp"
 
 namespace Core
 {
 
+    class CommandBuffer;
+
     /**
      * @brief Manager class for entities
      */
@@ -32,12 +36,55 @@ namespace Core
          */
         Entity *createEntity(const std::string &name = "");
 
+        /**
+         * @brief Create an entity of a class derived from Entity
+         *
+         * The class is constructed from (EntityManager &, EntityHandle,
+         * args...) and forwards the first two to the Entity constructor.
+         * @tparam T Entity class
+         * @tparam Args Remaining constructor arguments types
+         * @param args Remaining constructor arguments
+         * @return Pointer to the created entity
+         */
+        template <typename T, typename... Args>
+        T *createEntity(Args &&...args)
+        {
+            static_assert(std::is_base_of<Entity, T>::value, "T must derive from Core::Entity");
+            std::uint32_t index = allocateSlot();
+            EntitySlot &slot = m_slots[index];
+            auto entity = std::make_unique<T>(*this, EntityHandle{index, slot.generation}, std::forward<Args>(args)...);
+            T *result = entity.get();
+            slot.entity = std::move(entity);
+            ++m_entityCount;
+            return result;
+        }
+
         /**
          * @brief Get an entity by ID
-         * @param id Entity ID
-         * @return Pointer to the entity, or nullptr if not found
+         * @param id Entity ID, as returned by Entity::getId()
+         * @return Pointer to the entity, or nullptr if not found or removed
+         */
+        Entity *getEntity(EntityId id);
+
+        /**
+         * @brief Get an entity by handle in constant time
+         * @param handle Entity handle
+         * @return Pointer to the entity, or nullptr if the handle is stale
          */
-        Entity *getEntity(unsigned int id);
+        Entity *getEntity(EntityHandle handle);
+
+        /**
+         * @brief Check if a handle still refers to a live entity
+         * @param handle Entity handle
+         * @return true if the entity exists
+         */
+        bool isAlive(EntityHandle handle) const;
+
+        /**
+         * @brief Get the number of live entities
+         * @return Number of entities
+         */
+        std::size_t getEntityCount() const;
 
         /**
          * @brief Get entities by name
@@ -54,16 +101,258 @@ namespace Core
 
         /**
          * @brief Remove an entity by ID
-         * @param id Entity ID
+         * @param id Entity ID, as returned by Entity::getId()
          * @return true if the entity was removed
          */
-        bool removeEntity(unsigned int id);
+        bool removeEntity(EntityId id);
+
+        /**
+         * @brief Remove an entity by handle
+         * @param handle Entity handle
+         * @return true if the entity was removed, false if the handle is stale
+         */
+        bool removeEntity(EntityHandle handle);
 
         /**
          * @brief Remove all entities
          */
         void removeAllEntities();
 
+        /**
+         * @brief Add a component to an entity
+         * @tparam T Component type
+         * @tparam Args Constructor arguments types
+         * @param entity Entity receiving the component
+         * @param args Constructor arguments
+         * @return Reference to the added component
+         */
+        template <typename T, typename... Args>
+        T &addComponent(Entity &entity, Args &&...args)
+        {
+            ComponentPool<T> &pool = getComponentPool<T>();
+            T *added;
+            try
+            {
+                added = &pool.emplace(entity.getIndex(), std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                // A throwing replacement leaves the entity without the component
+                if (entity.hasComponent<T>() && !pool.contains(entity.getIndex()))
+                {
+                    ComponentMask oldMask = entity.m_componentMask;
+                    entity.m_componentMask.reset(getComponentTypeId<T>());
+                    notifyMaskChanged(entity, oldMask);
+                }
+                throw;
+            }
+            T &component = *added;
+            component.setOwner(&entity);
+
+            ComponentMask oldMask = entity.m_componentMask;
+            entity.m_componentMask.set(getComponentTypeId<T>());
+            notifyMaskChanged(entity, oldMask);
+            return component;
+        }
+
+        /**
+         * @brief Get a component of an entity
+         *
+         * The component lives in its type's pool, which relocates components
+         * when another one is removed or when the pool is sorted: keep the
+         * entity's handle and call this again rather than storing the pointer.
+         * @tparam T Component type
+         * @param entity Entity owning the component
+         * @return Pointer to the component, valid until the next removal or sort in its pool, or nullptr if not found
+         */
+        template <typename T>
+        T *getComponent(const Entity &entity)
+        {
+            if (!entity.hasComponent<T>())
+            {
+                return nullptr;
+            }
+            return getComponentPool<T>().get(entity.getIndex());
+        }
+
+        /**
+         * @brief Remove a component from an entity
+         * @tparam T Component type
+         * @param entity Entity owning the component
+         * @return true if the component was removed
+         */
+        template <typename T>
+        bool removeComponent(Entity &entity)
+        {
+            return removeComponent(entity, getComponentTypeId<T>());
+        }
+
+        /**
+         * @brief Remove a component from an entity by type identifier
+         * @param entity Entity owning the component
+         * @param typeId Component type identifier
+         * @return true if the component was removed
+         */
+        bool removeComponent(Entity &entity, ComponentTypeId typeId);
+
+        /**
+         * @brief Remove all components of an entity
+         * @param entity Entity owning the components
+         */
+        void removeAllComponents(Entity &entity);
+
+        /**
+         * @brief Stamp a component of an entity as changed in the current tick
+         *
+         * Components are modified in place through plain pointers, so writers
+         * call this for the change to be visible to eachChanged() queries.
+         * @tparam T Component type
+         * @param entity Entity owning the component
+         * @return true if the entity owns the component
+         */
+        template <typename T>
+        bool markChanged(Entity &entity)
+        {
+            return getComponentPool<T>().markChanged(entity.getIndex());
+        }
+
+        /**
+         * @brief Start logging the entities whose component of a type is added or marked changed
+         *
+         * For a single consumer that needs the changed components without
+         * scanning them all; see drainChanged().
+         * @tparam T Component type
+         */
+        template <typename T>
+        void enableChangeLog()
+        {
+            getComponentPool<T>().enableChangeLog();
+        }
+
+        /**
+         * @brief Call a function for every entity logged since the last drain, and forget them
+         * @tparam T Component type, whose change log is enabled
+         * @param func Callable taking (Entity &, T &)
+         */
+        template <typename T, typename Func>
+        void drainChanged(Func &&func)
+        {
+            getComponentPool<T>().drainChanged([&func](unsigned int, T &component)
+                                               {
+                if (Entity *owner = component.getOwner())
+                {
+                    func(*owner, component);
+                } });
+        }
+
+        /**
+         * @brief Call a function for every component of a type removed since a tick
+         *
+         * Removals are kept until pruneRemoved() drops them; the engine does so
+         * at each frame boundary, once every consumer has run, so a consumer
+         * running once per frame sees the removals of all the ticks
+         * simulated in between.
+         * @tparam T Component type
+         * @param sinceTick Oldest tick to report, inclusive
+         * @param func Callable taking (EntityId) of the former owner
+         */
+        template <typename T, typename Func>
+        void forEachRemoved(std::uint32_t sinceTick, Func &&func)
+        {
+            for (const ComponentRemoval &removal : getComponentPool<T>().getRemoved())
+            {
+                if (removal.tick >= sinceTick)
+                {
+                    func(removal.entity);
+                }
+            }
+        }
+
+        /**
+         * @brief Get the storage of a component type, creating it if needed
+         *
+         * Creating a pool is not thread-safe: systems create theirs when they
+         * declare their component access, so that their parallel updates only
+         * look pools up.
+         * @tparam T Component type
+         * @return Reference to the component pool
+         */
+        template <typename T>
+        ComponentPool<T> &getComponentPool()
+        {
+            ComponentTypeId typeId = getComponentTypeId<T>();
+            if (typeId >= m_componentPools.size())
+            {
+                m_componentPools.resize(typeId + 1);
+            }
+            if (!m_componentPools[typeId])
+            {
+                m_componentPools[typeId] = std::make_unique<ComponentPool<T>>(&m_tick);
+            }
+            return *static_cast<ComponentPool<T> *>(m_componentPools[typeId].get());
+        }
+
+        /**
+         * @brief Allocate storage for a component type up front
+         *
+         * Reserving the expected peak count at load time keeps component
+         * additions during gameplay free of heap allocations.
+         * @tparam T Component type
+         * @param count Number of components
+         */
+        template <typename T>
+        void reserveComponents(std::size_t count)
+        {
+            getComponentPool<T>().reserve(count, static_cast<unsigned int>(std::max(m_slots.size(), count)));
+        }
+
+        /**
+         * @brief Get the allocation counters of a component type
+         * @tparam T Component type
+         * @return Pool statistics
+         */
+        template <typename T>
+        ComponentPoolStats getComponentPoolStats()
+        {
+            return getComponentPool<T>().getStats();
+        }
+
+        /**
+         * @brief Get the allocation counters of a component type by identifier
+         * @param typeId Component type identifier
+         * @return Pool statistics, all zero if no pool exists for the type
+         */
+        ComponentPoolStats getComponentPoolStats(ComponentTypeId typeId) const;
+
+        /**
+         * @brief Get the number of heap allocations made by all component pools
+         * @return Total allocation count since the entity manager was created
+         */
+        std::size_t getComponentAllocationCount() const;
+
+        /**
+         * @brief Get the persistent view of the entities owning all given component types
+         *
+         * The view is created on first use and then maintained incrementally,
+         * so it is cheap to call every frame. Creating a view is not
+         * thread-safe: systems create theirs with System::declareView().
+         * @tparam Types Component types
+         * @return Typed view handle
+         */
+        template <typename... Types>
+        View<Types...> getView()
+        {
+            static_assert(sizeof...(Types) > 0, "A view needs at least one component type");
+            return View<Types...>(getEntityView(makeComponentMask<Types...>()), getComponentPool<Types>()...);
+        }
+
+        /**
+         * @brief Get the persistent view matching a component mask
+         * @param mask Component mask
+         * @return Reference to the view, owned by the entity manager
+         */
+        EntityView &getEntityView(const ComponentMask &mask);
+
         /**
          * @brief Get entities with a specific component type
          * @tparam T Component type
@@ -73,11 +362,13 @@ namespace Core
         std::vector<Entity *> getEntitiesWithComponent()
         {
             std::vector<Entity *> result;
+            ComponentPool<T> &pool = getComponentPool<T>();
+            result.reserve(pool.size());
 
-            for (auto &pair : m_entities)
+            for (std::size_t i = 0; i < pool.size(); ++i)
             {
-                Entity *entity = pair.second.get();
-                if (entity->isActive() && entity->hasComponent<T>())
+                Entity *entity = pool.at(i).getOwner();
+                if (entity->isActive())
                 {
                     result.push_back(entity);
                 }
@@ -88,6 +379,9 @@ namespace Core
 
         /**
          * @brief Find entities with specific component types
+         *
+         * Only the pool of the first component type is walked, the other
+         * types are checked against each entity's component mask.
          * @tparam T Component type
          * @tparam Args Additional component types
          * @return Vector of pointers to entities with the specified component types
@@ -96,11 +390,13 @@ namespace Core
         std::vector<Entity *> findEntitiesWithComponents()
         {
             std::vector<Entity *> result;
+            ComponentMask mask = makeComponentMask<T, Args...>();
+            ComponentPool<T> &pool = getComponentPool<T>();
 
-            for (auto &pair : m_entities)
+            for (std::size_t i = 0; i < pool.size(); ++i)
             {
-                Entity *entity = pair.second.get();
-                if (entity->isActive() && entity->hasComponent<T>() && hasAllComponents<Args...>(entity))
+                Entity *entity = pool.at(i).getOwner();
+                if (entity->isActive() && (entity->getComponentMask() & mask) == mask)
                 {
                     result.push_back(entity);
                 }
@@ -110,33 +406,184 @@ namespace Core
         }
 
         /**
-         * @brief Update all entities
+         * @brief Build the mask matching a set of component types
+         * @tparam Types Component types
+         * @return Component mask with one bit set per type
+         */
+        template <typename... Types>
+        static ComponentMask makeComponentMask()
+        {
+            ComponentMask mask;
+            (mask.set(getComponentTypeId<Types>()), ...);
+            return mask;
+        }
+
+        /**
+         * @brief Get the command buffer used to defer structural changes
+         *
+         * Systems should record entity creation/destruction and component
+         * addition/removal here while iterating; the engine applies the
+         * buffer once per frame through flushCommands().
+         * @return Reference to the deferred command buffer
+         */
+        CommandBuffer &getCommandBuffer();
+
+        /**
+         * @brief Apply the commands recorded in the deferred command buffer, then compact the views
+         */
+        void flushCommands();
+
+        /**
+         * @brief Remove the holes left in the views by removed entities and components
+         *
+         * Must only be called at a sync point, when no view is being iterated.
+         */
+        void compactViews();
+
+        /**
+         * @brief Start a new change-tracking tick, once per frame
+         *
+         * Additions, changes and removals are stamped with the current tick;
+         * a system remembers the tick of its last run and queries what
+         * happened since then. Queries are inclusive, so a change made later
+         * in the same tick is never missed, at the cost of possibly seeing it
+         * twice.
+         */
+        void advanceTick();
+
+        /**
+         * @brief Forget the component removals older than a tick
+         * @param oldestTick Oldest tick whose removals are kept
+         */
+        void pruneRemoved(std::uint32_t oldestTick);
+
+        /**
+         * @brief Get the current change-tracking tick
+         * @return Current tick
+         */
+        std::uint32_t getCurrentTick() const;
+
+        /**
+         * @brief Update the components of the listed types, one type after the other
+         *
+         * Dispatch is resolved at compile time: each type's contiguous storage
+         * is handed to its ComponentUpdater without any virtual call.
+         * @tparam Types Component types, updated in list order
+         * @param deltaTime Time since last frame in seconds
+         */
+        template <typename... Types>
+        void updateComponents(ComponentList<Types...>, float deltaTime)
+        {
+            (getComponentPool<Types>().updateAll(deltaTime), ...);
+        }
+
+        /**
+         * @brief Update all components, one pool after the other
+         *
+         * Costs one virtual call per component type rather than per component.
+         * Prefer updateComponents() when the updated types are known.
          * @param deltaTime Time since last frame in seconds
          */
         void update(float deltaTime);
 
     private:
-        std::unordered_map<unsigned int, std::unique_ptr<Entity>> m_entities;
-        unsigned int m_nextEntityId;
+        // Take a free entity slot, or add one
+        std::uint32_t allocateSlot();
 
-        // Helper function for checking if an entity has all component types
-        template <typename T>
-        bool hasAllComponents(Entity *entity)
+        // Update the views after an entity's component mask changed
+        void notifyMaskChanged(Entity &entity, const ComponentMask &oldMask);
+
+        std::uint32_t m_tick;
+
+        // Declared before the entities so that pools and views outlive them on destruction
+        std::vector<std::unique_ptr<IComponentPool>> m_componentPools;
+        std::unordered_map<ComponentMask, std::unique_ptr<EntityView>> m_views;
+
+        /**
+         * @brief Storage slot of an entity, reused after the entity is removed
+         */
+        struct EntitySlot
+        {
+            std::unique_ptr<Entity> entity;
+            std::uint32_t generation = 0;
+        };
+
+        std::vector<EntitySlot> m_slots;
+        std::vector<std::uint32_t> m_freeSlots;
+        std::size_t m_entityCount;
+
+        std::unique_ptr<CommandBuffer> m_commandBuffer;
+    };
+
+    template <typename T, typename... Args>
+    T &Entity::addComponent(Args &&...args)
+    {
+        return m_manager.addComponent<T>(*this, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T *Entity::getComponent()
+    {
+        return m_manager.getComponent<T>(*this);
+    }
+
+    template <typename T>
+    bool Entity::removeComponent()
+    {
+        return m_manager.removeComponent<T>(*this);
+    }
+
+    template <typename T>
+    bool Entity::markChanged()
+    {
+        return m_manager.markChanged<T>(*this);
+    }
+
+    template <typename... Types>
+    template <typename Func>
+    void View<Types...>::each(Func &&func)
+    {
+        for (Entity *entity : *m_view)
         {
-            return entity->hasComponent<T>();
+            unsigned int index = entity->getIndex();
+            std::apply([&](ComponentPool<Types> *...pools)
+                       { func(*entity, *pools->get(index)...); },
+                       m_pools);
         }
+    }
 
-        template <typename T, typename U, typename... Args>
-        bool hasAllComponents(Entity *entity)
+    template <typename... Types>
+    template <typename Func>
+    void View<Types...>::eachChanged(std::uint32_t sinceTick, Func &&func)
+    {
+        for (Entity *entity : *m_view)
         {
-            return entity->hasComponent<T>() && hasAllComponents<U, Args...>(entity);
+            unsigned int index = entity->getIndex();
+            std::apply([&](ComponentPool<Types> *...pools)
+                       {
+                if (((pools->getChangedTick(index) >= sinceTick) || ...))
+                {
+                    func(*entity, *pools->get(index)...);
+                } },
+                       m_pools);
         }
+    }
 
-        // Base case for variadic template
-        bool hasAllComponents(Entity *entity)
+    template <typename... Types>
+    template <typename Func>
+    void View<Types...>::eachAdded(std::uint32_t sinceTick, Func &&func)
+    {
+        for (Entity *entity : *m_view)
         {
-            return true;
+            unsigned int index = entity->getIndex();
+            std::apply([&](ComponentPool<Types> *...pools)
+                       {
+                if (((pools->getAddedTick(index) >= sinceTick) || ...))
+                {
+                    func(*entity, *pools->get(index)...);
+                } },
+                       m_pools);
         }
-    };
+    }
 
 } // namespace Core
\ No newline at end of file
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+
+    /**
+     * @brief Linear (bump) allocator for transient data
+     *
+     * Allocating moves a pointer forward in a block; nothing is freed
+     * individually. The whole arena is released at once by reset(), or back
+     * to a marker by rewind() or a Scope. Blocks are kept for reuse, and
+     * reset() merges them into one block as large as everything used, so
+     * that a steady-state frame is served from a single block without
+     * calling malloc.
+     *
+     * Objects allocated from an arena never have their destructor called.
+     * An arena is not thread-safe: use one arena per thread, such as the
+     * thread's frame arena from getThreadArena().
+     */
+    class FrameArena
+    {
+    public:
+        /**
+         * @brief Position in the arena, to release what was allocated after it
+         */
+        struct Marker
+        {
+            std::size_t block = 0;
+            std::size_t offset = 0;
+            std::size_t used = 0;
+        };
+
+        /**
+         * @brief Release everything allocated from an arena during its lifetime
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(FrameArena &arena)
+                : m_arena(arena), m_marker(arena.getMarker())
+            {
+            }
+
+            ~Scope()
+            {
+                m_arena.rewind(m_marker);
+            }
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            FrameArena &m_arena;
+            Marker m_marker;
+        };
+
+        /**
+         * @brief Constructor
+         * @param blockSize Size of the blocks allocated when the arena is full
+         */
+        explicit FrameArena(std::size_t blockSize = 64 * 1024);
+
+        FrameArena(const FrameArena &) = delete;
+        FrameArena &operator=(const FrameArena &) = delete;
+
+        /**
+         * @brief Allocate raw memory
+         * @param size Number of bytes
+         * @param alignment Alignment of the memory, a power of two
+         * @return Memory valid until the arena is reset or rewound before it
+         */
+        void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Construct an object in the arena
+         * @tparam T Type of the object, trivially destructible since it is never destroyed
+         * @param args Constructor arguments
+         * @return The object
+         */
+        template <typename T, typename... Args>
+        T *create(Args &&...args)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "Arena objects are never destroyed");
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Get the current position, to rewind to it later
+         * @return Marker of the current position
+         */
+        Marker getMarker() const;
+
+        /**
+         * @brief Release everything allocated since a marker
+         * @param marker Position returned by getMarker(), not already released
+         */
+        void rewind(const Marker &marker);
+
+        /**
+         * @brief Release everything, keeping the memory for the next allocations
+         */
+        void reset();
+
+        /**
+         * @brief Get the number of bytes allocated since the last reset, alignment included
+         * @return Bytes in use
+         */
+        std::size_t getUsedBytes() const;
+
+        /**
+         * @brief Get the highest number of bytes used between two resets
+         * @return Peak bytes in use
+         */
+        std::size_t getPeakBytes() const;
+
+        /**
+         * @brief Get the memory owned by the arena
+         * @return Total size of its blocks in bytes
+         */
+        std::size_t getCapacity() const;
+
+        /**
+         * @brief Get the frame arena of the calling thread
+         *
+         * The first call of each thread in a new frame resets the thread's
+         * arena, so its memory lasts until the end of the current frame.
+         * Jobs spanning several frames must use their own arena.
+         * @return Arena of the calling thread
+         */
+        static FrameArena &getThreadArena();
+
+        /**
+         * @brief Start a new frame: each thread's frame arena is reset on its next use
+         *
+         * Called by the Engine at frame end, when no job of the frame runs.
+         */
+        static void nextFrame();
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size;
+        };
+
+        std::vector<Block> m_blocks;
+        std::size_t m_blockSize;
+        std::size_t m_current; // Block being filled
+        std::size_t m_offset;  // Next free byte in the current block
+        std::size_t m_used;
+        std::size_t m_peak;
+        unsigned int m_frame; // Frame of the last reset, for thread arenas
+    };
+
+    /**
+     * @brief STL allocator taking its memory from a FrameArena
+     *
+     * Deallocation does nothing: the memory is released with the arena.
+     * A default-constructed allocator uses the calling thread's frame arena,
+     * so containers using it must not outlive the frame.
+     * @tparam T Allocated type
+     */
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator()
+            : m_arena(&FrameArena::getThreadArena())
+        {
+        }
+
+        ArenaAllocator(FrameArena &arena) noexcept
+            : m_arena(&arena)
+        {
+        }
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+            : m_arena(other.getArena())
+        {
+        }
+
+        T *allocate(std::size_t count)
+        {
+            return static_cast<T *>(m_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *, std::size_t) noexcept
+        {
+        }
+
+        FrameArena *getArena() const noexcept
+        {
+            return m_arena;
+        }
+
+    private:
+        FrameArena *m_arena;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) noexcept
+    {
+        return a.getArena() == b.getArena();
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) noexcept
+    {
+        return !(a == b);
+    }
+
+    /**
+     * @brief Vector whose storage comes from a FrameArena, the thread's frame arena by default
+     */
+    template <typename T>
+    using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace Core
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+
+    /**
+     * @brief Measured cost of the recent frames, as seen by a FramePacer
+     */
+    struct FramePacerStats
+    {
+        float budgetMs = 0.f;    // Time available per frame at the target frame rate
+        float cpuMs = 0.f;       // Work of the last frame, before presenting
+        float presentMs = 0.f;   // Presentation of the last frame
+        float predictedMs = 0.f; // Expected cost of the next frame (cpu + present), smoothed
+        int qualityLevel = 0;    // 0 is full quality
+        int maxQualityLevel = 0;
+    };
+
+    /**
+     * @brief Change of quality level decided by a FramePacer
+     */
+    struct QualityDecision
+    {
+        std::uint64_t frame = 0;
+        int fromLevel = 0;
+        int toLevel = 0;
+        float predictedMs = 0.f;
+        float budgetMs = 0.f;
+    };
+
+    /**
+     * @brief Paces the frames to a target rate and scales quality to fit the budget
+     *
+     * Each frame, the pacer measures the work before presenting (CPU time)
+     * and the presentation itself. It lowers the quality level by one step
+     * as soon as the smoothed cost predicts a budget miss for a few frames,
+     * and raises it again after a longer run of frames with headroom, so
+     * that the level does not oscillate. After each change, the pacer waits
+     * for the change to show in the measures before deciding again.
+     *
+     * Quality knobs map the level to a value between their full and lowest
+     * quality; the value is passed to the knob's apply function when the
+     * level changes. Changes are only applied by applyQuality(), which the
+     * caller runs at a point where the affected systems are idle.
+     *
+     * When the frame limit is enabled, waitForNextFrame() sleeps until the
+     * frame's deadline, so the waiting is never counted as present time.
+     */
+    class FramePacer
+    {
+    public:
+        using ApplyFunction = std::function<void(float)>;
+
+        /**
+         * @brief Constructor
+         * @param targetFramerate Frames per second to pace to and budget for
+         */
+        explicit FramePacer(float targetFramerate = 60.f);
+
+        /**
+         * @brief Set the frame rate to pace to and budget for
+         * @param framesPerSecond Target frame rate, greater than 0
+         */
+        void setTargetFramerate(float framesPerSecond);
+
+        /**
+         * @brief Enable or disable the sleeping in waitForNextFrame()
+         *
+         * The quality scaling keeps using the target frame rate as budget.
+         * @param enabled false to run uncapped
+         */
+        void setFrameLimitEnabled(bool enabled);
+
+        /**
+         * @brief Enable or disable the quality scaling
+         *
+         * Disabling it restores full quality.
+         * @param enabled false to keep the current quality level
+         */
+        void setQualityScalingEnabled(bool enabled);
+
+        /**
+         * @brief Set the number of quality levels below full quality
+         * @param levels Lowest quality level, at least 1
+         */
+        void setMaxQualityLevel(int levels);
+
+        /**
+         * @brief Register a quality knob
+         *
+         * The knob is applied right away with the value of the current level.
+         * @param name Name shown in the decisions log
+         * @param fullQuality Value at quality level 0
+         * @param lowestQuality Value at the maximum quality level
+         * @param apply Function receiving the value whenever the level changes
+         */
+        void addKnob(const std::string &name, float fullQuality, float lowestQuality, ApplyFunction apply);
+
+        /**
+         * @brief Mark the start of a frame
+         */
+        void beginFrame();
+
+        /**
+         * @brief Mark the start of the presentation, ending the CPU work of the frame
+         */
+        void beginPresent();
+
+        /**
+         * @brief Mark the end of the presentation
+         */
+        void endPresent();
+
+        /**
+         * @brief Measure the frame and decide the quality level of the next ones
+         */
+        void endFrame();
+
+        /**
+         * @brief Apply a pending change of quality level to every knob
+         */
+        void applyQuality();
+
+        /**
+         * @brief Sleep until the end of the frame's time slot, if the frame limit is enabled
+         */
+        void waitForNextFrame();
+
+        /**
+         * @brief Get the current quality level
+         * @return 0 for full quality, up to the maximum quality level
+         */
+        int getQualityLevel() const;
+
+        /**
+         * @brief Get the measurements of the last frame
+         * @return Frame cost and quality level
+         */
+        const FramePacerStats &getStats() const;
+
+        /**
+         * @brief Get the latest quality level changes, oldest first
+         * @return Recent decisions
+         */
+        const std::deque<QualityDecision> &getDecisions() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Knob
+        {
+            std::string name;
+            float fullQuality;
+            float lowestQuality;
+            ApplyFunction apply;
+        };
+
+        static constexpr std::size_t DECISION_HISTORY = 64;
+
+        float getKnobValue(const Knob &knob, int level) const;
+        void changeLevel(int level);
+
+        std::vector<Knob> m_knobs;
+        std::deque<QualityDecision> m_decisions;
+        FramePacerStats m_stats;
+
+        Clock::time_point m_frameStart;
+        Clock::time_point m_presentStart;
+        Clock::time_point m_presentEnd;
+        bool m_presented; // beginPresent() and endPresent() were called this frame
+
+        bool m_frameLimitEnabled;
+        bool m_qualityScalingEnabled;
+        int m_targetLevel;      // Level decided by endFrame()
+        int m_appliedLevel;     // Level the knobs are set to
+        int m_overBudgetFrames; // Consecutive frames predicted over budget
+        int m_headroomFrames;   // Consecutive frames predicted with headroom
+        int m_settleFrames;     // Frames to wait after a change before deciding again
+        std::uint64_t m_frameIndex;
+    };
+
+} // namespace Core
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "RingBuffer.hpp"
+
+namespace Core
+{
+
+    /**
+     * @brief Input event stamped with the time it was polled from the window
+     */
+    struct InputEvent
+    {
+        using Clock = std::chrono::steady_clock;
+
+        InputEvent();
+        InputEvent(const sf::Event &event, Clock::time_point timestamp);
+
+        sf::Event event;
+        Clock::time_point timestamp;
+    };
+
+    /**
+     * @brief Input-to-present latency measured over the presented frames
+     */
+    struct InputLatencyStats
+    {
+        float lastMs = 0.f;    // Latency of the last frame that consumed input
+        float averageMs = 0.f; // Mean over all samples
+        float maxMs = 0.f;
+        std::uint64_t samples = 0;
+    };
+
+    /**
+     * @brief Queue of timestamped input events between the window and their consumers
+     *
+     * The window side pushes every pending event each frame; the UI and
+     * gameplay side pops them, possibly from another thread. Events pushed
+     * while the queue is full are dropped and counted.
+     *
+     * Latency is measured from the oldest event popped since the last
+     * presented frame to the moment that frame is presented, which is the
+     * part of the input-to-photon delay the engine controls.
+     */
+    class InputQueue
+    {
+    public:
+        using Clock = InputEvent::Clock;
+
+        /**
+         * @brief Constructor
+         * @param capacity Maximum number of queued events
+         */
+        explicit InputQueue(std::size_t capacity = 1024);
+
+        /**
+         * @brief Queue an event, from the window thread
+         * @param event Event polled from the window
+         * @param timestamp Time the event was polled
+         * @return false if the queue is full and the event was dropped
+         */
+        bool push(const sf::Event &event, Clock::time_point timestamp = Clock::now());
+
+        /**
+         * @brief Take the oldest event, from the consuming thread
+         * @param event Receives the event
+         * @return false if no event is queued
+         */
+        bool pop(InputEvent &event);
+
+        /**
+         * @brief Get the number of queued events
+         * @return Event count
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Get the number of events dropped because the queue was full
+         * @return Dropped event count
+         */
+        std::uint64_t getDroppedCount() const;
+
+        /**
+         * @brief Record that the frame reflecting the popped events was presented
+         * @param presentTime Time the frame was presented
+         */
+        void notifyPresented(Clock::time_point presentTime = Clock::now());
+
+        /**
+         * @brief Get the latency measured so far
+         * @return Latency statistics
+         */
+        const InputLatencyStats &getLatencyStats() const;
+
+        /**
+         * @brief Reset the latency statistics
+         */
+        void resetLatencyStats();
+
+    private:
+        RingBuffer<InputEvent> m_events;
+        std::atomic<std::uint64_t> m_dropped;
+
+        // Oldest event popped since the last presented frame
+        Clock::time_point m_oldestPending;
+        bool m_hasPending;
+
+        InputLatencyStats m_latency;
+    };
+
+} // namespace Core
\ No newline at end of file
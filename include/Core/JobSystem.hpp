@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core
+{
+
+    /**
+     * @brief Counts the unfinished jobs of a group so that they can be waited on
+     */
+    class JobCounter
+    {
+    public:
+        JobCounter();
+
+        /**
+         * @brief Check if every job of the group has finished
+         * @return true if no job is pending
+         */
+        bool isDone() const;
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<int> m_pending;
+    };
+
+    /**
+     * @brief Pool of worker threads executing jobs with work stealing
+     *
+     * Each worker owns a deque: it pushes and pops its own jobs at the back
+     * and, when it runs dry, steals the oldest job at the front of another
+     * worker's deque. Jobs submitted from a thread that is not a worker go
+     * to a shared queue. Threads waiting on a counter execute jobs instead
+     * of blocking.
+     *
+     * Every job runs inside a profiler zone carrying its name, and the
+     * workers are named in the trace, so jobs show up in the profiler
+     * like the rest of the frame.
+     */
+    class JobSystem
+    {
+    public:
+        using Job = std::function<void()>;
+
+        /**
+         * @brief Constructor
+         * @param workerCount Number of worker threads, 0 to use one per extra hardware thread
+         */
+        explicit JobSystem(unsigned int workerCount = 0);
+
+        /**
+         * @brief Destructor, finishes the queued jobs and joins the workers
+         */
+        ~JobSystem();
+
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        /**
+         * @brief Queue a job
+         * @param job Function to execute
+         * @param counter Optional counter incremented now and decremented when the job finishes
+         * @param name Profiler zone of the job, must outlive it (literal or Profiler::intern())
+         */
+        void submit(Job job, JobCounter *counter = nullptr, const char *name = "Job");
+
+        /**
+         * @brief Queue a job once every job of another counter has finished
+         *
+         * The job is held back, without occupying a worker, until the
+         * dependency is done. The counter is incremented immediately, so
+         * chains of jobs can be waited on through their last counter.
+         * @param dependency Counter to wait for, must outlive the job
+         * @param job Function to execute
+         * @param counter Optional counter incremented now and decremented when the job finishes
+         * @param name Profiler zone of the job, must outlive it
+         */
+        void submitAfter(const JobCounter &dependency, Job job, JobCounter *counter = nullptr, const char *name = "Job");
+
+        /**
+         * @brief Run a function over a range of indices, split in chunks executed in parallel
+         *
+         * The calling thread takes part in the work and returns once every
+         * chunk has finished. Ranges no larger than one chunk run inline.
+         * @param begin First index
+         * @param end Index past the last one
+         * @param grain Number of indices per chunk, at least 1
+         * @param function Called as function(chunkBegin, chunkEnd) for each chunk
+         * @param name Profiler zone of the chunks, must outlive the call
+         */
+        template <typename Function>
+        void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Function &&function,
+                         const char *name = "parallelFor");
+
+        /**
+         * @brief Wait until every job of a counter has finished, helping with queued jobs meanwhile
+         * @param counter Counter to wait on
+         */
+        void wait(const JobCounter &counter);
+
+        /**
+         * @brief Get the number of worker threads
+         * @return Number of workers, not counting the threads calling wait()
+         */
+        unsigned int getWorkerCount() const;
+
+    private:
+        struct QueuedJob
+        {
+            Job job;
+            JobCounter *counter = nullptr;
+            const char *name = nullptr;
+        };
+
+        struct DeferredJob
+        {
+            const JobCounter *dependency;
+            QueuedJob job;
+        };
+
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<QueuedJob> jobs;
+        };
+
+        void workerLoop(unsigned int queueIndex);
+        bool runPendingJob(unsigned int queueIndex);
+        bool popJob(unsigned int queueIndex, QueuedJob &job);
+        bool stealJob(unsigned int thiefIndex, QueuedJob &job);
+        void enqueue(QueuedJob job);
+
+        // Queue the deferred jobs whose dependency has finished
+        void releaseDeferredJobs();
+
+        unsigned int getCurrentQueueIndex() const;
+
+        // Queue 0 is shared by external threads, queue i + 1 belongs to worker i
+        std::vector<std::unique_ptr<WorkQueue>> m_queues;
+        std::vector<std::thread> m_workers;
+
+        std::atomic<bool> m_running;
+        std::atomic<int> m_queuedJobs;
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wakeCondition;
+
+        std::mutex m_deferredMutex;
+        std::vector<DeferredJob> m_deferredJobs;
+        std::atomic<int> m_deferredCount; // Checked without the lock after each job
+    };
+
+    template <typename Function>
+    void JobSystem::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Function &&function,
+                                const char *name)
+    {
+        grain = std::max<std::size_t>(grain, 1);
+        if (end <= begin)
+        {
+            return;
+        }
+        if (end - begin <= grain)
+        {
+            function(begin, end);
+            return;
+        }
+
+        // The last chunk is kept for the calling thread, which then helps with the others
+        JobCounter counter;
+        std::size_t chunkBegin = begin;
+        for (; end - chunkBegin > grain; chunkBegin += grain)
+        {
+            std::size_t chunkEnd = chunkBegin + grain;
+            submit([&function, chunkBegin, chunkEnd]()
+                   { function(chunkBegin, chunkEnd); }, &counter, name);
+        }
+        function(chunkBegin, end);
+        wait(counter);
+    }
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Core
+{
+
+    /**
+     * @brief Spatial index of rectangles, queried by area
+     *
+     * Each node covers a quarter of its parent's cell, but accepts items
+     * overlapping up to half a cell beyond it (its loose bounds). An item is
+     * therefore stored in exactly one node, chosen from its size and center
+     * alone: inserting, moving or removing it never splits nor rebalances
+     * the tree. The tree grows toward items whose center is slightly
+     * outside its bounds, keeping the size of its smallest cells; items far
+     * outside are kept in the root, where they are still found, only less
+     * efficiently.
+     *
+     * Items are identified by small integers, such as entity slot indices.
+     * Nodes are created on first use and kept once empty.
+     */
+    class LooseQuadTree
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param bounds Area initially covered by the tree
+         * @param maxDepth Depth of the smallest nodes within the initial area
+         */
+        explicit LooseQuadTree(const sf::FloatRect &bounds = sf::FloatRect({-32768.f, -32768.f}, {65536.f, 65536.f}),
+                               unsigned int maxDepth = 8);
+
+        /**
+         * @brief Add an item, or move it if it is already in the tree
+         * @param id Item identifier
+         * @param bounds Area covered by the item
+         */
+        void insert(std::uint32_t id, const sf::FloatRect &bounds);
+
+        /**
+         * @brief Remove an item
+         * @param id Item identifier
+         * @return true if the item was in the tree
+         */
+        bool remove(std::uint32_t id);
+
+        /**
+         * @brief Check if an item is in the tree
+         * @param id Item identifier
+         * @return true if the item was inserted and not removed since
+         */
+        bool contains(std::uint32_t id) const;
+
+        /**
+         * @brief Remove every item and node
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of items
+         * @return Item count
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Call a function for every item overlapping an area
+         * @param area Area to search
+         * @param func Callable taking (std::uint32_t id)
+         */
+        template <typename Func>
+        void query(const sf::FloatRect &area, Func &&func) const;
+
+    private:
+        static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+        // Float cell coordinates stay precise up to this many cells per side;
+        // beyond it, items outside the bounds stay in the root
+        static constexpr unsigned int MAX_DEPTH = 16;
+
+        struct Node
+        {
+            std::array<std::uint32_t, 4> children{NONE, NONE, NONE, NONE};
+            std::uint32_t parent = NONE;
+            std::uint32_t firstItem = NONE;
+            std::uint32_t itemCount = 0; // Items in this node and below it
+        };
+
+        // Items form a doubly linked list per node, indexed by item identifier
+        struct Item
+        {
+            sf::FloatRect bounds;
+            std::uint32_t node = NONE; // NONE when the identifier is not in the tree
+            std::uint32_t previous = NONE;
+            std::uint32_t next = NONE;
+        };
+
+        struct Visit
+        {
+            std::uint32_t node;
+            sf::FloatRect cell; // Cell of the node, before loosening
+        };
+
+        std::uint32_t findNode(const sf::FloatRect &bounds);
+        bool grow(const sf::Vector2f &point);
+        void link(std::uint32_t id, std::uint32_t node);
+        void unlink(std::uint32_t id);
+        static bool intersects(const sf::FloatRect &a, const sf::FloatRect &b);
+
+        sf::FloatRect m_bounds;
+        unsigned int m_depth; // Depth of the smallest cells
+        std::vector<Node> m_nodes; // The root is the first node
+        std::vector<Item> m_items;
+        std::size_t m_size;
+    };
+
+    template <typename Func>
+    void LooseQuadTree::query(const sf::FloatRect &area, Func &&func) const
+    {
+        // Depth-first with a fixed stack: at most three siblings wait per level
+        std::array<Visit, 3 * MAX_DEPTH + 4> stack;
+        std::size_t top = 0;
+        stack[top++] = Visit{0, m_bounds};
+
+        while (top > 0)
+        {
+            Visit visit = stack[--top];
+            const Node &node = m_nodes[visit.node];
+
+            for (std::uint32_t id = node.firstItem; id != NONE; id = m_items[id].next)
+            {
+                if (intersects(m_items[id].bounds, area))
+                {
+                    func(id);
+                }
+            }
+
+            sf::Vector2f half = visit.cell.size / 2.f;
+            for (std::size_t quadrant = 0; quadrant < 4; ++quadrant)
+            {
+                std::uint32_t child = node.children[quadrant];
+                if (child == NONE || m_nodes[child].itemCount == 0)
+                {
+                    continue;
+                }
+
+                sf::FloatRect cell(visit.cell.position + sf::Vector2f((quadrant & 1) ? half.x : 0.f, (quadrant & 2) ? half.y : 0.f), half);
+                sf::FloatRect loose(cell.position - half / 2.f, cell.size * 2.f);
+                if (intersects(loose, area))
+                {
+                    stack[top++] = Visit{child, cell};
+                }
+            }
+        }
+    }
+
+} // namespace Core
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "RingBuffer.hpp"
+
+/**
+ * Profiling zones are only compiled when ORENJI_PROFILING is defined (see
+ * the ORENJI_ENABLE_PROFILING CMake option); otherwise the macros expand
+ * to nothing and their arguments are not evaluated.
+ *
+ * ORENJI_ZONE(name) times the enclosing scope. The name must outlive the
+ * profiling session: a string literal, or a name returned by
+ * Core::Profiler::intern().
+ * ORENJI_FRAME_MARK() ends a frame, once per frame on the main thread.
+ * ORENJI_THREAD_NAME(name) names the calling thread in the trace.
+ */
+#if defined(ORENJI_PROFILING)
+#define ORENJI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ORENJI_PROFILE_CONCAT(a, b) ORENJI_PROFILE_CONCAT_IMPL(a, b)
+#define ORENJI_ZONE(name) ::Core::ProfileZone ORENJI_PROFILE_CONCAT(orenjiProfileZone, __LINE__)(name)
+#define ORENJI_FRAME_MARK() ::Core::Profiler::getInstance().endFrame()
+#define ORENJI_THREAD_NAME(name) ::Core::Profiler::getInstance().setThreadName(name)
+#else
+#define ORENJI_ZONE(name) ((void)0)
+#define ORENJI_FRAME_MARK() ((void)0)
+#define ORENJI_THREAD_NAME(name) ((void)0)
+#endif
+
+namespace Core
+{
+
+    /**
+     * @brief Rolling statistics of the frame times
+     */
+    struct FrameTimeStats
+    {
+        float averageMs = 0.f;
+        float p50Ms = 0.f;
+        float p90Ms = 0.f;
+        float p99Ms = 0.f;
+        float maxMs = 0.f;
+        std::size_t frameCount = 0; // Frames in the rolling window
+    };
+
+    /**
+     * @brief Collects timed zones from every thread and the frame times
+     *
+     * Each thread records its zones into its own lock-free buffer, so
+     * recording never blocks. The buffers are drained at the end of every
+     * frame; the zones are kept only while a capture is running, to be
+     * written as a Chrome trace (chrome://tracing, ui.perfetto.dev).
+     */
+    class Profiler
+    {
+    public:
+        /**
+         * @brief Zone recorded by a thread
+         */
+        struct ZoneRecord
+        {
+            const char *name = nullptr;
+            std::int64_t startNs = 0; // Since the profiler was created
+            std::int64_t endNs = 0;
+        };
+
+        /**
+         * @brief Get the profiler shared by the whole process
+         * @return Profiler instance
+         */
+        static Profiler &getInstance();
+
+        Profiler(const Profiler &) = delete;
+        Profiler &operator=(const Profiler &) = delete;
+
+        /**
+         * @brief Enable or disable the recording of zones at runtime
+         * @param enabled false to make zones skip recording
+         */
+        void setEnabled(bool enabled);
+
+        /**
+         * @brief Check if zones are recorded
+         * @return true if enabled
+         */
+        bool isEnabled() const;
+
+        /**
+         * @brief Get the current time on the profiler clock
+         * @return Nanoseconds since the profiler was created
+         */
+        std::int64_t now() const;
+
+        /**
+         * @brief Record a finished zone on the calling thread's buffer
+         * @param name Zone name, must outlive the profiling session
+         * @param startNs Start time from now()
+         * @param endNs End time from now()
+         */
+        void recordZone(const char *name, std::int64_t startNs, std::int64_t endNs);
+
+        /**
+         * @brief Name the calling thread in the trace
+         * @param name Thread name
+         */
+        void setThreadName(const std::string &name);
+
+        /**
+         * @brief Get a copy of a name that lives as long as the profiler
+         * @param name Name, e.g. of a system or a scene
+         * @return Stable pointer to the name, the same for equal names
+         */
+        const char *intern(const std::string &name);
+
+        /**
+         * @brief End the current frame, from the main thread
+         *
+         * Records the frame time and drains the zones of every thread.
+         */
+        void endFrame();
+
+        /**
+         * @brief Get the statistics of the recent frame times
+         * @return Percentiles over the rolling window
+         */
+        FrameTimeStats getFrameTimeStats() const;
+
+        /**
+         * @brief Get the recent frame times, oldest first
+         * @return Frame times in milliseconds
+         */
+        std::vector<float> getFrameTimes() const;
+
+        /**
+         * @brief Start keeping the recorded zones, dropping a previous capture
+         */
+        void startCapture();
+
+        /**
+         * @brief Stop keeping the recorded zones
+         */
+        void stopCapture();
+
+        /**
+         * @brief Check if the recorded zones are being kept
+         * @return true if a capture is running
+         */
+        bool isCapturing() const;
+
+        /**
+         * @brief Write the captured zones as a Chrome trace
+         * @param filepath Path to the JSON file
+         * @return true if the file was written
+         */
+        bool writeChromeTrace(const std::string &filepath) const;
+
+        /**
+         * @brief Get the number of zones lost because a thread buffer was full
+         * @return Dropped zone count
+         */
+        std::uint64_t getDroppedZoneCount() const;
+
+    private:
+        struct ThreadBuffer
+        {
+            explicit ThreadBuffer(std::uint32_t id);
+
+            RingBuffer<ZoneRecord> zones;
+            std::uint32_t threadId;
+            std::string threadName;
+        };
+
+        struct CapturedZone
+        {
+            ZoneRecord zone;
+            std::uint32_t threadId;
+        };
+
+        static constexpr std::size_t ZONES_PER_THREAD = 16384;
+        static constexpr std::size_t FRAME_WINDOW = 300;
+
+        Profiler();
+
+        ThreadBuffer &getThreadBuffer();
+
+        std::chrono::steady_clock::time_point m_epoch;
+        std::atomic<bool> m_enabled;
+        std::atomic<std::uint64_t> m_droppedZones;
+
+        // Registration of the thread buffers, which are never freed
+        mutable std::mutex m_threadsMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+
+        std::mutex m_namesMutex;
+        std::unordered_set<std::string> m_names;
+
+        // Main thread only
+        std::int64_t m_lastFrameEnd;
+        std::deque<float> m_frameTimes;
+        bool m_capturing;
+        std::vector<CapturedZone> m_capture;
+    };
+
+    /**
+     * @brief Times its scope as a profiler zone, use through ORENJI_ZONE
+     */
+    class ProfileZone
+    {
+    public:
+        /**
+         * @brief Constructor, starts the zone
+         * @param name Zone name, must outlive the profiling session
+         */
+        explicit ProfileZone(const char *name);
+
+        /**
+         * @brief Destructor, records the zone
+         */
+        ~ProfileZone();
+
+        ProfileZone(const ProfileZone &) = delete;
+        ProfileZone &operator=(const ProfileZone &) = delete;
+
+    private:
+        const char *m_name; // nullptr when the profiler is disabled
+        std::int64_t m_start;
+    };
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+
+    /**
+     * @brief Fixed-capacity lock-free queue for one producer and one consumer thread
+     *
+     * push() must only be called from one thread and pop() from one other
+     * thread (or the same). The storage is allocated once; a full buffer
+     * rejects new elements instead of growing.
+     * @tparam T Element type, default constructible and copy assignable
+     */
+    template <typename T>
+    class RingBuffer
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity Minimum number of elements, rounded up to a power of two
+         */
+        explicit RingBuffer(std::size_t capacity)
+            : m_head(0), m_tail(0)
+        {
+            std::size_t size = 2;
+            while (size < capacity)
+            {
+                size *= 2;
+            }
+            m_slots.resize(size);
+            m_mask = size - 1;
+        }
+
+        RingBuffer(const RingBuffer &) = delete;
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        /**
+         * @brief Append an element, from the producer thread
+         * @param value Element to copy
+         * @return false if the buffer is full
+         */
+        bool push(const T &value)
+        {
+            std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+            {
+                return false;
+            }
+
+            m_slots[tail & m_mask] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Take the oldest element, from the consumer thread
+         * @param value Receives the element
+         * @return false if the buffer is empty
+         */
+        bool pop(T &value)
+        {
+            std::size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            value = std::move(m_slots[head & m_mask]);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Get the number of queued elements
+         * @return Element count, only exact when neither thread is using the buffer
+         */
+        std::size_t size() const
+        {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Check if the buffer holds no element
+         * @return true if empty
+         */
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Get the maximum number of queued elements
+         * @return Capacity
+         */
+        std::size_t capacity() const
+        {
+            return m_mask + 1;
+        }
+
+    private:
+        std::vector<T> m_slots;
+        std::size_t m_mask;
+
+        // Kept on separate cache lines so the two threads do not invalidate each other's
+        alignas(64) std::atomic<std::size_t> m_head; // Next element to pop, written by the consumer
+        alignas(64) std::atomic<std::size_t> m_tail; // Next slot to push, written by the producer
+    };
+
+} // namespace Core
\ No newline at end of file
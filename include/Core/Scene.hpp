@@ -4,9 +4,15 @@
 #include <string>
 #include <memory>
 
+namespace Graphics
+{
+    class RenderSnapshot;
+}
+
 namespace Core
 {
 
+    class CommandBuffer;
     class EntityManager;
 
     /**
@@ -27,7 +33,20 @@ namespace Core
         virtual ~Scene();
 
         /**
-         * @brief Initialize the scene
+         * @brief Load the scene's resources, possibly on a worker thread
+         *
+         * Called once by the SceneManager before init(), on its loader
+         * thread, while the current scene keeps running: textures, maps,
+         * behavior trees... The ResourceManager can be used from there. It
+         * must not touch the window nor the entity manager, which the scene
+         * is only given when it enters the stack. Entities can be prepared
+         * in getLoadCommands(); they are created on the main thread, just
+         * before init().
+         */
+        virtual void load();
+
+        /**
+         * @brief Initialize the scene, on the main thread, when it enters the scene stack
          */
         virtual void init() = 0;
 
@@ -43,12 +62,45 @@ namespace Core
          */
         virtual void render(sf::RenderWindow &window) = 0;
 
+        /**
+         * @brief Record the scene's drawing into a snapshot, for pipelined rendering
+         *
+         * Called between two simulation steps; the snapshot is drawn while
+         * the next step runs, so it must own copies of what the scene draws.
+         * Scenes that do not override it are rendered with render(), without
+         * overlapping the simulation.
+         * @param snapshot Snapshot to add the scene's drawables to
+         * @return true if the scene supports snapshots
+         */
+        virtual bool capture(Graphics::RenderSnapshot &snapshot);
+
         /**
          * @brief Handle an event
          * @param event SFML event
          */
         virtual void handleEvent(const sf::Event &event) = 0;
 
+        /**
+         * @brief Called when another scene is pushed on top of this one
+         *
+         * The scene is kept, but no longer updated nor given events.
+         */
+        virtual void onPause();
+
+        /**
+         * @brief Called when this scene is back on top of the stack
+         */
+        virtual void onResume();
+
+        /**
+         * @brief Check if the scenes beneath stay visible under this one
+         *
+         * An overlay, such as a pause menu, is drawn over the scenes below
+         * it, which are paused but still rendered.
+         * @return true for an overlay
+         */
+        virtual bool isOverlay() const;
+
         /**
          * @brief Get the scene name
          * @return Scene name
@@ -68,8 +120,20 @@ namespace Core
         EntityManager *getEntityManager() const;
 
     protected:
+        /**
+         * @brief Get the command buffer recording the entities prepared by load()
+         * @return Reference to the command buffer
+         */
+        CommandBuffer &getLoadCommands();
+
         std::string m_name;
         EntityManager *m_entityManager;
+
+    private:
+        friend class SceneManager;
+
+        bool m_loaded; // load() has run, guarded by the SceneManager
+        std::unique_ptr<CommandBuffer> m_loadCommands;
     };
 
 } // namespace Core
\ No newline at end of file
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Graphics
+{
+    class RenderSnapshot;
+}
+
+namespace Core
+{
+
+    class EntityManager;
+    class Scene;
+
+    /**
+     * @brief Stack of scenes, switched at frame boundaries once they are loaded
+     *
+     * Only the top scene is updated and receives events. The scenes below
+     * are paused but kept; they are still drawn when everything above them
+     * is an overlay (see Scene::isOverlay()).
+     *
+     * push(), replace() and pop() can be called from anywhere, including a
+     * scene's own update. They are queued and applied in order by
+     * applyPending(). A scene that enters the stack is first loaded with
+     * Scene::load() on a dedicated loader thread, so the current scene keeps
+     * running meanwhile and no worker or frame ever waits on file reads;
+     * the switch happens on the first frame after the load has finished.
+     * The loader thread never touches the entity manager: the entities a
+     * scene prepares while loading are recorded in its load commands, which
+     * applyPending() applies on the main thread when the scene enters the
+     * stack.
+     * preload() starts loading a scene ahead of time, to switch to it
+     * instantly later.
+     */
+    class SceneManager
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param entityManager Entity manager given to the scenes
+         */
+        explicit SceneManager(EntityManager &entityManager);
+
+        /**
+         * @brief Destructor, waits for the scene being loaded and drops the queued ones
+         *
+         * The entity manager must outlive the scene manager.
+         */
+        ~SceneManager();
+
+        SceneManager(const SceneManager &) = delete;
+        SceneManager &operator=(const SceneManager &) = delete;
+
+        /**
+         * @brief Start loading a scene in the background, without switching to it
+         * @param scene Scene to load
+         */
+        void preload(std::shared_ptr<Scene> scene);
+
+        /**
+         * @brief Put a scene on top of the stack, pausing the current one
+         * @param scene Scene to push
+         */
+        void push(std::shared_ptr<Scene> scene);
+
+        /**
+         * @brief Replace the top scene, which is released
+         * @param scene Scene taking its place
+         */
+        void replace(std::shared_ptr<Scene> scene);
+
+        /**
+         * @brief Release the top scene and resume the one below
+         */
+        void pop();
+
+        /**
+         * @brief Release every scene
+         */
+        void clear();
+
+        /**
+         * @brief Apply the queued changes whose scenes are loaded, in order
+         *
+         * Called by the engine at the start of a frame, on the main thread,
+         * while the simulation is not running.
+         */
+        void applyPending();
+
+        /**
+         * @brief Wait for every scene being loaded
+         */
+        void finishLoading();
+
+        /**
+         * @brief Check if changes are waiting to be applied
+         * @return true if a change is queued
+         */
+        bool hasPending() const;
+
+        /**
+         * @brief Check if a scene is loading in the background
+         * @return true if a load has not finished yet
+         */
+        bool isLoading() const;
+
+        /**
+         * @brief Get the top scene
+         * @return Active scene, or nullptr if the stack is empty
+         */
+        Scene *getActiveScene() const;
+
+        /**
+         * @brief Get the number of scenes in the stack
+         * @return Stack size
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Check if the stack is empty
+         * @return true if there is no scene
+         */
+        bool empty() const;
+
+        /**
+         * @brief Update the top scene
+         * @param deltaTime Time since last update in seconds
+         */
+        void update(float deltaTime);
+
+        /**
+         * @brief Pass an event to the top scene
+         * @param event SFML event
+         */
+        void handleEvent(const sf::Event &event);
+
+        /**
+         * @brief Render the visible scenes, bottom first
+         * @param window Render window
+         */
+        void render(sf::RenderWindow &window);
+
+        /**
+         * @brief Record the visible scenes into a snapshot, bottom first
+         * @param snapshot Snapshot to fill
+         * @return false if a visible scene does not support snapshots
+         */
+        bool capture(Graphics::RenderSnapshot &snapshot);
+
+    private:
+        enum class OperationType
+        {
+            Push,
+            Replace,
+            Pop,
+            Clear
+        };
+
+        struct Operation
+        {
+            OperationType type;
+            std::shared_ptr<Scene> scene;
+        };
+
+        struct Load
+        {
+            std::shared_ptr<Scene> scene;
+            bool done;
+        };
+
+        // Queue an operation, loading its scene if needed; requires m_mutex
+        void enqueue(OperationType type, std::shared_ptr<Scene> scene);
+
+        // Start loading a scene unless it already is; requires m_mutex
+        void startLoad(const std::shared_ptr<Scene> &scene);
+
+        // Check if a scene has finished loading and forget its load; requires m_mutex
+        bool takeLoaded(const Scene *scene);
+
+        void apply(Operation &operation);
+
+        // Hand a scene the entity manager, create its loaded entities and initialize it
+        void enter(Scene &scene);
+
+        // Loader thread: runs Scene::load() for the queued scenes, in order
+        void loaderMain();
+
+        // Index of the lowest scene drawn: the top one and the overlays' background
+        std::size_t firstVisible() const;
+
+        EntityManager &m_entityManager;
+
+        std::vector<std::shared_ptr<Scene>> m_stack; // Main thread only
+
+        mutable std::mutex m_mutex;
+        std::deque<Operation> m_pending;
+        std::vector<Load> m_loads;
+        std::deque<std::shared_ptr<Scene>> m_loadQueue; // Scenes waiting for the loader thread
+        std::condition_variable m_loadCondition;        // Signals a queued scene or the shutdown
+        std::condition_variable m_loadedCondition;      // Signals a finished load
+        bool m_loadRunning; // The loader thread is inside Scene::load()
+        bool m_stopping;
+
+        std::thread m_loader; // Started last, once the members it uses exist
+    };
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "EntityManager.hpp"
+
+namespace Core
+{
+
+    /**
+     * @brief Receives the fields of a component being saved
+     *
+     * A snapshot is positional: fields are read back in the order they were
+     * written. Field names are only used by the JSON debug export.
+     */
+    class SnapshotWriter
+    {
+    public:
+        using FieldValue = std::variant<std::int64_t, double, bool, std::string>;
+
+        /**
+         * @brief Named field, as listed for the JSON export
+         */
+        struct Field
+        {
+            std::string name;
+            FieldValue value;
+        };
+
+        /**
+         * @brief Constructor writing binary data
+         * @param buffer Buffer the fields are appended to
+         */
+        explicit SnapshotWriter(std::vector<std::uint8_t> &buffer);
+
+        /**
+         * @brief Constructor listing named fields
+         * @param fields List the fields are appended to
+         */
+        explicit SnapshotWriter(std::vector<Field> &fields);
+
+        void write(const char *name, std::int32_t value);
+        void write(const char *name, std::uint32_t value);
+        void write(const char *name, float value);
+        void write(const char *name, bool value);
+        void write(const char *name, const std::string &value);
+        void write(const char *name, const sf::Vector2f &value);
+
+        /**
+         * @brief Write a reference to another entity, remapped on load
+         * @param name Field name
+         * @param value Entity handle, may be invalid
+         */
+        void write(const char *name, EntityHandle value);
+
+    private:
+        friend class SnapshotSerializer;
+
+        template <typename T>
+        void writeRaw(const T &value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written raw");
+            std::size_t offset = m_buffer->size();
+            m_buffer->resize(offset + sizeof(T));
+            std::memcpy(m_buffer->data() + offset, &value, sizeof(T));
+        }
+
+        void writeBytes(const void *data, std::size_t size);
+
+        std::vector<std::uint8_t> *m_buffer;
+        std::vector<Field> *m_fields;
+    };
+
+    /**
+     * @brief Reads back the fields of a component, in the order they were written
+     *
+     * Reads past the end of the data leave the value untouched and put the
+     * reader in a failed state, checked once the component is loaded.
+     */
+    class SnapshotReader
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param data Snapshot data, not copied
+         * @param size Size of the data in bytes
+         * @param entityMap Saved entity ids mapped to the entities created on load
+         */
+        SnapshotReader(const std::uint8_t *data, std::size_t size,
+                       const std::unordered_map<EntityId, EntityHandle> *entityMap = nullptr);
+
+        void read(std::int32_t &value);
+        void read(std::uint32_t &value);
+        void read(float &value);
+        void read(bool &value);
+        void read(std::string &value);
+        void read(sf::Vector2f &value);
+
+        /**
+         * @brief Read a reference to another entity
+         * @param value Handle of the loaded entity, invalid if it was not part of the snapshot
+         */
+        void read(EntityHandle &value);
+
+        /**
+         * @brief Check if every read so far succeeded
+         * @return false if the data was truncated
+         */
+        bool good() const;
+
+    private:
+        friend class SnapshotSerializer;
+
+        template <typename T>
+        void readRaw(T &value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read raw");
+            readBytes(&value, sizeof(T));
+        }
+
+        void readBytes(void *data, std::size_t size);
+        const std::uint8_t *take(std::size_t size);
+
+        const std::uint8_t *m_data;
+        std::size_t m_size;
+        std::size_t m_offset;
+        bool m_failed;
+        const std::unordered_map<EntityId, EntityHandle> *m_entityMap;
+    };
+
+    /**
+     * @brief Saves and restores all entities and their registered components
+     *
+     * The binary format starts with a versioned header followed by chunks,
+     * each prefixed by a tag and a byte size:
+     * - one entity chunk, a flat array of fixed-size records followed by the
+     *   names, read back in bulk;
+     * - one chunk per registered component type, holding the owners of all
+     *   components of that type followed by their fields, restored into a
+     *   pool reserved up front.
+     * Chunks of component types that are not registered are skipped. The
+     * data is read in place, so it can come from a memory-mapped file.
+     * Values are stored in native byte order.
+     *
+     * Serialization is opt-in per component type: a registered type must be
+     * default constructible and provide
+     * `void save(SnapshotWriter &) const` and `void load(SnapshotReader &)`.
+     */
+    class SnapshotSerializer
+    {
+    public:
+        /**
+         * @brief Current version of the binary format
+         */
+        static constexpr std::uint32_t VERSION = 1;
+
+        SnapshotSerializer();
+        ~SnapshotSerializer();
+
+        /**
+         * @brief Register a component type for serialization
+         * @tparam T Component type
+         * @param name Stable name identifying the type in snapshots
+         */
+        template <typename T>
+        void registerComponent(const std::string &name)
+        {
+            ComponentSerializer serializer;
+            serializer.name = name;
+
+            serializer.save = [](EntityManager &entityManager, const std::vector<std::uint32_t> &ordinals, SnapshotWriter &writer)
+            {
+                ComponentPool<T> &pool = entityManager.getComponentPool<T>();
+                writer.writeRaw(static_cast<std::uint32_t>(pool.size()));
+                for (std::size_t i = 0; i < pool.size(); ++i)
+                {
+                    writer.writeRaw(ordinals[pool.entityAt(i)]);
+                }
+                for (std::size_t i = 0; i < pool.size(); ++i)
+                {
+                    pool.at(i).save(writer);
+                }
+            };
+
+            serializer.load = [](EntityManager &entityManager, const std::vector<Entity *> &entities, SnapshotReader &reader)
+            {
+                std::uint32_t count = 0;
+                reader.readRaw(count);
+                if (!reader.good() || count > entities.size())
+                {
+                    return false;
+                }
+
+                std::vector<std::uint32_t> owners(count);
+                reader.readBytes(owners.data(), count * sizeof(std::uint32_t));
+                entityManager.reserveComponents<T>(entityManager.getComponentPool<T>().size() + count);
+
+                for (std::uint32_t owner : owners)
+                {
+                    if (!reader.good() || owner >= entities.size())
+                    {
+                        return false;
+                    }
+                    entityManager.addComponent<T>(*entities[owner]).load(reader);
+                }
+                return reader.good();
+            };
+
+            serializer.describe = [](Entity &entity, SnapshotWriter &writer)
+            {
+                T *component = entity.getComponent<T>();
+                if (component)
+                {
+                    component->save(writer);
+                }
+                return component != nullptr;
+            };
+
+            m_serializerIndices[name] = m_serializers.size();
+            m_serializers.push_back(std::move(serializer));
+        }
+
+        /**
+         * @brief Save all entities and their registered components
+         * @param entityManager Entity manager to save
+         * @return Binary snapshot
+         */
+        std::vector<std::uint8_t> save(EntityManager &entityManager) const;
+
+        /**
+         * @brief Restore a snapshot, adding its entities to the entity manager
+         *
+         * On failure, the entities created before the error are removed again,
+         * so that the entity manager is left as it was.
+         * @param entityManager Entity manager to fill
+         * @param data Snapshot data
+         * @param size Size of the data in bytes
+         * @return true if the snapshot was restored entirely
+         */
+        bool load(EntityManager &entityManager, const std::uint8_t *data, std::size_t size) const;
+
+        /**
+         * @brief Save a snapshot to a file
+         * @param entityManager Entity manager to save
+         * @param filepath Path to the file
+         * @return true if the file was written
+         */
+        bool saveToFile(EntityManager &entityManager, const std::string &filepath) const;
+
+        /**
+         * @brief Restore a snapshot from a file
+         *
+         * On failure, the entity manager is left as it was.
+         * @param entityManager Entity manager to fill
+         * @param filepath Path to the file
+         * @return true if the snapshot was restored entirely
+         */
+        bool loadFromFile(EntityManager &entityManager, const std::string &filepath) const;
+
+        /**
+         * @brief Describe all entities and their registered components as JSON, for debugging
+         * @param entityManager Entity manager to describe
+         * @param indent Indentation of the output, -1 for a single line
+         * @return JSON text
+         */
+        std::string exportJson(EntityManager &entityManager, int indent = 2) const;
+
+    private:
+        struct ComponentSerializer
+        {
+            std::string name;
+            std::function<void(EntityManager &, const std::vector<std::uint32_t> &, SnapshotWriter &)> save;
+            std::function<bool(EntityManager &, const std::vector<Entity *> &, SnapshotReader &)> load;
+            std::function<bool(Entity &, SnapshotWriter &)> describe;
+        };
+
+        bool loadEntities(EntityManager &entityManager, SnapshotReader &reader,
+                          std::vector<Entity *> &entities, std::unordered_map<EntityId, EntityHandle> &entityMap) const;
+
+        std::vector<ComponentSerializer> m_serializers;
+        std::unordered_map<std::string, std::size_t> m_serializerIndices;
+    };
+
+} // namespace Core
\ No newline at end of file
@@ -1,12 +1,30 @@
 #pragma once
 
+#include <memory>
+#include "ComponentPool.hpp"
+#include "EntityManager.hpp"
+#include "TimeSlicer.hpp"
+
 namespace Core
 {
 
     class EntityManager;
+    class CommandBuffer;
 
     /**
      * @brief Base interface for all systems
+     *
+     * Systems declare which component types they read and write so that the
+     * SystemScheduler can run systems that do not conflict at the same time.
+     * A system that declares nothing is assumed to touch no component at all;
+     * a system that touches state outside the ECS should call setExclusive().
+     * Declaring creates the pools and views involved right away, on the
+     * thread building the system, so that updates running in parallel never
+     * create storage.
+     *
+     * A system may also declare an UpdatePolicy: the scheduler then runs it at
+     * the policy's interval, and the system iterates its entities through
+     * getTimeSlicer() to stay within the policy's budget.
      */
     class System
     {
@@ -33,8 +51,101 @@ namespace Core
          */
         virtual void update(float deltaTime) = 0;
 
+        /**
+         * @brief Get the component types read by the system
+         * @return Component mask
+         */
+        const ComponentMask &getReadMask() const;
+
+        /**
+         * @brief Get the component types written by the system
+         * @return Component mask
+         */
+        const ComponentMask &getWriteMask() const;
+
+        /**
+         * @brief Check if the system must run alone
+         * @return true if the system cannot run concurrently with any other
+         */
+        bool isExclusive() const;
+
+        /**
+         * @brief Get the command buffer in which the system records structural changes
+         *
+         * Each system has its own buffer so that systems running in parallel
+         * never share one; the scheduler applies them at its sync point.
+         * @return Reference to the command buffer
+         */
+        CommandBuffer &getCommandBuffer();
+
+        /**
+         * @brief Get the time slicer spreading the system's entity updates over frames
+         * @return Reference to the time slicer
+         */
+        TimeSlicer &getTimeSlicer();
+
+        /**
+         * @brief Get the declared update policy
+         * @return Update policy
+         */
+        const UpdatePolicy &getUpdatePolicy() const;
+
     protected:
+        /**
+         * @brief Declare component types read by the system
+         * @tparam Types Component types
+         */
+        template <typename... Types>
+        void declareRead()
+        {
+            (m_readMask.set(getComponentTypeId<Types>()), ...);
+            (m_entityManager.getComponentPool<Types>(), ...);
+        }
+
+        /**
+         * @brief Declare component types written by the system
+         * @tparam Types Component types
+         */
+        template <typename... Types>
+        void declareWrite()
+        {
+            (m_writeMask.set(getComponentTypeId<Types>()), ...);
+            (m_entityManager.getComponentPool<Types>(), ...);
+        }
+
+        /**
+         * @brief Declare a view iterated by the system, creating it now
+         *
+         * Does not declare any access: the component types must also be
+         * declared read or written.
+         * @tparam Types Component types of the view
+         */
+        template <typename... Types>
+        void declareView()
+        {
+            m_entityManager.getView<Types...>();
+        }
+
+        /**
+         * @brief Set whether the system must run alone
+         * @param exclusive true to never run the system concurrently
+         */
+        void setExclusive(bool exclusive);
+
+        /**
+         * @brief Declare how often and how much the system updates
+         * @param policy Interval, time budget, entity limit and near radius
+         */
+        void declareUpdatePolicy(const UpdatePolicy &policy);
+
         EntityManager &m_entityManager;
+
+    private:
+        ComponentMask m_readMask;
+        ComponentMask m_writeMask;
+        bool m_exclusive;
+        std::unique_ptr<CommandBuffer> m_commandBuffer;
+        TimeSlicer m_timeSlicer;
     };
 
 } // namespace Core
\ No newline at end of file
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ComponentPool.hpp"
+
+namespace Core
+{
+
+    class EntityManager;
+    class JobSystem;
+    class JobCounter;
+    class System;
+
+    /**
+     * @brief Timing of one scheduled task during the last frame
+     */
+    struct TaskTiming
+    {
+        std::string name;
+        float startMs = 0.f;       // Start time relative to the frame start
+        float durationMs = 0.f;    // Execution time
+        bool onCriticalPath = false;
+    };
+
+    /**
+     * @brief Timings of the last frame run by a SystemScheduler
+     */
+    struct SchedulerFrameStats
+    {
+        float wallTimeMs = 0.f;     // Time from the first task start to the last task end
+        float criticalPathMs = 0.f; // Longest chain of dependent tasks
+        float totalWorkMs = 0.f;    // Sum of all task durations
+        std::vector<TaskTiming> tasks;
+    };
+
+    /**
+     * @brief Runs systems concurrently according to their declared component access
+     *
+     * Tasks are ordered by registration. A task depends on every earlier task
+     * it conflicts with: one writes a component type the other reads or
+     * writes, or one of them is exclusive. Independent tasks run at the same
+     * time on the JobSystem, then the command buffers of the systems are
+     * applied in registration order and the views compacted. Tasks that all
+     * touch a common component type therefore form a chain and gain nothing
+     * from the workers; getFrameStats() shows it as a critical path equal to
+     * the total work.
+     *
+     * Systems create their pools and views when they declare their access
+     * (see System::declareView()), so tasks running in parallel only look
+     * storage up.
+     */
+    class SystemScheduler
+    {
+    public:
+        using TaskFunction = std::function<void(float)>;
+
+        /**
+         * @brief Constructor
+         * @param entityManager Entity manager the systems work on
+         * @param jobSystem Job system running the tasks
+         */
+        SystemScheduler(EntityManager &entityManager, JobSystem &jobSystem);
+
+        /**
+         * @brief Destructor
+         */
+        ~SystemScheduler();
+
+        /**
+         * @brief Schedule a system using its declared component access
+         *
+         * The task runs at the interval of the system's update policy.
+         * @param name Name reported in the timings
+         * @param system System to update each frame
+         */
+        void addSystem(const std::string &name, System &system);
+
+        /**
+         * @brief Schedule an arbitrary update function
+         * @param name Name reported in the timings
+         * @param function Function called with the frame delta time
+         * @param readMask Component types read by the function
+         * @param writeMask Component types written by the function
+         * @param exclusive true if the function must run alone
+         */
+        void addTask(const std::string &name, TaskFunction function,
+                     const ComponentMask &readMask, const ComponentMask &writeMask,
+                     bool exclusive = false);
+
+        /**
+         * @brief Run a task less often than every frame
+         *
+         * The task then runs on the first frame where the time elapsed since
+         * its last run reaches the interval (to the nearest frame), and
+         * receives that elapsed time as its delta time.
+         * @param name Name of the task
+         * @param interval Minimum time between two runs in seconds, 0 to run every frame
+         * @return false if no task has this name
+         */
+        bool setTaskInterval(const std::string &name, float interval);
+
+        /**
+         * @brief Set the point around which the systems' time slicers always update entities
+         *
+         * Must not be called while run() executes.
+         * @param focus Position in world units, usually the camera center
+         */
+        void setFocus(const sf::Vector2f &focus);
+
+        /**
+         * @brief Remove every scheduled task
+         */
+        void clear();
+
+        /**
+         * @brief Run all tasks for one frame and wait for them to finish
+         * @param deltaTime Time since last frame in seconds
+         */
+        void run(float deltaTime);
+
+        /**
+         * @brief Enable or disable concurrent execution
+         * @param parallel false to run the tasks one after another on the calling thread
+         */
+        void setParallel(bool parallel);
+
+        /**
+         * @brief Check if tasks run concurrently
+         * @return true if parallel execution is enabled
+         */
+        bool isParallel() const;
+
+        /**
+         * @brief Get the timings of the last frame
+         * @return Frame statistics
+         */
+        const SchedulerFrameStats &getFrameStats() const;
+
+    private:
+        struct Task
+        {
+            std::string name;
+            const char *profileName; // Interned name of the profiler zone
+            TaskFunction function;
+            ComponentMask readMask;
+            ComponentMask writeMask;
+            bool exclusive;
+            System *system;
+            float interval;
+            float elapsed; // Time since the last run
+            std::vector<std::size_t> dependencies;
+            std::vector<std::size_t> dependents;
+        };
+
+        static bool conflicts(const Task &a, const Task &b);
+
+        void build();
+        void runSerial(float deltaTime);
+        void runParallel(float deltaTime);
+        void executeTask(std::size_t index, float deltaTime, JobCounter &counter);
+        void runTask(std::size_t index, float deltaTime);
+        void recordTimings();
+        void applyCommandBuffers();
+
+        EntityManager &m_entityManager;
+        JobSystem &m_jobSystem;
+        std::vector<Task> m_tasks;
+        bool m_dirty;
+        bool m_parallel;
+
+        // Per-frame state, indexed like m_tasks
+        std::unique_ptr<std::atomic<int>[]> m_remainingDependencies;
+        std::vector<double> m_taskStart;
+        std::vector<double> m_taskEnd;
+        double m_frameStart;
+
+        SchedulerFrameStats m_frameStats;
+    };
+
+} // namespace Core
\ No newline at end of file
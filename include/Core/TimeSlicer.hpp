@@ -0,0 +1,258 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "EntityHandle.hpp"
+
+namespace Core
+{
+
+    class Entity;
+
+    /**
+     * @brief How often and how much a system updates, declared by the system
+     */
+    struct UpdatePolicy
+    {
+        float interval = 0.f;         // Minimum time between two updates in seconds, 0 for every frame
+        float budgetMs = 0.f;         // Time an update may spend on its entities, 0 for no limit
+        std::size_t maxEntities = 0;  // Entities updated per frame, near ones excluded, 0 for no limit
+        float nearRadius = 0.f;       // Entities this close to the focus are updated every frame
+    };
+
+    /**
+     * @brief Spreads the updates of a system's entities over several frames
+     *
+     * Entities within the policy's near radius of the focus (usually the
+     * camera center) are updated every frame. The other entities are updated
+     * in turn by entity slot, resuming after the slot updated last, until
+     * the time budget or the entity limit of the frame is reached; at least one of
+     * them is updated each frame. Each entity receives the time elapsed since
+     * its own last update, so skipped frames are caught up.
+     *
+     * The near and far sets are kept from frame to frame, the far one sorted
+     * by slot. An entity is placed when it first appears, within the time
+     * budget, and checked again each time it is updated: a far entity that
+     * the focus reaches is moved to the near set on its next turn.
+     *
+     * Without a budget nor an entity limit, every entity is updated.
+     */
+    class TimeSlicer
+    {
+    public:
+        TimeSlicer();
+
+        /**
+         * @brief Set the update policy
+         *
+         * The entities are placed near or far again.
+         * @param policy Budget, entity limit and near radius
+         */
+        void setPolicy(const UpdatePolicy &policy);
+
+        /**
+         * @brief Get the update policy
+         * @return Current policy
+         */
+        const UpdatePolicy &getPolicy() const;
+
+        /**
+         * @brief Set the point around which entities are always updated
+         * @param focus Position in world units
+         */
+        void setFocus(const sf::Vector2f &focus);
+
+        /**
+         * @brief Update a rotating subset of entities
+         * @param entities Range of entity pointers, such as a View
+         * @param deltaTime Time since last frame in seconds
+         * @param func Callable taking (Entity &, float elapsedSeconds)
+         */
+        template <typename Range, typename Func>
+        void update(Range &&entities, float deltaTime, Func &&func);
+
+        /**
+         * @brief Get the number of entities updated by the last update
+         * @return Updated entity count
+         */
+        std::size_t getUpdatedCount() const;
+
+        /**
+         * @brief Get the number of entities left for later frames by the last update
+         * @return Deferred entity count
+         */
+        std::size_t getDeferredCount() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Placement : std::uint8_t
+        {
+            None,
+            Near,
+            Far
+        };
+
+        // Time owed to an entity slot and the set holding it, reset when the slot is recycled
+        struct EntityState
+        {
+            std::uint32_t generation = 0;
+            float elapsed = 0.f;
+            std::uint64_t frame = 0; // Last update whose range held the entity
+            Placement placement = Placement::None;
+        };
+
+        // Entity of the near or far set; the handle tells whether the pointer can still be used
+        struct Entry
+        {
+            Entity *entity;
+            EntityHandle handle;
+        };
+
+        bool isLimited() const;
+        bool isNear(Entity &entity) const;
+        EntityState &accumulate(const Entity &entity, float deltaTime);
+        bool isCurrent(const Entry &entry) const;
+        void place(const Entry &entry, Placement placement);
+        static Entry makeEntry(Entity &entity);
+        template <typename Func>
+        void updateEntry(const Entry &entry, Func &func);
+        bool isOverTime(Clock::time_point start, std::size_t count) const;
+        bool isOverBudget(Clock::time_point start, std::size_t farUpdated) const;
+
+        // Merge the entities gone far into the far set; returns the position of the first one at or after m_cursor
+        std::size_t mergeFarEntities();
+
+        UpdatePolicy m_policy;
+        sf::Vector2f m_focus;
+        std::vector<EntityState> m_states;   // Indexed by entity slot
+        std::vector<Entry> m_nearEntities;   // Updated every frame
+        std::vector<Entry> m_farEntities;    // Sorted by slot; entities gone near or removed leave a hole
+        std::vector<Entry> m_joiningFar;     // Gone far during this update, merged before the far turns
+        std::size_t m_farHoles;
+        std::uint64_t m_frame;
+        std::uint32_t m_cursor;              // Slot from which the far entities resume
+        std::size_t m_updatedCount;
+        std::size_t m_deferredCount;
+    };
+
+    template <typename Range, typename Func>
+    void TimeSlicer::update(Range &&entities, float deltaTime, Func &&func)
+    {
+        Clock::time_point start = Clock::now();
+        bool limited = isLimited();
+        m_updatedCount = 0;
+        m_deferredCount = 0;
+        ++m_frame;
+
+        // Every entity owes the time of this frame. New entities are placed
+        // while the budget allows; past it they wait far for their turn
+        std::size_t farCount = 0;
+        std::size_t placed = 0;
+        bool placing = true;
+        for (Entity *entity : entities)
+        {
+            EntityState &state = accumulate(*entity, deltaTime);
+            if (!limited)
+            {
+                func(*entity, state.elapsed);
+                state.elapsed = 0.f;
+                ++m_updatedCount;
+                continue;
+            }
+
+            if (state.placement == Placement::None)
+            {
+                placing = placing && !isOverTime(start, placed);
+                bool nearby = placing && isNear(*entity);
+                ++placed;
+                place(makeEntry(*entity), nearby ? Placement::Near : Placement::Far);
+            }
+            if (state.placement == Placement::Far)
+            {
+                ++farCount;
+            }
+        }
+        if (!limited)
+        {
+            return;
+        }
+
+        // Near entities are updated every frame, as long as they stay near
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < m_nearEntities.size(); ++i)
+        {
+            Entry entry = m_nearEntities[i];
+            if (!isCurrent(entry))
+            {
+                place(entry, Placement::None);
+            }
+            else if (!isNear(*entry.entity))
+            {
+                place(entry, Placement::Far);
+                ++farCount;
+            }
+            else
+            {
+                updateEntry(entry, func);
+                ++m_updatedCount;
+                m_nearEntities[kept++] = entry;
+            }
+        }
+        m_nearEntities.resize(kept);
+
+        // The others in turn, moving to the near set the ones the focus reached
+        std::size_t farUpdated = 0;
+        std::size_t position = mergeFarEntities();
+        std::size_t size = m_farEntities.size();
+        for (std::size_t visited = 0; visited < size && (farUpdated == 0 || !isOverBudget(start, farUpdated)); ++visited)
+        {
+            if (position == size)
+            {
+                position = 0;
+            }
+            Entry &entry = m_farEntities[position++];
+            if (!entry.entity)
+            {
+                continue;
+            }
+            if (!isCurrent(entry))
+            {
+                place(entry, Placement::None);
+                entry.entity = nullptr;
+                ++m_farHoles;
+                continue;
+            }
+
+            m_cursor = entry.handle.index + 1;
+            if (isNear(*entry.entity))
+            {
+                updateEntry(entry, func);
+                ++m_updatedCount;
+                place(entry, Placement::Near);
+                entry.entity = nullptr;
+                ++m_farHoles;
+                --farCount;
+                continue;
+            }
+
+            updateEntry(entry, func);
+            ++farUpdated;
+        }
+
+        m_updatedCount += farUpdated;
+        m_deferredCount = farCount - farUpdated;
+    }
+
+    template <typename Func>
+    void TimeSlicer::updateEntry(const Entry &entry, Func &func)
+    {
+        EntityState &state = m_states[entry.handle.index];
+        func(*entry.entity, state.elapsed);
+        state.elapsed = 0.f;
+    }
+
+} // namespace Core
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include "Component.hpp"
+#include "EntityHandle.hpp"
+
+namespace Core
+{
+
+    class SnapshotReader;
+    class SnapshotWriter;
+
+    /**
+     * @brief Position, rotation and scale of an entity, relative to its parent
+     *
+     * This is the single place where an entity's position lives: sprites,
+     * physics and the camera read it rather than keeping their own copy.
+     * The world transform is computed by the TransformSystem, which also
+     * manages the parent links (see TransformSystem::setParent()).
+     */
+    class TransformComponent : public Component
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param position Local position
+         * @param rotation Local rotation in degrees
+         * @param scale Local scale
+         */
+        TransformComponent(const sf::Vector2f &position = sf::Vector2f(0.f, 0.f), float rotation = 0.f,
+                           const sf::Vector2f &scale = sf::Vector2f(1.f, 1.f));
+
+        /**
+         * @brief Set the position relative to the parent
+         * @param position Local position
+         */
+        void setPosition(const sf::Vector2f &position);
+
+        /**
+         * @brief Get the position relative to the parent
+         * @return Local position
+         */
+        const sf::Vector2f &getPosition() const;
+
+        /**
+         * @brief Move relative to the current position
+         * @param offset Offset to add to the local position
+         */
+        void move(const sf::Vector2f &offset);
+
+        /**
+         * @brief Set the rotation relative to the parent
+         * @param rotation Local rotation in degrees
+         */
+        void setRotation(float rotation);
+
+        /**
+         * @brief Get the rotation relative to the parent
+         * @return Local rotation in degrees
+         */
+        float getRotation() const;
+
+        /**
+         * @brief Rotate relative to the current rotation
+         * @param angle Angle to add in degrees
+         */
+        void rotate(float angle);
+
+        /**
+         * @brief Set the scale relative to the parent
+         * @param scale Local scale
+         */
+        void setScale(const sf::Vector2f &scale);
+
+        /**
+         * @brief Get the scale relative to the parent
+         * @return Local scale
+         */
+        const sf::Vector2f &getScale() const;
+
+        /**
+         * @brief Compute the transform relative to the parent
+         * @return Local transform
+         */
+        sf::Transform getLocalTransform() const;
+
+        /**
+         * @brief Get the transform to world space, as of the last propagation
+         * @return World transform
+         */
+        const sf::Transform &getWorldTransform() const;
+
+        /**
+         * @brief Blend the world transforms of the last two propagations
+         *
+         * Used to render between two fixed simulation ticks. Position and
+         * scale are blended linearly and the rotation along the shortest arc,
+         * then the transform is rebuilt from them, so that a spinning body
+         * keeps its size. The world scale is the product of the scales up the
+         * hierarchy: the skew of a non-uniform scale under a rotated parent
+         * only shows at alpha 1.
+         * @param alpha 0 for the previous world transform, 1 for the current one
+         * @return Interpolated world transform
+         */
+        sf::Transform getInterpolatedTransform(float alpha) const;
+
+        /**
+         * @brief Get the position in world space, as of the last propagation
+         * @return World position
+         */
+        sf::Vector2f getWorldPosition() const;
+
+        /**
+         * @brief Get the rotation in world space, as of the last propagation
+         * @return World rotation in degrees
+         */
+        float getWorldRotation() const;
+
+        /**
+         * @brief Get the parent entity
+         * @return Parent handle, invalid for a root
+         */
+        EntityHandle getParent() const;
+
+        /**
+         * @brief Get the depth in the hierarchy
+         * @return 0 for a root, parent depth + 1 otherwise
+         */
+        std::uint32_t getDepth() const;
+
+        /**
+         * @brief Check if the local transform changed since the last propagation
+         * @return true if the world transform is out of date
+         */
+        bool isDirty() const;
+
+        /**
+         * @brief Save the local transform and the parent link to a snapshot
+         * @param writer Snapshot writer
+         */
+        void save(SnapshotWriter &writer) const;
+
+        /**
+         * @brief Restore the local transform and the parent link from a snapshot
+         * @param reader Snapshot reader
+         */
+        void load(SnapshotReader &reader);
+
+    private:
+        friend class TransformSystem;
+
+        static constexpr std::size_t NO_PARENT = static_cast<std::size_t>(-1);
+
+        sf::Vector2f m_position;
+        float m_rotation;
+        sf::Vector2f m_scale;
+
+        /**
+         * @brief Keep the current world state as the start of the interpolation
+         */
+        void keepPreviousWorld();
+
+        sf::Transform m_worldTransform;
+        float m_worldRotation;
+        sf::Vector2f m_worldScale;
+        bool m_hasWorldTransform; // false until the first propagation
+
+        // World state before the last propagation, blended by getInterpolatedTransform()
+        sf::Vector2f m_previousWorldPosition;
+        float m_previousWorldRotation;
+        sf::Vector2f m_previousWorldScale;
+
+        EntityHandle m_parent;
+        std::size_t m_parentIndex; // Dense index of the parent in the pool, NO_PARENT for a root
+        std::uint32_t m_depth;
+        bool m_dirty;
+        bool m_worldChanged; // World transform recomputed during the current propagation
+    };
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "System.hpp"
+
+namespace Core
+{
+
+    class Entity;
+
+    /**
+     * @brief Maintains the transform hierarchy and propagates world transforms
+     *
+     * The TransformComponent pool is kept sorted by depth, parents before
+     * children, so one linear pass over it computes every world transform.
+     * Only dirty components and the descendants of recomputed ones are
+     * touched. The pool is re-sorted only when the hierarchy changes: a
+     * parent link is set, a transform is removed, or a transform added with
+     * a parent link (e.g. loaded from a snapshot) appears.
+     */
+    class TransformSystem : public System
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param entityManager Reference to entity manager
+         */
+        TransformSystem(EntityManager &entityManager);
+
+        /**
+         * @brief Destructor
+         */
+        ~TransformSystem() override;
+
+        /**
+         * @brief Initialize the system
+         */
+        void init() override;
+
+        /**
+         * @brief Propagate the world transforms
+         * @param deltaTime Time since last frame in seconds
+         */
+        void update(float deltaTime) override;
+
+        /**
+         * @brief Attach an entity to a parent, or detach it
+         *
+         * The local transform is kept, so the entity moves with its new
+         * parent. Children of a destroyed parent become roots.
+         * @param child Entity to attach, must own a TransformComponent
+         * @param parent New parent owning a TransformComponent, or nullptr to make the child a root
+         * @return false if an entity lacks a transform or the link would create a cycle
+         */
+        bool setParent(Entity &child, Entity *parent);
+
+        /**
+         * @brief Recompute the world transforms that are out of date
+         */
+        void propagate();
+
+    private:
+        // Resolve parent links, compute depths and sort the pool by depth
+        void rebuildHierarchy();
+
+        bool m_hierarchyDirty;
+        std::uint32_t m_lastTick;
+        std::size_t m_knownCount; // Pool size after the last propagation
+    };
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <vector>
+#include "ComponentPool.hpp"
+
+namespace Core
+{
+
+    class Entity;
+    class EntityManager;
+
+    /**
+     * @brief Persistent set of the entities matching a component mask
+     *
+     * Views are owned by the EntityManager, which keeps them up to date as
+     * components are added and removed, so iterating one never scans the
+     * whole entity list nor allocates. Entities are visited in the order in
+     * which they started matching; removed entities leave holes that
+     * iteration skips, compacted by EntityManager::compactViews() at the
+     * sync point. Iterating never modifies the view, so several threads may
+     * iterate the same view at once.
+     */
+    class EntityView
+    {
+    public:
+        /**
+         * @brief Forward iterator over the active entities of a view
+         */
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Entity *;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Entity *const *;
+            using reference = Entity *;
+
+            Iterator(const std::vector<Entity *> &entities, std::size_t index);
+
+            Entity *operator*() const;
+            Iterator &operator++();
+            bool operator==(const Iterator &other) const;
+            bool operator!=(const Iterator &other) const;
+
+        private:
+            void skipInvalid();
+
+            const std::vector<Entity *> *m_entities;
+            std::size_t m_index;
+        };
+
+        /**
+         * @brief Constructor
+         * @param mask Component types an entity must own to match
+         */
+        explicit EntityView(const ComponentMask &mask);
+
+        /**
+         * @brief Get an iterator to the first active matching entity
+         * @return Iterator
+         */
+        Iterator begin() const;
+
+        /**
+         * @brief Get the past-the-end iterator
+         * @return Iterator
+         */
+        Iterator end() const;
+
+        /**
+         * @brief Get the number of matching entities, active or not
+         * @return Number of entities
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Check if the view has no matching entity
+         * @return true if empty
+         */
+        bool empty() const;
+
+        /**
+         * @brief Check if an entity currently matches the view
+         * @param entity Entity to test
+         * @return true if the entity is part of the view
+         */
+        bool contains(const Entity &entity) const;
+
+        /**
+         * @brief Get the component mask of the view
+         * @return Component mask
+         */
+        const ComponentMask &getMask() const;
+
+    private:
+        friend class EntityManager;
+
+        void onMaskChanged(Entity &entity, const ComponentMask &oldMask, const ComponentMask &newMask);
+        void insert(Entity &entity);
+        void erase(const Entity &entity);
+        void compact();
+
+        static constexpr std::uint32_t INVALID_POSITION = 0xFFFFFFFFu;
+
+        ComponentMask m_mask;
+        std::vector<Entity *> m_entities;
+        std::vector<std::uint32_t> m_positions;
+        std::size_t m_holes;
+    };
+
+    /**
+     * @brief Typed handle to a persistent view
+     *
+     * Cheap to copy; obtained from EntityManager::getView. Iteration yields
+     * entity pointers, each() also resolves the components.
+     * @tparam Types Component types required by the view
+     */
+    template <typename... Types>
+    class View
+    {
+    public:
+        View(EntityView &view, ComponentPool<Types> &...pools)
+            : m_view(&view), m_pools(&pools...)
+        {
+        }
+
+        EntityView::Iterator begin() { return m_view->begin(); }
+        EntityView::Iterator end() { return m_view->end(); }
+        std::size_t size() const { return m_view->size(); }
+        bool empty() const { return m_view->empty(); }
+
+        /**
+         * @brief Call a function for every active matching entity
+         * @param func Callable taking (Entity &, Types &...)
+         */
+        template <typename Func>
+        void each(Func &&func);
+
+        /**
+         * @brief Call a function for every matching entity with a component changed since a tick
+         * @param sinceTick Oldest tick to report, inclusive
+         * @param func Callable taking (Entity &, Types &...)
+         */
+        template <typename Func>
+        void eachChanged(std::uint32_t sinceTick, Func &&func);
+
+        /**
+         * @brief Call a function for every matching entity with a component added since a tick
+         * @param sinceTick Oldest tick to report, inclusive
+         * @param func Callable taking (Entity &, Types &...)
+         */
+        template <typename Func>
+        void eachAdded(std::uint32_t sinceTick, Func &&func);
+
+    private:
+        EntityView *m_view;
+        std::tuple<ComponentPool<Types> *...> m_pools;
+    };
+
+} // namespace Core
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <SFML/Audio.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 // Core includes
 #include "Core/EntityManager.hpp"
@@ -22,6 +23,8 @@ namespace Physics
 
 namespace Graphics
 {
+    class ProfilerOverlay;
+    class RenderSnapshot;
     class RenderSystem;
 }
 
@@ -40,11 +43,46 @@ namespace Resources
     class TiledMapLoader;
 }
 
+namespace Core
+{
+    class FramePacer;
+    class InputQueue;
+    class JobCounter;
+    class JobSystem;
+    class SceneManager;
+    class SystemScheduler;
+    class TransformSystem;
+}
+
 /**
  * @brief Main engine class that coordinates all systems and manages game loop
  */
 namespace Core
 {
+    /**
+     * @brief Time spent in one system over a headless run
+     */
+    struct SystemBenchmark
+    {
+        std::string name;
+        double totalMs = 0.0;
+        double averageMs = 0.0; // Per tick
+        double maxMs = 0.0;     // Slowest tick
+    };
+
+    /**
+     * @brief Throughput of a headless run
+     */
+    struct HeadlessRunStats
+    {
+        int ticks = 0;
+        double wallTimeMs = 0.0;
+        double ticksPerSecond = 0.0;
+        double averageTickMs = 0.0;
+        double maxTickMs = 0.0;
+        std::vector<SystemBenchmark> systems; // In scheduler order
+    };
+
     class Engine
     {
     public:
@@ -63,15 +101,36 @@ namespace Core
 
         /**
          * @brief Initialize the engine and all its systems
+         *
+         * In headless mode no window, GPU context or UI is created: only the
+         * simulation can run, through runHeadless().
+         * @param headless true to initialize without a window
          * @return true if initialization was successful
          */
-        bool initialize();
+        bool initialize(bool headless = false);
 
         /**
          * @brief Run the main game loop
          */
         void run();
 
+        /**
+         * @brief Step the simulation a fixed number of ticks as fast as possible
+         *
+         * Each tick is one update at the fixed timestep, without events,
+         * rendering or frame limiting. Meant for benchmarks and performance
+         * regression runs; works with or without a window.
+         * @param ticks Number of ticks to simulate
+         * @return Throughput and time spent per system
+         */
+        HeadlessRunStats runHeadless(int ticks);
+
+        /**
+         * @brief Check if the engine was initialized without a window
+         * @return true in headless mode
+         */
+        bool isHeadless() const;
+
         /**
          * @brief Shut down the engine and all systems
          */
@@ -90,11 +149,131 @@ namespace Core
         sf::RenderWindow &getWindow();
 
         /**
-         * @brief Set the current scene
+         * @brief Replace every scene by this one
+         *
+         * The scene is loaded in the background and shown on the first frame
+         * after its load; see getSceneManager() for the scene stack.
          * @param scene Shared pointer to the scene
          */
         void setScene(std::shared_ptr<Core::Scene> scene);
 
+        /**
+         * @brief Get the scene stack
+         * @return Reference to the scene manager
+         */
+        Core::SceneManager &getSceneManager();
+
+        /**
+         * @brief Set the simulation tick rate used in fixed-timestep mode
+         * @param ticksPerSecond Number of simulation updates per second
+         */
+        void setTickRate(float ticksPerSecond);
+
+        /**
+         * @brief Get the simulation tick rate
+         * @return Number of simulation updates per second
+         */
+        float getTickRate() const;
+
+        /**
+         * @brief Set the maximum number of simulation ticks run in one frame
+         *
+         * When the simulation falls further behind, the remaining time is
+         * dropped and the game slows down instead of spiralling.
+         * @param steps Maximum catch-up steps per frame
+         */
+        void setMaxCatchUpSteps(int steps);
+
+        /**
+         * @brief Enable or disable the fixed-timestep simulation
+         * @param enabled false to update once per frame with the measured delta time
+         */
+        void setFixedTimestepEnabled(bool enabled);
+
+        /**
+         * @brief Check if the simulation runs at a fixed timestep
+         * @return true if fixed-timestep mode is enabled
+         */
+        bool isFixedTimestepEnabled() const;
+
+        /**
+         * @brief Limit the rendering frame rate, independently of the tick rate
+         *
+         * The limit is also the frame budget of the quality scaling; when
+         * uncapped, the last limit (60 FPS by default) stays the budget.
+         * @param limit Maximum frames per second, 0 for uncapped
+         */
+        void setFramerateLimit(unsigned int limit);
+
+        /**
+         * @brief Enable or disable vertical synchronization of the rendering
+         * @param enabled true to synchronize with the display
+         */
+        void setVerticalSyncEnabled(bool enabled);
+
+        /**
+         * @brief Enable or disable pipelined frames
+         *
+         * When enabled, the next frame is simulated on the job system while
+         * the current one, captured into a render snapshot, is drawn and
+         * presented. Rendering then shows the state one frame behind the
+         * simulation. The UI is updated and drawn on the main thread during
+         * the simulation: scenes must only change widgets from their event
+         * handlers or capture().
+         * Scenes that do not support snapshots fall back to serial frames.
+         * @param enabled true to overlap simulation and rendering
+         */
+        void setPipelineEnabled(bool enabled);
+
+        /**
+         * @brief Check if simulation and rendering overlap
+         * @return true if pipelined frames are enabled
+         */
+        bool isPipelineEnabled() const;
+
+        /**
+         * @brief Show or hide the frame-time overlay
+         *
+         * Frame times are only recorded in builds with profiling enabled
+         * (ORENJI_ENABLE_PROFILING); otherwise the overlay is never drawn.
+         * @param font Font of the overlay, must outlive it; nullptr to hide it
+         */
+        void setProfilerOverlay(const sf::Font *font);
+
+        /**
+         * @brief Get the frame pacer, which limits the frame rate and scales quality to fit it
+         *
+         * The engine registers the physics substeps, the AI update interval
+         * and the culling margin as quality knobs; games add their own, such
+         * as ParticleSystem::setEmissionScale().
+         * @return Reference to the frame pacer
+         */
+        Core::FramePacer &getFramePacer();
+
+        /**
+         * @brief Get the job system
+         * @return Reference to the job system
+         */
+        Core::JobSystem &getJobSystem();
+
+        /**
+         * @brief Get the scheduler running the systems each frame
+         * @return Reference to the system scheduler
+         */
+        Core::SystemScheduler &getScheduler();
+
+        /**
+         * @brief Get the transform system, which manages the entity hierarchy
+         * @return Reference to the transform system
+         */
+        Core::TransformSystem &getTransformSystem();
+
+        /**
+         * @brief Get the queue of timestamped input events, which also measures input latency
+         * @return Reference to the input queue
+         */
+        Core::InputQueue &getInputQueue();
+
     private:
         std::string m_title;
         int m_width;
@@ -103,10 +282,18 @@ namespace Core
 
         // Core systems
         std::unique_ptr<Core::EntityManager> m_entityManager;
-        std::shared_ptr<Core::Scene> m_currentScene;
+        std::unique_ptr<Core::SceneManager> m_sceneManager;
+        std::unique_ptr<Core::JobSystem> m_jobSystem;
+        std::unique_ptr<Core::SystemScheduler> m_scheduler;
+        std::unique_ptr<Core::InputQueue> m_inputQueue;
+        std::unique_ptr<Core::FramePacer> m_framePacer;
+        std::unique_ptr<Core::JobCounter> m_simulationCounter; // Simulation running during the pipelined render
+        std::unique_ptr<Graphics::RenderSnapshot> m_renderSnapshot;
+        std::unique_ptr<Graphics::ProfilerOverlay> m_profilerOverlay;
 
         // Subsystems
         std::unique_ptr<Physics::PhysicsSystem> m_physicsSystem;
+        std::unique_ptr<Core::TransformSystem> m_transformSystem;
         std::unique_ptr<Graphics::RenderSystem> m_renderSystem;
         std::unique_ptr<AI::AISystem> m_aiSystem;
         std::unique_ptr<UI::UIManager> m_uiManager;
@@ -118,21 +305,76 @@ namespace Core
         // Timing variables
         sf::Clock m_clock;
         float m_deltaTime;
+        float m_fixedTimeStep;
+        float m_accumulator;
+        int m_maxCatchUpSteps;
+        bool m_fixedTimestepEnabled;
+        bool m_pipelineEnabled;
+        bool m_headless;
+        float m_interpolation; // Fraction of a tick elapsed since the last simulation update
 
         /**
-         * @brief Process all input events
+         * @brief Drain all pending window events into the input queue
          */
         void processEvents();
 
+        /**
+         * @brief Pass the queued input events to the UI and the current scene
+         */
+        void dispatchInput();
+
+        /**
+         * @brief Advance the simulation by the time of one frame, in fixed ticks if enabled
+         * @param frameTime Time since last frame in seconds
+         */
+        void simulate(float frameTime);
+
         /**
          * @brief Update all systems
          * @param deltaTime Time since last frame in seconds
          */
         void update(float deltaTime);
 
+        /**
+         * @brief Render the last simulated state while the next one is simulated
+         */
+        void runPipelinedFrame();
+
+        /**
+         * @brief Drop the component removals every consumer has seen, at a frame boundary
+         */
+        void pruneRemovals();
+
+        /**
+         * @brief Wait for the simulation started by the last pipelined frame
+         */
+        void waitForSimulation();
+
+        /**
+         * @brief Draw the frame-time overlay on top of the frame, if shown
+         * @param drawCalls Draw calls issued for the frame's sprites and drawables
+         */
+        void drawProfilerOverlay(std::size_t drawCalls);
+
+        /**
+         * @brief Register the engine's own quality knobs with the frame pacer
+         */
+        void addQualityKnobs();
+
+        /**
+         * @brief Center the systems' time slicing on the camera, before simulating
+         */
+        void updateFocus();
+
+        /**
+         * @brief Present the frame, timed by the frame pacer
+         */
+        void present();
+
         /**
          * @brief Render the current frame
+         * @param interpolation Fraction of a tick elapsed since the last simulation update, in [0, 1]
          */
-        void render();
+        void render(float interpolation = 1.f);
     };
 } // namespace Core
\ No newline at end of file
@@ -17,12 +17,16 @@ namespace Gameplay
     {
     public:
         /**
-         * @brief Constructor
+         * @brief Constructor, called by Core::EntityManager::createEntity<Enemy>()
          * @param manager EntityManager that owns this entity
+         * @param handle Handle of the entity
+         * @param physics Physics world holding the enemy's body
          * @param behaviorTreePath Path to the behavior tree XML file
          * @param position Initial position for the enemy
          */
         Enemy(Core::EntityManager &manager,
+              Core::EntityHandle handle,
+              Physics::Box2DWrapper &physics,
               const std::string &behaviorTreePath,
               const sf::Vector2f &position = sf::Vector2f(0.0f, 0.0f));
 
@@ -92,14 +96,15 @@ namespace Gameplay
         bool isAlive() const;
 
     protected:
+        Physics::Box2DWrapper &m_physics;
+        sf::Vector2f m_spawnPosition;
         float m_movementSpeed;
         float m_maxHealth;
         float m_health;
         std::string m_behaviorTreePath;
         bool m_isFacingRight;
 
-        Physics::PhysicsComponent *m_physicsComponent;
-        Graphics::Components::SpriteComponent *m_spriteComponent;
-        AI::Components::AIComponent *m_aiComponent;
+        // Components are looked up at each use: their pools move them when
+        // another entity loses one or when the pool is sorted
     };
 } // namespace Gameplay
\ No newline at end of file
@@ -67,18 +67,18 @@ namespace Gameplay
         sf::Vector2f tileToPixelCoords(const sf::Vector2i &tileCoords) const;
 
         /**
-         * @brief Obtenir tous les objets d'un type spécifique
+         * @brief Obtenir tous les objets d'un type spécifique, sans les copier
          * @param type Type des objets à récupérer
-         * @return Vecteur d'objets du type spécifié
+         * @param result Reçoit des pointeurs vers les objets, valides jusqu'au prochain chargement
          */
-        std::vector<Resources::MapObject> getObjectsByType(const std::string &type) const;
+        void getObjectsByType(const std::string &type, Core::FrameVector<const Resources::MapObject *> &result) const;
 
         /**
-         * @brief Obtenir tous les objets avec un nom spécifique
+         * @brief Obtenir tous les objets avec un nom spécifique, sans les copier
          * @param name Nom des objets à récupérer
-         * @return Vecteur d'objets avec le nom spécifié
+         * @param result Reçoit des pointeurs vers les objets, valides jusqu'au prochain chargement
          */
-        std::vector<Resources::MapObject> getObjectsByName(const std::string &name) const;
+        void getObjectsByName(const std::string &name, Core::FrameVector<const Resources::MapObject *> &result) const;
 
         /**
          * @brief Obtenir le système de collision de la carte
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Core/Entity.hpp"
+#include "../Core/TransformComponent.hpp"
 #include "../Physics/PhysicsComponent.hpp"
 #include "../Graphics/Components/SpriteComponent.hpp"
 #include <SFML/Graphics.hpp>
@@ -16,11 +17,14 @@ namespace Gameplay
     {
     public:
         /**
-         * @brief Constructor
+         * @brief Constructor, called by Core::EntityManager::createEntity<Player>()
          * @param manager EntityManager that owns this entity
+         * @param handle Handle of the entity
+         * @param physics Physics world holding the player's body
          * @param position Initial position for the player
          */
-        Player(Core::EntityManager &manager, const sf::Vector2f &position = sf::Vector2f(0.0f, 0.0f));
+        Player(Core::EntityManager &manager, Core::EntityHandle handle, Physics::Box2DWrapper &physics,
+               const sf::Vector2f &position = sf::Vector2f(0.0f, 0.0f));
 
         /**
          * @brief Destructor
@@ -75,11 +79,14 @@ namespace Gameplay
         bool isGrounded() const;
 
     private:
+        Physics::Box2DWrapper &m_physics;
+        sf::Vector2f m_spawnPosition;
         float m_movementSpeed;
         float m_jumpForce;
         bool m_isGrounded;
         bool m_isFacingRight;
-        Physics::PhysicsComponent *m_physicsComponent;
-        Graphics::Components::SpriteComponent *m_spriteComponent;
+
+        // Components are looked up at each use: their pools move them when
+        // another entity loses one or when the pool is sorted
     };
 } // namespace Gameplay
\ No newline at end of file
@@ -40,6 +40,10 @@ namespace Graphics
 
             /**
              * @brief Get the sprite
+             *
+             * After changing the sprite's size or transform through this
+             * reference, call the owner's markChanged<SpriteComponent>() so
+             * that the RenderSystem culls it at its new bounds.
              * @return Reference to the sprite
              */
             sf::Sprite &getSprite();
@@ -88,6 +92,11 @@ namespace Graphics
             bool isVisible() const;
 
         private:
+            /**
+             * @brief Stamp the component as changed, for the RenderSystem to update its bounds
+             */
+            void markBoundsChanged();
+
             sf::Sprite m_sprite;
             int m_layer;
             bool m_visible;
@@ -8,6 +8,16 @@
 #include <string>
 #include <unordered_map>
 
+namespace Core
+{
+    class JobSystem;
+}
+
+namespace Graphics
+{
+    class RenderQueue;
+}
+
 namespace Orenji
 {
     namespace Graphics
@@ -87,6 +97,15 @@ namespace Orenji
              */
             void setEmissionRate(float particlesPerSecond);
 
+            /**
+             * @brief Scale the continuous emission down, e.g. from a frame pacer quality knob
+             *
+             * The emission rate and the number of live particles the emitter
+             * adds to are both multiplied by the scale; bursts from emit() are not.
+             * @param scale Factor in [0, 1], 1 for the configured emission
+             */
+            void setEmissionScale(float scale);
+
             /**
              * @brief Set the emitter position
              * @param position Position of the emitter
@@ -210,6 +229,16 @@ namespace Orenji
              */
             void update(float deltaTime);
 
+            /**
+             * @brief Spread the particle updates over a job system
+             *
+             * The behavior function is then called from several threads at
+             * once and must only modify the particle it is given, like the
+             * predefined effects.
+             * @param jobSystem Job system to use, nullptr to update on the calling thread
+             */
+            void setJobSystem(Core::JobSystem *jobSystem);
+
             /**
              * @brief Set a custom behavior function
              * @param behavior Function that modifies particle behavior
@@ -253,6 +282,13 @@ namespace Orenji
              */
             void setCircularEmitter(bool circular);
 
+            /**
+             * @brief Add the active particles to a render queue, as draw() would draw them
+             * @param queue Render queue of the frame
+             * @param layer Drawing layer
+             */
+            void enqueue(::Graphics::RenderQueue &queue, int layer = 0) const;
+
             // Predefined particle behaviors
             static void fireEffect(Particle &particle, float deltaTime);
             static void smokeEffect(Particle &particle, float deltaTime);
@@ -286,10 +322,21 @@ namespace Orenji
              */
             int findInactiveParticle() const;
 
+            /**
+             * @brief Update a range of particles and their vertices
+             * @param begin Index of the first particle
+             * @param end Index past the last particle
+             * @param deltaTime Time since last frame in seconds
+             * @return Number of particles of the range still active
+             */
+            size_t updateParticles(size_t begin, size_t end, float deltaTime);
+
             /**
              * @brief Update the vertex array with current particle data
+             * @param begin Index of the first particle
+             * @param end Index past the last particle
              */
-            void updateVertices();
+            void updateVertices(size_t begin, size_t end);
 
             /**
              * @brief Apply blending mode based on effect type
@@ -335,6 +382,7 @@ namespace Orenji
             float m_emitterRadius;
             bool m_useCircularEmitter;
             float m_emissionRate;
+            float m_emissionScale;
             float m_emissionAccumulator;
 
             // Forces
@@ -362,6 +410,7 @@ namespace Orenji
             // System state
             bool m_emitterEnabled;
             size_t m_activeParticleCount;
+            Core::JobSystem *m_jobSystem;
         };
 
     } // namespace Graphics
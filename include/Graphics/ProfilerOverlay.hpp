@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "../Core/Profiler.hpp"
+
+namespace Graphics
+{
+
+    /**
+     * @brief On-screen display of the profiler's rolling frame-time percentiles
+     *
+     * Shows the percentiles as text above a graph of the recent frame times,
+     * with a line at the 60 FPS budget. Drawn in screen coordinates: draw it
+     * with the target's default view.
+     */
+    class ProfilerOverlay : public sf::Drawable
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param font Font of the text, must outlive the overlay
+         */
+        explicit ProfilerOverlay(const sf::Font &font);
+
+        /**
+         * @brief Rebuild the overlay from the latest profiler data
+         * @param stats Frame-time percentiles
+         * @param frameTimes Recent frame times in milliseconds, oldest first
+         */
+        void update(const Core::FrameTimeStats &stats, const std::vector<float> &frameTimes);
+
+        /**
+         * @brief Set an extra line shown under the percentiles, e.g. the frame pacer's state
+         * @param status Text of the line, empty to hide it
+         */
+        void setStatus(const std::string &status);
+
+        /**
+         * @brief Set the top-left corner of the overlay
+         * @param position Position in pixels
+         */
+        void setPosition(const sf::Vector2f &position);
+
+    private:
+        void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
+
+        sf::Vector2f m_position;
+        sf::RectangleShape m_background;
+        sf::Text m_text;
+        sf::VertexArray m_graph;
+        std::string m_status;
+    };
+
+} // namespace Graphics
\ No newline at end of file
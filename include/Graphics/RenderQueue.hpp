@@ -0,0 +1,205 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Graphics
+{
+
+    /**
+     * @brief Collects the draw items of a frame and submits them sorted, with as few draw calls as possible
+     *
+     * Every item gets a 64-bit sort key when added:
+     *
+     *     layer (16) | blend mode (4) | shader (8) | texture (16) | depth (20)
+     *
+     * The blend mode, shader and texture fields hold small per-frame
+     * identifiers, given in order of first appearance; the depth is the
+     * item's bottom y, scaled to the range set with setDepthRange(). On
+     * draw(), the keys are sorted with a stable radix sort, so equal keys
+     * keep their order of addition.
+     *
+     * How the items of a layer are ordered depends on its LayerOrder:
+     * - Batched (default): by state, so that the items sharing a texture,
+     *   blend mode and shader are drawn together;
+     * - DepthSorted: by depth first (top-down scenes, where lower items hide
+     *   the ones behind them), then by state:
+     *
+     *       layer (16) | depth (20) | blend mode (4) | shader (8) | texture (16)
+     *
+     * - Submission: in order of addition, for overlays and UI.
+     *
+     * Sprites and triangles are transformed on the CPU and written into one
+     * streamed vertex buffer; consecutive items with the same texture,
+     * blend mode and shader take a single draw call. Other drawables are
+     * drawn on their own, in their place in the order. Without vertex
+     * buffer support, the vertices are drawn from client memory.
+     */
+    class RenderQueue
+    {
+    public:
+        /**
+         * @brief How the items of one layer are ordered
+         */
+        enum class LayerOrder
+        {
+            Batched,
+            DepthSorted,
+            Submission
+        };
+
+        RenderQueue();
+
+        /**
+         * @brief Remove the items of the previous frame, keeping the storage and the layer orders
+         */
+        void clear();
+
+        /**
+         * @brief Set the world y range mapped to the depth field of the keys
+         *
+         * Depths are clamped to the range; usually the top and bottom of the
+         * view.
+         * @param top Smallest depth
+         * @param bottom Largest depth
+         */
+        void setDepthRange(float top, float bottom);
+
+        /**
+         * @brief Set how the items of a layer are ordered
+         * @param layer Drawing layer
+         * @param order Order of the layer's items
+         */
+        void setLayerOrder(int layer, LayerOrder order);
+
+        /**
+         * @brief Get how the items of a layer are ordered
+         * @param layer Drawing layer
+         * @return Order of the layer's items
+         */
+        LayerOrder getLayerOrder(int layer) const;
+
+        /**
+         * @brief Add a sprite
+         * @param sprite Sprite, whose geometry, texture rect and color are copied
+         * @param transform World transform applied on top of the sprite's own transform
+         * @param layer Drawing layer, higher layers are drawn on top
+         * @param blendMode Blend mode of the sprite
+         * @param shader Shader of the sprite, nullptr for none; must outlive the draw
+         */
+        void addSprite(const sf::Sprite &sprite, const sf::Transform &transform, int layer = 0,
+                       const sf::BlendMode &blendMode = sf::BlendAlpha, const sf::Shader *shader = nullptr);
+
+        /**
+         * @brief Add a list of triangles
+         * @param vertices Vertices, copied, three per triangle
+         * @param count Number of vertices
+         * @param states Transform applied to the vertices, texture, blend mode and shader
+         * @param layer Drawing layer, higher layers are drawn on top
+         * @param depth Depth of the item, usually its bottom y in world units
+         */
+        void addTriangles(const sf::Vertex *vertices, std::size_t count, const sf::RenderStates &states,
+                          int layer = 0, float depth = 0.f);
+
+        /**
+         * @brief Add a drawable, drawn with its own draw call(s)
+         * @param drawable Drawable, owned by the queue until the next clear()
+         * @param states Render states to draw it with
+         * @param layer Drawing layer, higher layers are drawn on top
+         * @param depth Depth of the item, usually its bottom y in world units
+         */
+        void addDrawable(std::unique_ptr<sf::Drawable> drawable, const sf::RenderStates &states,
+                         int layer = 0, float depth = 0.f);
+
+        /**
+         * @brief Add a drawable owned elsewhere, such as a prebuilt vertex buffer
+         * @param drawable Drawable, which must outlive the draw
+         * @param states Render states to draw it with
+         * @param layer Drawing layer, higher layers are drawn on top
+         * @param depth Depth of the item, usually its bottom y in world units
+         */
+        void addDrawable(const sf::Drawable &drawable, const sf::RenderStates &states,
+                         int layer = 0, float depth = 0.f);
+
+        /**
+         * @brief Draw every item added since the last clear()
+         * @param target Render target
+         * @param states Render states whose transform applies to every item; texture, blend mode and shader come from the items
+         */
+        void draw(sf::RenderTarget &target, sf::RenderStates states = sf::RenderStates::Default);
+
+        /**
+         * @brief Get the number of items added since the last clear()
+         * @return Item count
+         */
+        std::size_t getItemCount() const;
+
+        /**
+         * @brief Get the number of draw calls issued by the last draw()
+         * @return Draw call count
+         */
+        std::size_t getDrawCallCount() const;
+
+    private:
+        static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+        struct Item
+        {
+            const sf::Texture *texture;
+            const sf::Shader *shader;
+            sf::BlendMode blendMode;
+            std::uint32_t first;    // First vertex in m_vertices, or index in m_drawables
+            std::uint32_t count;    // Vertex count, 0 for drawables
+        };
+
+        struct DrawableItem
+        {
+            const sf::Drawable *drawable;
+            std::unique_ptr<sf::Drawable> owned; // Null when owned elsewhere
+            sf::RenderStates states;
+        };
+
+        struct SortEntry
+        {
+            std::uint64_t key;
+            std::uint32_t item; // Index in m_items
+        };
+
+        void push(const Item &item, int layer, float depth);
+        std::uint64_t makeKey(const Item &item, int layer, float depth);
+        std::uint32_t getTextureId(const sf::Texture *texture);
+        std::uint32_t getShaderId(const sf::Shader *shader);
+        std::uint32_t getBlendModeId(const sf::BlendMode &blendMode);
+        void sortKeys();
+        bool upload();
+
+        static bool isSameRun(const Item &a, const Item &b);
+
+        float m_depthTop;
+        float m_depthScale; // Depth units per world unit
+        std::unordered_map<int, LayerOrder> m_layerOrders; // Layers not Batched
+
+        std::vector<Item> m_items;
+        std::vector<SortEntry> m_entries;
+        std::vector<SortEntry> m_sortBuffer; // Radix sort ping-pong buffer
+        std::vector<sf::Vertex> m_vertices;       // In order of addition
+        std::vector<sf::Vertex> m_sortedVertices; // In drawing order
+        std::vector<DrawableItem> m_drawables;
+
+        // Per-frame state identifiers, with the last lookup cached since
+        // consecutive items usually share their state
+        std::unordered_map<const sf::Texture *, std::uint32_t> m_textureIds;
+        std::vector<const sf::Shader *> m_shaders;
+        std::vector<sf::BlendMode> m_blendModes;
+        const sf::Texture *m_lastTexture;
+        std::uint32_t m_lastTextureId;
+
+        sf::VertexBuffer m_vertexBuffer;
+        std::size_t m_drawCallCount;
+    };
+
+} // namespace Graphics
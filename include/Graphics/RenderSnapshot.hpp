@@ -0,0 +1,109 @@
+#pragma once
+
+#include "RenderQueue.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace Graphics
+{
+
+    /**
+     * @brief Self-contained description of one frame, drawn after the simulation moved on
+     *
+     * Everything needed to draw the frame is copied in: the view, the sprite
+     * instances collected by the RenderSystem and the extra items a scene
+     * adds (tiles, particles, texts...). Only resources such as textures and
+     * fonts are referenced. Once built, a snapshot can be drawn while the
+     * next frame is being simulated.
+     *
+     * Everything goes through one RenderQueue, sorted by layer then grouped
+     * by state. Drawables added with draw() default to OVERLAY_LAYER, drawn
+     * last and in the order they were added.
+     */
+    class RenderSnapshot
+    {
+    public:
+        /**
+         * @brief Layer of the drawables added without one, drawn in order of addition
+         */
+        static constexpr int OVERLAY_LAYER = 32767;
+
+        RenderSnapshot();
+
+        /**
+         * @brief Remove the content of the previous frame, keeping the storage
+         */
+        void clear();
+
+        /**
+         * @brief Set the view the frame is drawn with
+         *
+         * Also maps the view's height to the depth of the queue's keys.
+         * @param view View, copied
+         */
+        void setView(const sf::View &view);
+
+        /**
+         * @brief Get the view the frame is drawn with
+         * @return View
+         */
+        const sf::View &getView() const;
+
+        /**
+         * @brief Add a sprite instance
+         * @param sprite Sprite, whose geometry, texture rect and color are copied
+         * @param transform World transform applied on top of the sprite's own transform
+         * @param layer Drawing layer, higher layers are drawn on top
+         */
+        void addSprite(const sf::Sprite &sprite, const sf::Transform &transform, int layer = 0);
+
+        /**
+         * @brief Get the number of sprite instances
+         * @return Sprite count
+         */
+        std::size_t getSpriteCount() const;
+
+        /**
+         * @brief Add a copy of a drawable
+         *
+         * Mirrors sf::RenderTarget::draw(), so that a scene can draw the
+         * same objects to the window or to a snapshot.
+         * @tparam T Copyable drawable type
+         * @param drawable Drawable to copy
+         * @param states Render states to draw it with
+         * @param layer Drawing layer, on top of the sprites by default
+         */
+        template <typename T>
+        void draw(const T &drawable, const sf::RenderStates &states = sf::RenderStates::Default, int layer = OVERLAY_LAYER)
+        {
+            static_assert(std::is_base_of<sf::Drawable, T>::value, "Only drawables can be added to a snapshot");
+            m_queue.addDrawable(std::make_unique<T>(drawable), states, layer);
+        }
+
+        /**
+         * @brief Get the queue the frame is drawn from, to add items directly
+         * @return Render queue
+         */
+        RenderQueue &getQueue();
+
+        /**
+         * @brief Draw the frame
+         * @param target Render target, whose view is replaced by the snapshot's
+         */
+        void render(sf::RenderTarget &target);
+
+        /**
+         * @brief Get the number of draw calls issued by the last render()
+         * @return Draw call count
+         */
+        std::size_t getDrawCallCount() const;
+
+    private:
+        sf::View m_view;
+        RenderQueue m_queue;
+        std::size_t m_spriteCount;
+    };
+
+} // namespace Graphics
\ No newline at end of file
@@ -1,11 +1,35 @@
 #pragma once
 
+#include "../Core/EntityHandle.hpp"
+#include "../Core/LooseQuadTree.hpp"
 #include "../Core/System.hpp"
+#include "RenderSnapshot.hpp"
 #include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Core
+{
+    class Entity;
+}
 
 namespace Graphics
 {
 
+    namespace Components
+    {
+        class SpriteComponent;
+    }
+
+    /**
+     * @brief Draws the sprite entities visible through the window's view
+     *
+     * Sprites are kept in a spatial index, updated only for the entities
+     * whose sprite or transform changed (see Core::Entity::markChanged()),
+     * so that finding the visible sprites costs with what is on screen
+     * rather than with the size of the world.
+     */
     class RenderSystem : public Core::System
     {
     public:
@@ -17,11 +41,64 @@ namespace Graphics
 
         /**
          * @brief Render all drawable entities
+         * @param interpolation Blend factor between the previous and current transforms, in [0, 1]
+         */
+        void render(float interpolation = 1.f);
+
+        /**
+         * @brief Collect the visible sprites into a snapshot, with the window's current view
+         *
+         * Reads the entities, so it must not run while they are being updated.
+         * @param snapshot Snapshot to fill, not cleared
+         * @param interpolation Blend factor between the previous and current transforms, in [0, 1]
+         */
+        void capture(RenderSnapshot &snapshot, float interpolation = 1.f);
+
+        /**
+         * @brief Get the number of draw calls issued by the last render()
+         * @return Draw call count
+         */
+        std::size_t getDrawCallCount() const;
+
+        /**
+         * @brief Set how far around the view sprites are still drawn
+         *
+         * A margin keeps sprites entering the view from popping in; a
+         * smaller one draws fewer sprites.
+         * @param margin Distance added to each side of the view, in world units
          */
-        void render();
+        void setCullingMargin(float margin);
+
+        /**
+         * @brief Get how far around the view sprites are still drawn
+         * @return Culling margin in world units
+         */
+        float getCullingMargin() const;
 
     private:
+        /**
+         * @brief Bring the spatial index up to date with the sprites changed since the last capture
+         */
+        void updateSpatialIndex();
+
+        /**
+         * @brief Index or re-index a sprite entity
+         */
+        void indexSprite(Core::Entity &entity, Components::SpriteComponent &sprite);
+
+        /**
+         * @brief Remove an entity slot from the spatial index
+         */
+        void unindexSprite(std::uint32_t slot);
+
         sf::RenderWindow &m_window;
+        float m_cullingMargin;
+        RenderSnapshot m_snapshot; // Reused by render()
+
+        Core::LooseQuadTree m_spatialIndex;           // Sprite bounds, by entity slot
+        std::vector<Core::EntityId> m_indexedEntities; // Entity indexed in each slot
+        std::vector<std::uint32_t> m_staleSlots;       // Slots found stale by the last query
+        std::uint32_t m_lastTick;                      // Tick of the last index update, for the removals
     };
 
 } // namespace Graphics
\ No newline at end of file
@@ -49,6 +49,21 @@ namespace Physics
          */
         void step(float timeStep, int velocityIterations = 6, int positionIterations = 2);
 
+        /**
+         * @brief Définir le nombre de sous-pas de chaque pas de simulation
+         *
+         * Box2D 3 remplace les itérations de vitesse et de position par des
+         * sous-pas ; 4 est la valeur recommandée.
+         * @param subStepCount Nombre de sous-pas, au moins 1
+         */
+        void setSubStepCount(int subStepCount);
+
+        /**
+         * @brief Obtenir le nombre de sous-pas de chaque pas de simulation
+         * @return Nombre de sous-pas
+         */
+        int getSubStepCount() const;
+
         /**
          * @brief Créer un corps statique
          * @param position Position en pixels
@@ -193,6 +208,7 @@ namespace Physics
     private:
         b2WorldId m_worldId;
         bool m_debugDrawEnabled;
+        int m_subStepCount;
     };
 
     // Opérateur OR pour les catégories de collision
@@ -78,6 +78,14 @@ namespace Physics
         void debugDraw(sf::RenderTarget &target, sf::RenderStates states = sf::RenderStates::Default);
 
     private:
+        /**
+         * @brief Recopier la position et l'angle des corps dans les TransformComponent
+         *
+         * Les corps physiques doivent appartenir à des entités racines : la
+         * position du corps devient la position locale de la transformation.
+         */
+        void syncTransforms();
+
         std::unique_ptr<Box2DWrapper> m_physics;
         int m_velocityIterations;
         int m_positionIterations;
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "TextureAtlas.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 #include <functional>
@@ -23,6 +25,9 @@ namespace Resources
 
     /**
      * @brief Structure representing sprite sheet information
+     *
+     * The frames are relative to the texture, which is an atlas page when
+     * the sprite sheet was created from an atlas texture.
      */
     struct SpriteSheet
     {
@@ -33,6 +38,12 @@ namespace Resources
 
     /**
      * @brief Manager class for all resources (textures, fonts, sounds, etc.)
+     *
+     * Thread safe, so that scenes can load their resources in Scene::load()
+     * while the main thread looks others up: files are read without the
+     * lock, which is only held to look up and store resources. References
+     * stay valid until the resource is removed. The TextureAtlas returned
+     * by getTextureAtlas() is not guarded.
      */
     class ResourceManager
     {
@@ -80,17 +91,62 @@ namespace Resources
                                  bool smooth = false, bool repeated = false);
 
         /**
-         * @brief Get a texture by ID
+         * @brief Get a texture loaded with loadTexture() by ID
+         *
+         * Textures packed in the atlas only cover part of a page: get them
+         * with getTextureRegion() or createSprite().
          * @param id Resource identifier
          * @return Reference to the texture
          * @throws std::out_of_range if the texture does not exist
+         * @throws std::invalid_argument if the texture is packed in the atlas
          */
         sf::Texture &getTexture(const std::string &id);
 
+        /**
+         * @brief Queue a texture to be packed into the texture atlas by the next buildTextureAtlas()
+         *
+         * Textures sharing an atlas page are drawn in the same batch. Repeated
+         * textures cannot be packed and must be loaded with loadTexture().
+         * @param id Resource identifier
+         * @param filePath Path to the texture file (relative to textures path)
+         */
+        void addAtlasTexture(const std::string &id, const std::string &filePath);
+
+        /**
+         * @brief Pack the textures queued with addAtlasTexture()
+         * @param cacheDirectory Directory where the packed pages are cached between runs, empty for no cache
+         * @throws ResourceLoadException if some textures could not be loaded; the others are packed
+         */
+        void buildTextureAtlas(const std::string &cacheDirectory = "");
+
+        /**
+         * @brief Get the texture atlas, to change its settings
+         * @return Reference to the texture atlas
+         */
+        TextureAtlas &getTextureAtlas();
+
+        /**
+         * @brief Get a texture by ID, with the rectangle of the image within it
+         *
+         * The rectangle covers the whole texture unless it was packed in the atlas.
+         * @param id Resource identifier
+         * @return Texture and rectangle of the image
+         * @throws std::out_of_range if the texture does not exist
+         */
+        TextureRegion getTextureRegion(const std::string &id);
+
+        /**
+         * @brief Create a sprite showing a texture, loaded or packed in the atlas
+         * @param id Resource identifier
+         * @return Sprite with the texture and the rectangle of its image
+         * @throws std::out_of_range if the texture does not exist
+         */
+        sf::Sprite createSprite(const std::string &id);
+
         /**
          * @brief Load a sprite sheet from a texture
          * @param id Resource identifier
-         * @param textureId ID of the texture to use
+         * @param textureId ID of the texture to use, loaded or packed in the atlas
          * @param frameWidth Width of each frame
          * @param frameHeight Height of each frame
          * @param frameCount Number of frames to extract
@@ -103,8 +159,8 @@ namespace Resources
         /**
          * @brief Load a sprite sheet from a texture with named frames
          * @param id Resource identifier
-         * @param textureId ID of the texture to use
-         * @param frames Vector of frame rectangles
+         * @param textureId ID of the texture to use, loaded or packed in the atlas
+         * @param frames Vector of frame rectangles, relative to the texture's image
          * @param namedFrames Map of frame names to indices
          * @return Reference to the created sprite sheet
          * @throws ResourceLoadException if the sprite sheet cannot be created
@@ -203,7 +259,7 @@ namespace Resources
         /**
          * @brief Check if a texture exists
          * @param id Resource identifier
-         * @return true if the texture exists
+         * @return true if the texture is loaded or packed in the atlas
          */
         bool hasTexture(const std::string &id) const;
 
@@ -299,6 +355,7 @@ namespace Resources
 
     private:
         std::unordered_map<std::string, std::unique_ptr<sf::Texture>> m_textures;
+        TextureAtlas m_textureAtlas;
         std::unordered_map<std::string, SpriteSheet> m_spriteSheets;
         std::unordered_map<std::string, std::unique_ptr<sf::Font>> m_fonts;
         std::unordered_map<std::string, std::unique_ptr<sf::SoundBuffer>> m_soundBuffers;
@@ -308,6 +365,9 @@ namespace Resources
         std::unordered_map<std::string, std::string> m_resourcePaths;
         std::string m_basePath;
 
+        // Recursive: sprite sheets and bulk loads go through the other accessors
+        mutable std::recursive_mutex m_mutex;
+
         // Helper methods
         std::string getFullPath(const std::string &resourceType, const std::string &filePath) const;
     };
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Resources
+{
+
+    /**
+     * @brief Part of a texture holding one image
+     */
+    struct TextureRegion
+    {
+        sf::Texture *texture = nullptr; // Texture containing the image
+        sf::IntRect rect;               // Image within the texture, in pixels
+    };
+
+    /**
+     * @brief Packs many images into a few large textures, so that their sprites can share draw calls
+     *
+     * Images are queued with add() and packed by build() into square pages
+     * with the MaxRects algorithm (best short side fit, largest images
+     * first). Each image is surrounded by a copy of its edge pixels
+     * (extrusion) and separated from its neighbours by padding, so that
+     * filtering and rounding never sample a neighbouring image. An image
+     * too large for a page gets a page of its own.
+     *
+     * With a cache directory, build() saves the pages and their layout, and
+     * the next build() with the same images (same files, sizes and
+     * modification times) and settings loads them back without decoding
+     * nor packing the images.
+     *
+     * Pages are never moved nor freed before the atlas is cleared, so the
+     * regions stay valid across builds.
+     */
+    class TextureAtlas
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param pageSize Width and height of the pages in pixels
+         * @param padding Empty pixels between two extruded images
+         * @param extrusion Edge pixels repeated around each image
+         */
+        explicit TextureAtlas(unsigned int pageSize = 2048, unsigned int padding = 2, unsigned int extrusion = 1);
+
+        /**
+         * @brief Queue an image for the next build
+         * @param id Region identifier, replacing any region with the same identifier
+         * @param filePath Path to the image file
+         */
+        void add(const std::string &id, const std::string &filePath);
+
+        /**
+         * @brief Pack the queued images into new pages
+         *
+         * Images that cannot be loaded are reported and left out.
+         * @param cacheDirectory Directory to load the pages from or save them to, empty for no cache
+         * @return true if every queued image was packed
+         */
+        bool build(const std::string &cacheDirectory = "");
+
+        /**
+         * @brief Enable or disable smooth filtering on every page
+         * @param smooth Whether to enable smooth filtering
+         */
+        void setSmooth(bool smooth);
+
+        /**
+         * @brief Check if an image was packed
+         * @param id Region identifier
+         * @return true if the atlas has a region for the identifier
+         */
+        bool contains(const std::string &id) const;
+
+        /**
+         * @brief Get the region of a packed image
+         * @param id Region identifier
+         * @return Page texture and rectangle of the image
+         * @throws std::out_of_range if the image was not packed
+         */
+        const TextureRegion &getRegion(const std::string &id) const;
+
+        /**
+         * @brief Forget the region of an image; its space is not reused
+         * @param id Region identifier
+         * @return true if the region was removed
+         */
+        bool remove(const std::string &id);
+
+        /**
+         * @brief Remove every page, region and queued image
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of pages built so far
+         * @return Page count
+         */
+        std::size_t getPageCount() const;
+
+    private:
+        struct PendingImage
+        {
+            std::string id;
+            std::string filePath;
+        };
+
+        // Image placed by a build, before its page is created
+        struct PackedImage
+        {
+            std::string id;
+            std::size_t page; // Index among the pages of the build
+            sf::IntRect rect; // Image within the page, extrusion excluded
+        };
+
+        std::string getSignature() const;
+        bool loadCache(const std::string &cacheDirectory, const std::string &signature);
+        void saveCache(const std::string &cacheDirectory, const std::string &signature,
+                       const std::vector<sf::Image> &pages, const std::vector<PackedImage> &packed) const;
+        void extrude(sf::Image &page, const sf::Image &image, sf::Vector2u position) const;
+        void addPages(std::vector<std::unique_ptr<sf::Texture>> &pages, const std::vector<PackedImage> &packed);
+
+        unsigned int m_pageSize;
+        unsigned int m_padding;
+        unsigned int m_extrusion;
+        bool m_smooth;
+
+        std::vector<PendingImage> m_pending;
+        std::vector<std::unique_ptr<sf::Texture>> m_pages;
+        std::unordered_map<std::string, TextureRegion> m_regions;
+    };
+
+} // namespace Resources
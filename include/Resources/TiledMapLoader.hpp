@@ -5,8 +5,14 @@
 #include <memory>
 #include <unordered_map>
 #include <SFML/Graphics.hpp>
+#include "../Core/FrameArena.hpp"
 
 // Forward déclarations
+namespace Graphics
+{
+    class RenderQueue;
+}
+
 namespace tson
 {
     class Map;
@@ -21,12 +27,24 @@ namespace Resources
 
     class ResourceManager;
 
+    /**
+     * @brief Bloc de tuiles d'une couche partageant un tileset, précalculé au chargement
+     */
+    struct TileChunk
+    {
+        const sf::Texture *texture = nullptr;
+        sf::VertexBuffer vertexBuffer{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static};
+        std::vector<sf::Vertex> vertices; // Seulement sans support des vertex buffers
+        sf::FloatRect bounds;             // Dans le repère de la couche, décalage exclu
+    };
+
     /**
      * @brief Structure pour représenter une couche de tuiles (layer)
      */
     struct TileLayer
     {
         std::vector<sf::Sprite> sprites;
+        std::vector<TileChunk> chunks; // Tuiles avec l'opacité de la couche, par blocs
         std::string name;
         bool visible = true;
         float opacity = 1.0f;
@@ -72,12 +90,26 @@ namespace Resources
         bool loadMap(const std::string &filePath);
 
         /**
-         * @brief Draw the map
+         * @brief Draw the chunks of the visible layers seen through the target's view
+         *
+         * Each chunk takes one draw call, and the layers follow the view
+         * according to their parallax factors.
          * @param target Target to draw to
          * @param states Render states
          */
         void draw(sf::RenderTarget &target, sf::RenderStates states = sf::RenderStates::Default) const;
 
+        /**
+         * @brief Add the chunks of the visible layers seen through a view to a render queue
+         *
+         * The chunks are referenced, not copied: the map must not be
+         * reloaded before the queue is drawn.
+         * @param queue Render queue of the frame
+         * @param view View the frame is drawn with
+         * @param firstLayer Drawing layer of the first tile layer; the next ones follow, one layer each
+         */
+        void enqueue(Graphics::RenderQueue &queue, const sf::View &view, int firstLayer = 0) const;
+
         /**
          * @brief Get the size of the map in pixels
          * @return Size of the map in pixels
@@ -105,24 +137,24 @@ namespace Resources
         std::vector<MapObject> getObjectsInLayer(const std::string &layerName) const;
 
         /**
-         * @brief Get all objects with a specific type
+         * @brief Collect the objects with a specific type without copying them
          * @param type Type of objects to get
-         * @return Vector of objects with the specified type
+         * @param result Receives pointers to the objects, valid until the map is reloaded
          */
-        std::vector<MapObject> getObjectsByType(const std::string &type) const;
+        void getObjectsByType(const std::string &type, Core::FrameVector<const MapObject *> &result) const;
 
         /**
-         * @brief Get all objects with a specific name
+         * @brief Collect the objects with a specific name without copying them
          * @param name Name of objects to get
-         * @return Vector of objects with the specified name
+         * @param result Receives pointers to the objects, valid until the map is reloaded
          */
-        std::vector<MapObject> getObjectsByName(const std::string &name) const;
+        void getObjectsByName(const std::string &name, Core::FrameVector<const MapObject *> &result) const;
 
         /**
-         * @brief Get all collidable objects (with "collidable" property set to true)
-         * @return Vector of collidable objects
+         * @brief Collect the collidable objects (with "collidable" property set to true) without copying them
+         * @param result Receives pointers to the objects, valid until the map is reloaded
          */
-        std::vector<MapObject> getCollidableObjects() const;
+        void getCollidableObjects(Core::FrameVector<const MapObject *> &result) const;
 
     private:
         ResourceManager &m_resourceManager;
@@ -138,11 +170,23 @@ namespace Resources
         sf::Vector2i m_mapSize;
         sf::Vector2i m_tileSize;
 
+        // Point de la vue où les couches en parallaxe sont à leur place
+        sf::Vector2f m_parallaxOrigin;
+
+        // Taille des blocs de tuiles, en tuiles de côté
+        static constexpr int CHUNK_SIZE = 32;
+
         // Méthodes privées pour analyser les différentes parties de la carte
         void parseTileLayer(const tson::Layer *layer);
         void parseObjectLayer(const tson::Layer *layer);
         MapObject createObject(const tson::Object *obj);
         sf::Sprite createSprite(const tson::Tileset *tileset, const tson::Tile *tile, int x, int y);
+        void bakeChunks(TileLayer &layer) const;
+        sf::Vector2f getLayerTranslation(const TileLayer &layer, const sf::Vector2f &viewCenter) const;
+
+        // Appelle func(index de couche, bloc, translation de la couche) pour chaque bloc visible
+        template <typename Func>
+        void forEachVisibleChunk(const sf::View &view, const sf::Transform &transform, Func &&func) const;
     };
 
 } // namespace Resources
\ No newline at end of file
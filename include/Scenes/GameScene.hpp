@@ -46,6 +46,13 @@ namespace Scenes
          */
         virtual void render(sf::RenderWindow &window) override;
 
+        /**
+         * @brief Record the scene into a snapshot, for pipelined rendering
+         * @param snapshot Snapshot to fill
+         * @return true
+         */
+        virtual bool capture(Graphics::RenderSnapshot &snapshot) override;
+
         /**
          * @brief Handle an event
          * @param event SFML event
@@ -35,6 +35,11 @@ namespace Scenes
          */
         virtual ~MainMenuScene();
 
+        /**
+         * @brief Load the fonts, sounds and textures of the menu
+         */
+        virtual void load() override;
+
         /**
          * @brief Initialize the scene
          */
@@ -52,6 +57,13 @@ namespace Scenes
          */
         virtual void render(sf::RenderWindow &window) override;
 
+        /**
+         * @brief Record the scene into a snapshot, for pipelined rendering
+         * @param snapshot Snapshot to fill
+         * @return true
+         */
+        virtual bool capture(Graphics::RenderSnapshot &snapshot) override;
+
         /**
          * @brief Handle an event
          * @param event SFML event
@@ -59,6 +71,10 @@ namespace Scenes
         virtual void handleEvent(const sf::Event &event) override;
 
     private:
+        // Draw the menu to the window or to a snapshot
+        template <typename Target>
+        void drawMenu(Target &target, const sf::Vector2u &windowSize);
+
         Core::Engine &m_engine;
 
         // Menu elements
@@ -97,6 +113,10 @@ namespace Scenes
 
         // Resources
         Resources::ResourceManager m_resourceManager;
+        bool m_resourcesLoaded; // Set by load(), which may run on a worker thread
+
+        // Next scene, preloaded while the menu is shown
+        std::shared_ptr<GameScene> m_gameScene;
 
         /**
          * @brief Create a menu item
@@ -1,15 +1,33 @@
 #include "include/Engine.hpp"
+#include "include/Scenes/GameScene.hpp"
 #include "include/Scenes/MainMenuScene.hpp"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
 
-int main()
+int main(int argc, char *argv[])
 {
     try
     {
         // Create engine instance
         Core::Engine engine("SFML 3 Game Engine", 1024, 768);
 
+        // --headless <ticks>: step the game scene without a window and report the throughput
+        if (argc >= 2 && std::strcmp(argv[1], "--headless") == 0)
+        {
+            int ticks = argc >= 3 ? std::atoi(argv[2]) : 1000;
+            if (!engine.initialize(true))
+            {
+                std::cerr << "Failed to initialize engine" << std::endl;
+                return 1;
+            }
+
+            engine.setScene(std::make_shared<Scenes::GameScene>(engine));
+            engine.runHeadless(ticks);
+            return 0;
+        }
+
         // Initialize engine
         if (!engine.initialize())
         {
@@ -1,5 +1,6 @@
 #include "../../include/AI/AISystem.hpp"
 #include "../../include/Core/EntityManager.hpp"
+#include "../../include/Core/TransformComponent.hpp"
 #include "../../include/AI/Pathfinding.hpp"
 #include "../../include/AI/BehaviorTree.hpp"
 #include "../../include/AI/Components/AIComponent.hpp"
@@ -23,6 +24,17 @@ namespace AI
     AISystem::AISystem(Core::EntityManager &entityManager)
         : Core::System(entityManager)
     {
+        declareWrite<Components::AIComponent>();
+        declareRead<Core::TransformComponent>();
+        declareView<Components::AIComponent>();
+
+        // Les IA proches de la caméra sont mises à jour à chaque frame, les
+        // autres à tour de rôle dans la limite de 2 ms par frame
+        Core::UpdatePolicy policy;
+        policy.budgetMs = 2.f;
+        policy.nearRadius = 1000.f;
+        declareUpdatePolicy(policy);
+
         // Créer et initialiser le système de pathfinding
         m_pathfinder = std::make_unique<Pathfinding::AStar>();
 
@@ -90,29 +102,30 @@ namespace AI
 
         // Mettre à jour tous les composants AI
         auto entityManager = Core::EntityManager::getInstance();
-        auto entities = entityManager->getEntitiesWithComponent<AIComponent>();
+        auto entities = entityManager->getView<AIComponent>();
 
-        for (auto entity : entities)
-        {
-            auto aiComponent = entityManager->getComponent<AIComponent>(entity);
+        // Chaque entité reçoit le temps écoulé depuis sa dernière mise à jour
+        getTimeSlicer().update(entities, deltaTime, [this](Core::Entity &entity, float elapsed)
+                               {
+            auto aiComponent = entity.getComponent<AIComponent>();
             if (!aiComponent || !aiComponent->isEnabled())
             {
-                continue;
+                return;
             }
 
             auto behaviorTree = aiComponent->getBehaviorTree();
             if (!behaviorTree)
             {
-                continue;
+                return;
             }
 
             // Mettre à jour le blackboard avec le deltaTime et l'entityId
             auto blackboard = behaviorTree->blackboard;
-            blackboard->set("deltaTime", deltaTime);
-            blackboard->set("entity_id", entity);
+            blackboard->set("deltaTime", elapsed);
+            blackboard->set("entity_id", entity.getId());
 
             // Mettre à jour d'autres paramètres du blackboard
-            updateEntityBlackboard(entity);
+            updateEntityBlackboard(entity.getId());
 
             // Exécuter le behavior tree
             BT::NodeStatus status = behaviorTree->tickRoot();
@@ -131,8 +144,7 @@ namespace AI
                 break;
             default:
                 break;
-            }
-        }
+            } });
     }
 
     Pathfinding::AStar &AISystem::getPathfinder()
@@ -240,12 +252,12 @@ namespace AI
         aiComponent->setBlackboardValue("entity_id", entityId);
 
         // Position de l'entité
-        sf::Vector2f position = transform->getPosition();
+        sf::Vector2f position = transform->getWorldPosition();
         aiComponent->setBlackboardValue("entity_x", position.x);
         aiComponent->setBlackboardValue("entity_y", position.y);
 
         // Rotation de l'entité
-        aiComponent->setBlackboardValue("entity_rotation", transform->getRotation());
+        aiComponent->setBlackboardValue("entity_rotation", transform->getWorldRotation());
 
         // Temps actuel (pour mesurer les délais)
         static float currentTime = 0.0f;
@@ -1,4 +1,6 @@
 #include "AI/Pathfinding.hpp"
+#include "Core/FrameArena.hpp"
+#include "Core/JobSystem.hpp"
 #include <algorithm>
 #include <limits>
 
@@ -76,22 +78,29 @@ namespace AI
                 return {sf::Vector2i(startX, startY)};
             }
 
-            // Structures de données pour l'algorithme A*
-            std::priority_queue<Node *, std::vector<Node *>, NodeComparator> openSet;
-            std::unordered_map<int, std::unordered_map<int, Node *>> nodeMap;
-            std::unordered_set<int> closedSet; // Utilisé pour garder trace des positions visitées
+            // Les nœuds et les structures de recherche viennent de l'arène du thread,
+            // libérée d'un coup à la fin de la recherche
+            Core::FrameArena &arena = Core::FrameArena::getThreadArena();
+            Core::FrameArena::Scope scope(arena);
+            Core::ArenaAllocator<int> allocator(arena);
+
+            // Structures de données pour l'algorithme A*, indexées par position (x * hauteur + y)
+            std::priority_queue<Node *, Core::FrameVector<Node *>, NodeComparator> openSet{NodeComparator(), Core::FrameVector<Node *>(allocator)};
+            std::unordered_map<int, Node *, std::hash<int>, std::equal_to<int>, Core::ArenaAllocator<std::pair<const int, Node *>>> nodeMap(64, std::hash<int>(), std::equal_to<int>(), allocator);
+            std::unordered_set<int, std::hash<int>, std::equal_to<int>, Core::ArenaAllocator<int>> closedSet(64, std::hash<int>(), std::equal_to<int>(), allocator); // Utilisé pour garder trace des positions visitées
+            std::vector<sf::Vector2i> neighbors;
 
             // Créer le nœud de départ
-            Node *startNode = new Node{
+            Node *startNode = arena.create<Node>(Node{
                 sf::Vector2i(startX, startY),
                 0.0f,                                    // gCost
                 heuristic(startX, startY, goalX, goalY), // hCost
                 nullptr                                  // parent
-            };
+            });
 
             // Ajouter le nœud de départ à l'openSet et à la map
             openSet.push(startNode);
-            nodeMap[startX][startY] = startNode;
+            nodeMap[startX * m_height + startY] = startNode;
 
             // Positions cibles
             sf::Vector2i goalPos(goalX, goalY);
@@ -106,18 +115,7 @@ namespace AI
                 // Si nous avons atteint l'objectif, reconstruire et retourner le chemin
                 if (currentNode->position.x == goalX && currentNode->position.y == goalY)
                 {
-                    std::vector<sf::Vector2i> path = reconstructPath(currentNode);
-
-                    // Nettoyer la mémoire
-                    for (auto &xEntry : nodeMap)
-                    {
-                        for (auto &yEntry : xEntry.second)
-                        {
-                            delete yEntry.second;
-                        }
-                    }
-
-                    return path;
+                    return reconstructPath(currentNode);
                 }
 
                 // Marquer le nœud comme visité
@@ -125,7 +123,7 @@ namespace AI
                 closedSet.insert(posKey);
 
                 // Explorer les voisins
-                std::vector<sf::Vector2i> neighbors = getNeighbors(currentNode->position, allowDiagonal);
+                getNeighbors(currentNode->position, allowDiagonal, neighbors);
                 for (const auto &neighborPos : neighbors)
                 {
                     int neighborPosKey = neighborPos.x * m_height + neighborPos.y;
@@ -153,27 +151,23 @@ namespace AI
                     Node *neighborNode = nullptr;
                     bool isNew = false;
 
-                    auto xIt = nodeMap.find(neighborPos.x);
-                    if (xIt != nodeMap.end())
+                    auto nodeIt = nodeMap.find(neighborPosKey);
+                    if (nodeIt != nodeMap.end())
                     {
-                        auto yIt = xIt->second.find(neighborPos.y);
-                        if (yIt != xIt->second.end())
-                        {
-                            neighborNode = yIt->second;
-                        }
+                        neighborNode = nodeIt->second;
                     }
 
                     // Si le voisin n'est pas dans l'openSet ou si le nouveau chemin est meilleur
                     if (!neighborNode)
                     {
                         // Créer un nouveau nœud
-                        neighborNode = new Node{
+                        neighborNode = arena.create<Node>(Node{
                             neighborPos,
                             tentativeGCost,
                             heuristic(neighborPos.x, neighborPos.y, goalX, goalY),
-                            currentNode};
+                            currentNode});
 
-                        nodeMap[neighborPos.x][neighborPos.y] = neighborNode;
+                        nodeMap[neighborPosKey] = neighborNode;
                         openSet.push(neighborNode);
                         isNew = true;
                     }
@@ -192,16 +186,33 @@ namespace AI
             }
 
             // Si nous arrivons ici, aucun chemin n'a été trouvé
-            // Nettoyer la mémoire
-            for (auto &xEntry : nodeMap)
+            return {};
+        }
+
+        std::vector<std::vector<sf::Vector2i>> AStar::findPaths(const std::vector<PathRequest> &requests,
+                                                                Core::JobSystem *jobSystem)
+        {
+            std::vector<std::vector<sf::Vector2i>> paths(requests.size());
+            auto search = [this, &requests, &paths](size_t begin, size_t end)
             {
-                for (auto &yEntry : xEntry.second)
+                for (size_t i = begin; i < end; ++i)
                 {
-                    delete yEntry.second;
+                    const PathRequest &request = requests[i];
+                    paths[i] = findPath(request.start.x, request.start.y, request.goal.x, request.goal.y,
+                                        request.allowDiagonal);
                 }
-            }
+            };
 
-            return {};
+            // Chaque recherche ne lit que la grille, elles peuvent donc tourner en parallèle
+            if (jobSystem)
+            {
+                jobSystem->parallelFor(0, requests.size(), 1, search, "AStar::findPaths");
+            }
+            else
+            {
+                search(0, requests.size());
+            }
+            return paths;
         }
 
         void AStar::clearObstacles()
@@ -212,9 +223,9 @@ namespace AI
             }
         }
 
-        std::vector<sf::Vector2i> AStar::getNeighbors(const sf::Vector2i &position, bool allowDiagonal) const
+        void AStar::getNeighbors(const sf::Vector2i &position, bool allowDiagonal, std::vector<sf::Vector2i> &neighbors) const
         {
-            std::vector<sf::Vector2i> neighbors;
+            neighbors.clear();
 
             // Voisins orthogonaux (haut, droite, bas, gauche)
             const int dx[] = {0, 1, 0, -1};
@@ -260,8 +271,6 @@ namespace AI
                     }
                 }
             }
-
-            return neighbors;
         }
 
         float AStar::heuristic(int x1, int y1, int x2, int y2) const
@@ -1,11 +1,13 @@
 #include "../../include/Core/Camera.hpp"
+#include "../../include/Core/EntityManager.hpp"
+#include "../../include/Core/TransformComponent.hpp"
 #include <cmath>
 #include <random>
 
 namespace Core
 {
     Camera::Camera(sf::RenderWindow &window, const sf::Vector2f &worldSize)
-        : m_window(window), m_worldSize(worldSize), m_zoomFactor(1.0f), m_targetPosition(nullptr), m_smoothFollow(true), m_followSpeed(5.0f), m_currentEffect(Effect::None), m_effectDuration(0.0f), m_effectIntensity(0.0f), m_effectTimer(0.0f), m_basePosition(0.0f, 0.0f)
+        : m_window(window), m_worldSize(worldSize), m_zoomFactor(1.0f), m_targetPosition(nullptr), m_targetManager(nullptr), m_smoothFollow(true), m_followSpeed(5.0f), m_currentEffect(Effect::None), m_effectDuration(0.0f), m_effectIntensity(0.0f), m_effectTimer(0.0f), m_basePosition(0.0f, 0.0f)
     {
         // Initialiser la vue avec la taille de la fenêtre
         m_view = window.getDefaultView();
@@ -22,13 +24,13 @@ namespace Core
     void Camera::update(float deltaTime)
     {
         // Suivre la cible si définie
-        if (m_targetPosition)
+        sf::Vector2f targetPos;
+        if (getTargetPosition(targetPos))
         {
             if (m_smoothFollow)
             {
                 // Suivi fluide avec interpolation
                 sf::Vector2f currentCenter = m_view.getCenter();
-                sf::Vector2f targetPos = *m_targetPosition;
 
                 // Calculer le vecteur de déplacement
                 sf::Vector2f moveVector = targetPos - currentCenter;
@@ -39,7 +41,7 @@ namespace Core
             else
             {
                 // Suivi direct
-                m_view.setCenter(*m_targetPosition);
+                m_view.setCenter(targetPos);
             }
         }
 
@@ -87,12 +89,45 @@ namespace Core
     void Camera::follow(const sf::Vector2f *targetPosition, bool smoothFollow)
     {
         m_targetPosition = targetPosition;
+        m_targetManager = nullptr;
+        m_smoothFollow = smoothFollow;
+    }
+
+    void Camera::follow(EntityManager &entityManager, EntityHandle target, bool smoothFollow)
+    {
+        m_targetPosition = nullptr;
+        m_targetManager = &entityManager;
+        m_targetEntity = target;
         m_smoothFollow = smoothFollow;
     }
 
     void Camera::stopFollowing()
     {
         m_targetPosition = nullptr;
+        m_targetManager = nullptr;
+    }
+
+    bool Camera::getTargetPosition(sf::Vector2f &position) const
+    {
+        if (m_targetPosition)
+        {
+            position = *m_targetPosition;
+            return true;
+        }
+
+        if (m_targetManager)
+        {
+            // La cible a pu être détruite depuis l'appel à follow()
+            Entity *entity = m_targetManager->getEntity(m_targetEntity);
+            const TransformComponent *transform = entity ? entity->getComponent<TransformComponent>() : nullptr;
+            if (transform)
+            {
+                position = transform->getWorldPosition();
+                return true;
+            }
+        }
+
+        return false;
     }
 
     void Camera::centerOn(const sf::Vector2f &position)
@@ -0,0 +1,174 @@
+#include "../../include/Core/CommandBuffer.hpp"
+#include <algorithm>
+
+namespace Core
+{
+
+    CommandBuffer::EntityRef::EntityRef(EntityHandle handle)
+        : m_handle(handle)
+    {
+    }
+
+    bool CommandBuffer::EntityRef::isPending() const
+    {
+        return m_pendingIndex != EntityHandle::INVALID_INDEX;
+    }
+
+    CommandBuffer::CommandBuffer()
+    {
+    }
+
+    CommandBuffer::~CommandBuffer()
+    {
+    }
+
+    CommandBuffer::EntityRef CommandBuffer::createEntity(const std::string &name)
+    {
+        EntityRef entity;
+        entity.m_pendingIndex = static_cast<std::uint32_t>(m_pendingNames.size());
+        m_pendingNames.push_back(name);
+
+        record(CommandType::CreateEntity, entity, 0, entity.m_pendingIndex);
+        return entity;
+    }
+
+    void CommandBuffer::destroyEntity(EntityRef entity)
+    {
+        record(CommandType::DestroyEntity, entity, 0, 0);
+    }
+
+    void CommandBuffer::apply(EntityManager &entityManager)
+    {
+        // Group the commands by phase, then the component changes by
+        // component type so that each pool is touched in a single run, and
+        // by target; the sequence keeps the recording order inside a group
+        std::sort(m_commands.begin(), m_commands.end(), [](const Command &a, const Command &b)
+                  {
+            int phaseA = getPhase(a.type);
+            int phaseB = getPhase(b.type);
+            if (phaseA != phaseB)
+                return phaseA < phaseB;
+            if (a.componentType != b.componentType)
+                return a.componentType < b.componentType;
+            if (a.target.isPending() != b.target.isPending())
+                return b.target.isPending();
+            if (getTargetKey(a.target) != getTargetKey(b.target))
+                return getTargetKey(a.target) < getTargetKey(b.target);
+            return a.sequence < b.sequence; });
+
+        m_createdEntities.assign(m_pendingNames.size(), EntityHandle{});
+
+        for (std::size_t i = 0; i < m_commands.size(); ++i)
+        {
+            const Command &command = m_commands[i];
+            if (i + 1 < m_commands.size() && isSameComponentChange(command, m_commands[i + 1]))
+            {
+                // A later addition or removal of the same component supersedes this one
+                continue;
+            }
+
+            if (command.type == CommandType::CreateEntity)
+            {
+                Entity *entity = entityManager.createEntity(m_pendingNames[command.payload]);
+                m_createdEntities[command.payload] = entity->getHandle();
+                continue;
+            }
+
+            Entity *entity = resolve(entityManager, command.target);
+            if (!entity)
+            {
+                continue;
+            }
+
+            switch (command.type)
+            {
+            case CommandType::RemoveComponent:
+                entityManager.removeComponent(*entity, command.componentType);
+                break;
+            case CommandType::AddComponent:
+                m_staging[command.componentType]->moveInto(entityManager, *entity, command.payload);
+                break;
+            case CommandType::DestroyEntity:
+                entityManager.removeEntity(entity->getHandle());
+                break;
+            default:
+                break;
+            }
+        }
+
+        clear();
+    }
+
+    void CommandBuffer::clear()
+    {
+        m_commands.clear();
+        m_pendingNames.clear();
+        for (auto &staging : m_staging)
+        {
+            if (staging)
+            {
+                staging->clear();
+            }
+        }
+    }
+
+    std::size_t CommandBuffer::size() const
+    {
+        return m_commands.size();
+    }
+
+    bool CommandBuffer::empty() const
+    {
+        return m_commands.empty();
+    }
+
+    const std::vector<EntityHandle> &CommandBuffer::getCreatedEntities() const
+    {
+        return m_createdEntities;
+    }
+
+    void CommandBuffer::record(CommandType type, EntityRef target, ComponentTypeId componentType, std::uint32_t payload)
+    {
+        Command command;
+        command.type = type;
+        command.componentType = componentType;
+        command.target = target;
+        command.payload = payload;
+        command.sequence = static_cast<std::uint32_t>(m_commands.size());
+        m_commands.push_back(command);
+    }
+
+    int CommandBuffer::getPhase(CommandType type)
+    {
+        switch (type)
+        {
+        case CommandType::CreateEntity:
+            return 0;
+        case CommandType::DestroyEntity:
+            return 2;
+        default:
+            return 1;
+        }
+    }
+
+    std::uint64_t CommandBuffer::getTargetKey(const EntityRef &target)
+    {
+        return target.isPending() ? target.m_pendingIndex : target.m_handle.toId();
+    }
+
+    bool CommandBuffer::isSameComponentChange(const Command &a, const Command &b)
+    {
+        return getPhase(a.type) == 1 && getPhase(b.type) == 1 && a.componentType == b.componentType &&
+               a.target.isPending() == b.target.isPending() && getTargetKey(a.target) == getTargetKey(b.target);
+    }
+
+    Entity *CommandBuffer::resolve(EntityManager &entityManager, const EntityRef &target) const
+    {
+        if (target.isPending())
+        {
+            return entityManager.getEntity(m_createdEntities[target.m_pendingIndex]);
+        }
+        return entityManager.getEntity(target.m_handle);
+    }
+
+} // namespace Core
\ No newline at end of file
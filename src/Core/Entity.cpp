@@ -1,11 +1,12 @@
 #include "../../include/Core/Entity.hpp"
+#include "../../include/Core/EntityManager.hpp"
 #include <algorithm>
 
 namespace Core
 {
 
-    Entity::Entity(unsigned int id, const std::string &name)
-        : m_id(id), m_name(name), m_active(true)
+    Entity::Entity(EntityManager &manager, EntityHandle handle, const std::string &name)
+        : m_manager(manager), m_handle(handle), m_name(name), m_active(true)
     {
     }
 
@@ -14,9 +15,19 @@ namespace Core
         removeAllComponents();
     }
 
-    unsigned int Entity::getId() const
+    EntityId Entity::getId() const
     {
-        return m_id;
+        return m_handle.toId();
+    }
+
+    EntityHandle Entity::getHandle() const
+    {
+        return m_handle;
+    }
+
+    unsigned int Entity::getIndex() const
+    {
+        return m_handle.index;
     }
 
     const std::string &Entity::getName() const
@@ -31,7 +42,7 @@ namespace Core
 
     void Entity::removeAllComponents()
     {
-        m_components.clear();
+        m_manager.removeAllComponents(*this);
     }
 
     void Entity::setActive(bool active)
@@ -44,4 +55,9 @@ namespace Core
         return m_active;
     }
 
+    const ComponentMask &Entity::getComponentMask() const
+    {
+        return m_componentMask;
+    }
+
 } // namespace Core
\ No newline at end of file
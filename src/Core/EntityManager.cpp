@@ -1,11 +1,12 @@
 #include "../../include/Core/EntityManager.hpp"
+#include "../../include/Core/CommandBuffer.hpp"
 #include <algorithm>
 
 namespace Core
 {
 
     EntityManager::EntityManager()
-        : m_nextEntityId(0)
+        : m_tick(0), m_entityCount(0), m_commandBuffer(std::make_unique<CommandBuffer>())
     {
     }
 
@@ -16,32 +17,62 @@ namespace Core
 
     Entity *EntityManager::createEntity(const std::string &name)
     {
-        unsigned int id = m_nextEntityId++;
-        auto entity = std::make_unique<Entity>(id, name);
-        Entity *entityPtr = entity.get();
-        m_entities[id] = std::move(entity);
-        return entityPtr;
+        std::uint32_t index = allocateSlot();
+        EntitySlot &slot = m_slots[index];
+        slot.entity = std::make_unique<Entity>(*this, EntityHandle{index, slot.generation}, name);
+        ++m_entityCount;
+        return slot.entity.get();
     }
 
-    Entity *EntityManager::getEntity(unsigned int id)
+    std::uint32_t EntityManager::allocateSlot()
     {
-        auto it = m_entities.find(id);
-        if (it != m_entities.end())
+        if (!m_freeSlots.empty())
         {
-            return it->second.get();
+            // Recycle the most recently freed slot
+            std::uint32_t index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            return index;
         }
-        return nullptr;
+
+        m_slots.emplace_back();
+        return static_cast<std::uint32_t>(m_slots.size() - 1);
+    }
+
+    Entity *EntityManager::getEntity(EntityId id)
+    {
+        return getEntity(EntityHandle::fromId(id));
+    }
+
+    Entity *EntityManager::getEntity(EntityHandle handle)
+    {
+        if (!isAlive(handle))
+        {
+            return nullptr;
+        }
+        return m_slots[handle.index].entity.get();
+    }
+
+    bool EntityManager::isAlive(EntityHandle handle) const
+    {
+        return handle.index < m_slots.size() &&
+               m_slots[handle.index].generation == handle.generation &&
+               m_slots[handle.index].entity != nullptr;
+    }
+
+    std::size_t EntityManager::getEntityCount() const
+    {
+        return m_entityCount;
     }
 
     std::vector<Entity *> EntityManager::getEntitiesByName(const std::string &name)
     {
         std::vector<Entity *> result;
 
-        for (auto &pair : m_entities)
+        for (auto &slot : m_slots)
         {
-            if (pair.second->getName() == name)
+            if (slot.entity && slot.entity->getName() == name)
             {
-                result.push_back(pair.second.get());
+                result.push_back(slot.entity.get());
             }
         }
 
@@ -51,40 +82,181 @@ namespace Core
     std::vector<Entity *> EntityManager::getAllEntities()
     {
         std::vector<Entity *> result;
-        result.reserve(m_entities.size());
+        result.reserve(m_entityCount);
 
-        for (auto &pair : m_entities)
+        for (auto &slot : m_slots)
         {
-            result.push_back(pair.second.get());
+            if (slot.entity)
+            {
+                result.push_back(slot.entity.get());
+            }
         }
 
         return result;
     }
 
-    bool EntityManager::removeEntity(unsigned int id)
+    bool EntityManager::removeEntity(EntityId id)
     {
-        auto it = m_entities.find(id);
-        if (it != m_entities.end())
+        return removeEntity(EntityHandle::fromId(id));
+    }
+
+    bool EntityManager::removeEntity(EntityHandle handle)
+    {
+        if (!isAlive(handle))
         {
-            m_entities.erase(it);
-            return true;
+            return false;
         }
-        return false;
+
+        EntitySlot &slot = m_slots[handle.index];
+        slot.entity.reset();
+
+        // Invalidate every outstanding handle to this slot before reusing it
+        ++slot.generation;
+        m_freeSlots.push_back(handle.index);
+        --m_entityCount;
+        return true;
     }
 
     void EntityManager::removeAllEntities()
     {
-        m_entities.clear();
+        for (std::uint32_t index = 0; index < m_slots.size(); ++index)
+        {
+            EntitySlot &slot = m_slots[index];
+            if (slot.entity)
+            {
+                removeEntity(slot.entity->getHandle());
+            }
+        }
+    }
+
+    void EntityManager::removeAllComponents(Entity &entity)
+    {
+        ComponentMask oldMask = entity.m_componentMask;
+        entity.m_componentMask.reset();
+        notifyMaskChanged(entity, oldMask);
+
+        for (ComponentTypeId typeId = 0; typeId < m_componentPools.size(); ++typeId)
+        {
+            if (oldMask.test(typeId))
+            {
+                m_componentPools[typeId]->remove(entity.getIndex());
+            }
+        }
+    }
+
+    bool EntityManager::removeComponent(Entity &entity, ComponentTypeId typeId)
+    {
+        if (!entity.m_componentMask.test(typeId))
+        {
+            return false;
+        }
+
+        ComponentMask oldMask = entity.m_componentMask;
+        entity.m_componentMask.reset(typeId);
+        notifyMaskChanged(entity, oldMask);
+        return m_componentPools[typeId]->remove(entity.getIndex());
+    }
+
+    ComponentPoolStats EntityManager::getComponentPoolStats(ComponentTypeId typeId) const
+    {
+        if (typeId >= m_componentPools.size() || !m_componentPools[typeId])
+        {
+            return ComponentPoolStats();
+        }
+        return m_componentPools[typeId]->getStats();
+    }
+
+    std::size_t EntityManager::getComponentAllocationCount() const
+    {
+        std::size_t allocations = 0;
+        for (const auto &pool : m_componentPools)
+        {
+            if (pool)
+            {
+                allocations += pool->getStats().allocations;
+            }
+        }
+        return allocations;
+    }
+
+    CommandBuffer &EntityManager::getCommandBuffer()
+    {
+        return *m_commandBuffer;
+    }
+
+    void EntityManager::flushCommands()
+    {
+        m_commandBuffer->apply(*this);
+        compactViews();
+    }
+
+    void EntityManager::compactViews()
+    {
+        for (auto &pair : m_views)
+        {
+            pair.second->compact();
+        }
+    }
+
+    void EntityManager::advanceTick()
+    {
+        ++m_tick;
+    }
+
+    void EntityManager::pruneRemoved(std::uint32_t oldestTick)
+    {
+        for (auto &pool : m_componentPools)
+        {
+            if (pool)
+            {
+                pool->pruneRemoved(oldestTick);
+            }
+        }
+    }
+
+    std::uint32_t EntityManager::getCurrentTick() const
+    {
+        return m_tick;
+    }
+
+    EntityView &EntityManager::getEntityView(const ComponentMask &mask)
+    {
+        auto it = m_views.find(mask);
+        if (it != m_views.end())
+        {
+            return *it->second;
+        }
+
+        // Seed the new view with the entities that already match, in slot order
+        auto view = std::make_unique<EntityView>(mask);
+        for (auto &slot : m_slots)
+        {
+            if (slot.entity && (slot.entity->getComponentMask() & mask) == mask)
+            {
+                view->insert(*slot.entity);
+            }
+        }
+
+        EntityView &viewRef = *view;
+        m_views[mask] = std::move(view);
+        return viewRef;
+    }
+
+    void EntityManager::notifyMaskChanged(Entity &entity, const ComponentMask &oldMask)
+    {
+        for (auto &pair : m_views)
+        {
+            pair.second->onMaskChanged(entity, oldMask, entity.m_componentMask);
+        }
     }
 
     void EntityManager::update(float deltaTime)
     {
-        for (auto &pair : m_entities)
+        for (auto &pool : m_componentPools)
         {
-            auto entity = pair.second.get();
-            if (entity->isActive())
+            if (pool)
             {
-                // No direct update method on entity, components handle updates
+                pool->updateAll(deltaTime);
             }
         }
     }
@@ -0,0 +1,111 @@
+#include "../../include/Core/FrameArena.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace Core
+{
+    namespace
+    {
+        std::atomic<unsigned int> s_frame(0);
+    }
+
+    FrameArena::FrameArena(std::size_t blockSize)
+        : m_blockSize(std::max<std::size_t>(blockSize, 64)), m_current(0), m_offset(0), m_used(0), m_peak(0),
+          m_frame(s_frame.load(std::memory_order_relaxed))
+    {
+    }
+
+    void *FrameArena::allocate(std::size_t size, std::size_t alignment)
+    {
+        // Try the current block, then the following ones kept from earlier frames
+        for (; m_current < m_blocks.size(); ++m_current, m_offset = 0)
+        {
+            Block &block = m_blocks[m_current];
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.data.get()) + m_offset;
+            std::size_t padding = (alignment - address % alignment) % alignment;
+            if (m_offset + padding + size <= block.size)
+            {
+                m_offset += padding + size;
+                m_used += padding + size;
+                m_peak = std::max(m_peak, m_used);
+                return block.data.get() + m_offset - size;
+            }
+        }
+
+        // Out of memory: add a block large enough for the allocation
+        std::size_t blockSize = std::max(m_blockSize, size + alignment);
+        m_blocks.push_back(Block{std::make_unique<std::byte[]>(blockSize), blockSize});
+        m_current = m_blocks.size() - 1;
+        m_offset = 0;
+        return allocate(size, alignment);
+    }
+
+    FrameArena::Marker FrameArena::getMarker() const
+    {
+        return Marker{m_current, m_offset, m_used};
+    }
+
+    void FrameArena::rewind(const Marker &marker)
+    {
+        m_current = marker.block;
+        m_offset = marker.offset;
+        m_used = marker.used;
+    }
+
+    void FrameArena::reset()
+    {
+        // Merge the blocks so that the next frame fits in one
+        if (m_blocks.size() > 1)
+        {
+            std::size_t capacity = getCapacity();
+            m_blocks.clear();
+            m_blocks.push_back(Block{std::make_unique<std::byte[]>(capacity), capacity});
+        }
+
+        m_current = 0;
+        m_offset = 0;
+        m_used = 0;
+        m_peak = 0;
+    }
+
+    std::size_t FrameArena::getUsedBytes() const
+    {
+        return m_used;
+    }
+
+    std::size_t FrameArena::getPeakBytes() const
+    {
+        return m_peak;
+    }
+
+    std::size_t FrameArena::getCapacity() const
+    {
+        std::size_t capacity = 0;
+        for (const Block &block : m_blocks)
+        {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+
+    FrameArena &FrameArena::getThreadArena()
+    {
+        thread_local FrameArena arena;
+
+        // Each thread resets its own arena, so no other thread ever touches it
+        unsigned int frame = s_frame.load(std::memory_order_acquire);
+        if (arena.m_frame != frame)
+        {
+            arena.reset();
+            arena.m_frame = frame;
+        }
+        return arena;
+    }
+
+    void FrameArena::nextFrame()
+    {
+        s_frame.fetch_add(1, std::memory_order_release);
+    }
+
+} // namespace Core
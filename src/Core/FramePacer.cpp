@@ -0,0 +1,243 @@
+#include "../../include/Core/FramePacer.hpp"
+#include "../../include/Core/Profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+namespace Core
+{
+
+    namespace
+    {
+        // Weight of the last frame in the smoothed cost
+        const float SMOOTHING = 0.2f;
+
+        // Lower the quality after a few frames predicted over this share of the budget...
+        const float OVER_BUDGET_RATIO = 0.95f;
+        const int OVER_BUDGET_FRAMES = 3;
+
+        // ...and raise it after a much longer run of frames under this share
+        const float HEADROOM_RATIO = 0.7f;
+        const int HEADROOM_FRAMES = 90;
+
+        // Frames left for a change to show in the smoothed cost before deciding again
+        const int SETTLE_FRAMES = 15;
+
+        // Sleeping is coarse: the end of the slot is waited for by yielding
+        const std::chrono::microseconds SLEEP_MARGIN(1500);
+
+        float elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+        {
+            return std::chrono::duration<float, std::milli>(to - from).count();
+        }
+    }
+
+    FramePacer::FramePacer(float targetFramerate)
+        : m_presented(false), m_frameLimitEnabled(true), m_qualityScalingEnabled(true), m_targetLevel(0),
+          m_appliedLevel(0), m_overBudgetFrames(0), m_headroomFrames(0), m_settleFrames(0), m_frameIndex(0)
+    {
+        setTargetFramerate(targetFramerate);
+        m_stats.maxQualityLevel = 4;
+        m_frameStart = Clock::now();
+    }
+
+    void FramePacer::setTargetFramerate(float framesPerSecond)
+    {
+        if (framesPerSecond > 0.f)
+        {
+            m_stats.budgetMs = 1000.f / framesPerSecond;
+        }
+    }
+
+    void FramePacer::setFrameLimitEnabled(bool enabled)
+    {
+        m_frameLimitEnabled = enabled;
+    }
+
+    void FramePacer::setQualityScalingEnabled(bool enabled)
+    {
+        m_qualityScalingEnabled = enabled;
+        if (!enabled && m_targetLevel != 0)
+        {
+            changeLevel(0);
+        }
+    }
+
+    void FramePacer::setMaxQualityLevel(int levels)
+    {
+        m_stats.maxQualityLevel = std::max(levels, 1);
+        if (m_targetLevel > m_stats.maxQualityLevel)
+        {
+            changeLevel(m_stats.maxQualityLevel);
+        }
+    }
+
+    void FramePacer::addKnob(const std::string &name, float fullQuality, float lowestQuality, ApplyFunction apply)
+    {
+        m_knobs.push_back(Knob{name, fullQuality, lowestQuality, std::move(apply)});
+        m_knobs.back().apply(getKnobValue(m_knobs.back(), m_appliedLevel));
+    }
+
+    void FramePacer::beginFrame()
+    {
+        m_frameStart = Clock::now();
+        m_presented = false;
+    }
+
+    void FramePacer::beginPresent()
+    {
+        m_presentStart = Clock::now();
+    }
+
+    void FramePacer::endPresent()
+    {
+        m_presentEnd = Clock::now();
+        m_presented = true;
+    }
+
+    void FramePacer::endFrame()
+    {
+        Clock::time_point frameEnd = Clock::now();
+        ++m_frameIndex;
+
+        // Without a presentation, the whole frame is CPU work
+        if (m_presented)
+        {
+            m_stats.cpuMs = elapsedMs(m_frameStart, m_presentStart) + elapsedMs(m_presentEnd, frameEnd);
+            m_stats.presentMs = elapsedMs(m_presentStart, m_presentEnd);
+        }
+        else
+        {
+            m_stats.cpuMs = elapsedMs(m_frameStart, frameEnd);
+            m_stats.presentMs = 0.f;
+        }
+
+        float cost = m_stats.cpuMs + m_stats.presentMs;
+        m_stats.predictedMs = m_frameIndex == 1 ? cost : m_stats.predictedMs + SMOOTHING * (cost - m_stats.predictedMs);
+
+        if (!m_qualityScalingEnabled)
+        {
+            return;
+        }
+        if (m_settleFrames > 0)
+        {
+            --m_settleFrames;
+            return;
+        }
+
+        // Count the runs of frames over budget and with headroom
+        if (m_stats.predictedMs > OVER_BUDGET_RATIO * m_stats.budgetMs)
+        {
+            ++m_overBudgetFrames;
+            m_headroomFrames = 0;
+        }
+        else if (m_stats.predictedMs < HEADROOM_RATIO * m_stats.budgetMs)
+        {
+            ++m_headroomFrames;
+            m_overBudgetFrames = 0;
+        }
+        else
+        {
+            m_overBudgetFrames = 0;
+            m_headroomFrames = 0;
+        }
+
+        if (m_overBudgetFrames >= OVER_BUDGET_FRAMES && m_targetLevel < m_stats.maxQualityLevel)
+        {
+            changeLevel(m_targetLevel + 1);
+        }
+        else if (m_headroomFrames >= HEADROOM_FRAMES && m_targetLevel > 0)
+        {
+            changeLevel(m_targetLevel - 1);
+        }
+    }
+
+    void FramePacer::applyQuality()
+    {
+        if (m_appliedLevel == m_targetLevel)
+        {
+            return;
+        }
+
+        m_appliedLevel = m_targetLevel;
+        m_stats.qualityLevel = m_appliedLevel;
+        for (const Knob &knob : m_knobs)
+        {
+            knob.apply(getKnobValue(knob, m_appliedLevel));
+        }
+    }
+
+    void FramePacer::waitForNextFrame()
+    {
+        if (!m_frameLimitEnabled)
+        {
+            return;
+        }
+
+        ORENJI_ZONE("FramePacer::wait");
+        Clock::time_point deadline = m_frameStart + std::chrono::duration_cast<Clock::duration>(
+                                                        std::chrono::duration<float, std::milli>(m_stats.budgetMs));
+        if (deadline - Clock::now() > SLEEP_MARGIN)
+        {
+            std::this_thread::sleep_until(deadline - SLEEP_MARGIN);
+        }
+        while (Clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    int FramePacer::getQualityLevel() const
+    {
+        return m_appliedLevel;
+    }
+
+    const FramePacerStats &FramePacer::getStats() const
+    {
+        return m_stats;
+    }
+
+    const std::deque<QualityDecision> &FramePacer::getDecisions() const
+    {
+        return m_decisions;
+    }
+
+    float FramePacer::getKnobValue(const Knob &knob, int level) const
+    {
+        float t = static_cast<float>(level) / static_cast<float>(m_stats.maxQualityLevel);
+        return knob.fullQuality + (knob.lowestQuality - knob.fullQuality) * t;
+    }
+
+    void FramePacer::changeLevel(int level)
+    {
+        QualityDecision decision;
+        decision.frame = m_frameIndex;
+        decision.fromLevel = m_targetLevel;
+        decision.toLevel = level;
+        decision.predictedMs = m_stats.predictedMs;
+        decision.budgetMs = m_stats.budgetMs;
+
+        m_decisions.push_back(decision);
+        if (m_decisions.size() > DECISION_HISTORY)
+        {
+            m_decisions.pop_front();
+        }
+
+        std::cout << "Frame pacer: quality level " << decision.fromLevel << " -> " << decision.toLevel;
+        char timing[64];
+        std::snprintf(timing, sizeof(timing), " (predicted %.2f ms, budget %.2f ms)", decision.predictedMs, decision.budgetMs);
+        std::cout << timing;
+        for (const Knob &knob : m_knobs)
+        {
+            std::cout << ", " << knob.name << " " << getKnobValue(knob, level);
+        }
+        std::cout << std::endl;
+
+        m_targetLevel = level;
+        m_overBudgetFrames = 0;
+        m_headroomFrames = 0;
+        m_settleFrames = SETTLE_FRAMES;
+    }
+
+} // namespace Core
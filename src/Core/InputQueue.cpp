@@ -0,0 +1,83 @@
+#include "../../include/Core/InputQueue.hpp"
+#include <algorithm>
+
+namespace Core
+{
+
+    InputEvent::InputEvent()
+        : event(sf::Event::FocusGained{}), timestamp()
+    {
+    }
+
+    InputEvent::InputEvent(const sf::Event &event, Clock::time_point timestamp)
+        : event(event), timestamp(timestamp)
+    {
+    }
+
+    InputQueue::InputQueue(std::size_t capacity)
+        : m_events(capacity), m_dropped(0), m_hasPending(false)
+    {
+    }
+
+    bool InputQueue::push(const sf::Event &event, Clock::time_point timestamp)
+    {
+        if (!m_events.push(InputEvent(event, timestamp)))
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    bool InputQueue::pop(InputEvent &event)
+    {
+        if (!m_events.pop(event))
+        {
+            return false;
+        }
+
+        if (!m_hasPending || event.timestamp < m_oldestPending)
+        {
+            m_oldestPending = event.timestamp;
+            m_hasPending = true;
+        }
+        return true;
+    }
+
+    std::size_t InputQueue::size() const
+    {
+        return m_events.size();
+    }
+
+    std::uint64_t InputQueue::getDroppedCount() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    void InputQueue::notifyPresented(Clock::time_point presentTime)
+    {
+        // Frames that consumed no input say nothing about input latency
+        if (!m_hasPending)
+        {
+            return;
+        }
+        m_hasPending = false;
+
+        float latencyMs = std::chrono::duration<float, std::milli>(presentTime - m_oldestPending).count();
+        m_latency.lastMs = latencyMs;
+        m_latency.maxMs = std::max(m_latency.maxMs, latencyMs);
+        ++m_latency.samples;
+        m_latency.averageMs += (latencyMs - m_latency.averageMs) / static_cast<float>(m_latency.samples);
+    }
+
+    const InputLatencyStats &InputQueue::getLatencyStats() const
+    {
+        return m_latency;
+    }
+
+    void InputQueue::resetLatencyStats()
+    {
+        m_latency = InputLatencyStats();
+    }
+
+} // namespace Core
\ No newline at end of file
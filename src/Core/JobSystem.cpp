@@ -0,0 +1,238 @@
+#include "../../include/Core/JobSystem.hpp"
+#include "../../include/Core/Profiler.hpp"
+#include <algorithm>
+#include <string>
+
+namespace Core
+{
+
+    namespace
+    {
+        // Queue owned by the calling thread, 0 for threads that are not workers
+        thread_local const JobSystem *t_jobSystem = nullptr;
+        thread_local unsigned int t_queueIndex = 0;
+    }
+
+    JobCounter::JobCounter()
+        : m_pending(0)
+    {
+    }
+
+    bool JobCounter::isDone() const
+    {
+        return m_pending.load(std::memory_order_acquire) == 0;
+    }
+
+    JobSystem::JobSystem(unsigned int workerCount)
+        : m_running(true), m_queuedJobs(0), m_deferredCount(0)
+    {
+        if (workerCount == 0)
+        {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        for (unsigned int i = 0; i <= workerCount; ++i)
+        {
+            m_queues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        for (unsigned int i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_running = false;
+        }
+        m_wakeCondition.notify_all();
+
+        for (auto &worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void JobSystem::submit(Job job, JobCounter *counter, const char *name)
+    {
+        if (counter)
+        {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        enqueue(QueuedJob{std::move(job), counter, name});
+    }
+
+    void JobSystem::submitAfter(const JobCounter &dependency, Job job, JobCounter *counter, const char *name)
+    {
+        if (counter)
+        {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            // Counted before checking the dependency: a job finishing in between
+            // either sees the count and releases the deferred job, or was seen done
+            std::lock_guard<std::mutex> lock(m_deferredMutex);
+            m_deferredCount.fetch_add(1);
+            if (dependency.m_pending.load() != 0)
+            {
+                m_deferredJobs.push_back(DeferredJob{&dependency, QueuedJob{std::move(job), counter, name}});
+                return;
+            }
+            m_deferredCount.fetch_sub(1);
+        }
+
+        enqueue(QueuedJob{std::move(job), counter, name});
+    }
+
+    void JobSystem::enqueue(QueuedJob job)
+    {
+        WorkQueue &queue = *m_queues[getCurrentQueueIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            ++m_queuedJobs;
+        }
+        m_wakeCondition.notify_one();
+    }
+
+    void JobSystem::wait(const JobCounter &counter)
+    {
+        unsigned int queueIndex = getCurrentQueueIndex();
+        while (!counter.isDone())
+        {
+            if (!runPendingJob(queueIndex))
+            {
+                if (m_deferredCount.load() > 0)
+                {
+                    releaseDeferredJobs();
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    unsigned int JobSystem::getWorkerCount() const
+    {
+        return static_cast<unsigned int>(m_workers.size());
+    }
+
+    void JobSystem::workerLoop(unsigned int queueIndex)
+    {
+        t_jobSystem = this;
+        t_queueIndex = queueIndex;
+        ORENJI_THREAD_NAME(Profiler::getInstance().intern("Worker " + std::to_string(queueIndex)));
+
+        while (true)
+        {
+            if (runPendingJob(queueIndex))
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wakeCondition.wait(lock, [this]
+                                 { return m_queuedJobs > 0 || !m_running; });
+
+            if (!m_running && m_queuedJobs == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    bool JobSystem::runPendingJob(unsigned int queueIndex)
+    {
+        QueuedJob job;
+        if (!popJob(queueIndex, job) && !stealJob(queueIndex, job))
+        {
+            return false;
+        }
+
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        {
+            ORENJI_ZONE(job.name);
+            job.job();
+        }
+
+        if (job.counter)
+        {
+            // Sequentially consistent, paired with submitAfter(): see the deferred count after the decrement
+            job.counter->m_pending.fetch_sub(1);
+            if (m_deferredCount.load() > 0)
+            {
+                releaseDeferredJobs();
+            }
+        }
+        return true;
+    }
+
+    void JobSystem::releaseDeferredJobs()
+    {
+        std::vector<QueuedJob> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_deferredMutex);
+            auto firstReady = std::stable_partition(m_deferredJobs.begin(), m_deferredJobs.end(), [](const DeferredJob &deferred)
+                                                    { return !deferred.dependency->isDone(); });
+            for (auto it = firstReady; it != m_deferredJobs.end(); ++it)
+            {
+                ready.push_back(std::move(it->job));
+            }
+            m_deferredJobs.erase(firstReady, m_deferredJobs.end());
+            m_deferredCount.fetch_sub(static_cast<int>(ready.size()));
+        }
+
+        for (QueuedJob &job : ready)
+        {
+            enqueue(std::move(job));
+        }
+    }
+
+    bool JobSystem::popJob(unsigned int queueIndex, QueuedJob &job)
+    {
+        // The owner takes its most recent job, which is the most likely to be cache-hot
+        WorkQueue &queue = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+        {
+            return false;
+        }
+
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    bool JobSystem::stealJob(unsigned int thiefIndex, QueuedJob &job)
+    {
+        // Thieves take the oldest job, starting with the queue after their own
+        std::size_t queueCount = m_queues.size();
+        for (std::size_t offset = 1; offset < queueCount; ++offset)
+        {
+            WorkQueue &queue = *m_queues[(thiefIndex + offset) % queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    unsigned int JobSystem::getCurrentQueueIndex() const
+    {
+        return t_jobSystem == this ? t_queueIndex : 0;
+    }
+
+} // namespace Core
\ No newline at end of file
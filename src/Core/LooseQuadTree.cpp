@@ -0,0 +1,213 @@
+#include "../../include/Core/LooseQuadTree.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Core
+{
+
+    LooseQuadTree::LooseQuadTree(const sf::FloatRect &bounds, unsigned int maxDepth)
+        : m_bounds(bounds), m_depth(std::min(maxDepth, MAX_DEPTH)), m_size(0)
+    {
+        m_nodes.emplace_back();
+    }
+
+    void LooseQuadTree::insert(std::uint32_t id, const sf::FloatRect &bounds)
+    {
+        if (id >= m_items.size())
+        {
+            m_items.resize(static_cast<std::size_t>(id) + 1);
+        }
+
+        std::uint32_t node = findNode(bounds);
+        Item &item = m_items[id];
+        item.bounds = bounds;
+        if (item.node == node)
+        {
+            return;
+        }
+
+        if (item.node != NONE)
+        {
+            unlink(id);
+        }
+        else
+        {
+            ++m_size;
+        }
+        link(id, node);
+    }
+
+    bool LooseQuadTree::remove(std::uint32_t id)
+    {
+        if (!contains(id))
+        {
+            return false;
+        }
+
+        unlink(id);
+        --m_size;
+        return true;
+    }
+
+    bool LooseQuadTree::contains(std::uint32_t id) const
+    {
+        return id < m_items.size() && m_items[id].node != NONE;
+    }
+
+    void LooseQuadTree::clear()
+    {
+        m_nodes.clear();
+        m_nodes.emplace_back();
+        m_items.clear();
+        m_size = 0;
+    }
+
+    std::size_t LooseQuadTree::size() const
+    {
+        return m_size;
+    }
+
+    std::uint32_t LooseQuadTree::findNode(const sf::FloatRect &bounds)
+    {
+        sf::Vector2f center = bounds.position + bounds.size / 2.f;
+        if (!m_bounds.contains(center))
+        {
+            // Grow toward items near the bounds only: a stray item far away
+            // would otherwise use up the growth in its direction
+            sf::FloatRect reach(m_bounds.position - m_bounds.size * 2.f, m_bounds.size * 5.f);
+            if (!reach.contains(center))
+            {
+                return 0;
+            }
+            while (!m_bounds.contains(center))
+            {
+                if (!grow(center))
+                {
+                    return 0;
+                }
+            }
+        }
+
+        // Deepest level whose cells are at least as large as the item: the
+        // loose bounds of the cell holding its center then contain it
+        unsigned int depth = 0;
+        sf::Vector2f cellSize = m_bounds.size;
+        while (depth < m_depth && bounds.size.x <= cellSize.x / 2.f && bounds.size.y <= cellSize.y / 2.f)
+        {
+            cellSize /= 2.f;
+            ++depth;
+        }
+
+        // Walk down to the cell holding the center, creating the missing nodes
+        std::uint32_t cells = 1u << depth;
+        std::uint32_t column = std::min(static_cast<std::uint32_t>((center.x - m_bounds.position.x) / cellSize.x), cells - 1);
+        std::uint32_t row = std::min(static_cast<std::uint32_t>((center.y - m_bounds.position.y) / cellSize.y), cells - 1);
+
+        std::uint32_t node = 0;
+        for (unsigned int level = depth; level > 0; --level)
+        {
+            std::uint32_t quadrant = ((column >> (level - 1)) & 1u) | (((row >> (level - 1)) & 1u) << 1);
+            std::uint32_t child = m_nodes[node].children[quadrant];
+            if (child == NONE)
+            {
+                child = static_cast<std::uint32_t>(m_nodes.size());
+                m_nodes.emplace_back();
+                m_nodes[child].parent = node;
+                m_nodes[node].children[quadrant] = child;
+            }
+            node = child;
+        }
+        return node;
+    }
+
+    bool LooseQuadTree::grow(const sf::Vector2f &point)
+    {
+        if (m_depth >= MAX_DEPTH)
+        {
+            return false;
+        }
+
+        // Double the bounds toward the point; the old root becomes one of the new root's quadrants
+        bool left = point.x < m_bounds.position.x;
+        bool up = point.y < m_bounds.position.y;
+        std::uint32_t quadrant = (left ? 1u : 0u) | (up ? 2u : 0u);
+        m_bounds.position -= sf::Vector2f(left ? m_bounds.size.x : 0.f, up ? m_bounds.size.y : 0.f);
+        m_bounds.size *= 2.f;
+        ++m_depth;
+
+        // The root stays the first node: move the old one to the end. Its own
+        // items, possibly larger than it, stay in the new root
+        std::uint32_t oldRoot = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.push_back(m_nodes[0]);
+        Node &moved = m_nodes[oldRoot];
+        for (std::uint32_t child : moved.children)
+        {
+            if (child != NONE)
+            {
+                m_nodes[child].parent = oldRoot;
+            }
+        }
+        for (std::uint32_t id = moved.firstItem; id != NONE; id = m_items[id].next)
+        {
+            --moved.itemCount;
+        }
+        moved.firstItem = NONE;
+        moved.parent = 0;
+
+        Node &root = m_nodes[0];
+        root.children = {NONE, NONE, NONE, NONE};
+        root.children[quadrant] = oldRoot;
+        return true;
+    }
+
+    void LooseQuadTree::link(std::uint32_t id, std::uint32_t node)
+    {
+        Item &item = m_items[id];
+        item.node = node;
+        item.previous = NONE;
+        item.next = m_nodes[node].firstItem;
+        if (item.next != NONE)
+        {
+            m_items[item.next].previous = id;
+        }
+        m_nodes[node].firstItem = id;
+
+        for (std::uint32_t current = node; current != NONE; current = m_nodes[current].parent)
+        {
+            ++m_nodes[current].itemCount;
+        }
+    }
+
+    void LooseQuadTree::unlink(std::uint32_t id)
+    {
+        Item &item = m_items[id];
+        if (item.previous != NONE)
+        {
+            m_items[item.previous].next = item.next;
+        }
+        else
+        {
+            m_nodes[item.node].firstItem = item.next;
+        }
+        if (item.next != NONE)
+        {
+            m_items[item.next].previous = item.previous;
+        }
+
+        for (std::uint32_t current = item.node; current != NONE; current = m_nodes[current].parent)
+        {
+            --m_nodes[current].itemCount;
+        }
+        item.node = NONE;
+        item.previous = NONE;
+        item.next = NONE;
+    }
+
+    bool LooseQuadTree::intersects(const sf::FloatRect &a, const sf::FloatRect &b)
+    {
+        // Touching edges count, so that zero-sized items are still found
+        return a.position.x <= b.position.x + b.size.x && b.position.x <= a.position.x + a.size.x &&
+               a.position.y <= b.position.y + b.size.y && b.position.y <= a.position.y + a.size.y;
+    }
+
+} // namespace Core
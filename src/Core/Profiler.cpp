@@ -0,0 +1,250 @@
+#include "../../include/Core/Profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace Core
+{
+
+    namespace
+    {
+        void writeJsonString(std::ofstream &file, const char *text)
+        {
+            file << '"';
+            for (const char *c = text; *c; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                {
+                    file << '\\' << *c;
+                }
+                else if (static_cast<unsigned char>(*c) < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(*c));
+                    file << escaped;
+                }
+                else
+                {
+                    file << *c;
+                }
+            }
+            file << '"';
+        }
+    }
+
+    Profiler::ThreadBuffer::ThreadBuffer(std::uint32_t id)
+        : zones(ZONES_PER_THREAD), threadId(id)
+    {
+    }
+
+    Profiler &Profiler::getInstance()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler::Profiler()
+        : m_epoch(std::chrono::steady_clock::now()), m_enabled(true), m_droppedZones(0), m_lastFrameEnd(0), m_capturing(false)
+    {
+    }
+
+    void Profiler::setEnabled(bool enabled)
+    {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::isEnabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t Profiler::now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count();
+    }
+
+    void Profiler::recordZone(const char *name, std::int64_t startNs, std::int64_t endNs)
+    {
+        ZoneRecord zone;
+        zone.name = name;
+        zone.startNs = startNs;
+        zone.endNs = endNs;
+        if (!getThreadBuffer().zones.push(zone))
+        {
+            m_droppedZones.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void Profiler::setThreadName(const std::string &name)
+    {
+        ThreadBuffer &buffer = getThreadBuffer();
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        buffer.threadName = name;
+    }
+
+    const char *Profiler::intern(const std::string &name)
+    {
+        std::lock_guard<std::mutex> lock(m_namesMutex);
+        return m_names.insert(name).first->c_str();
+    }
+
+    void Profiler::endFrame()
+    {
+        std::int64_t frameEnd = now();
+        if (m_lastFrameEnd != 0)
+        {
+            m_frameTimes.push_back(static_cast<float>(frameEnd - m_lastFrameEnd) / 1000000.f);
+            if (m_frameTimes.size() > FRAME_WINDOW)
+            {
+                m_frameTimes.pop_front();
+            }
+        }
+        m_lastFrameEnd = frameEnd;
+
+        // Drain every thread, so that the buffers never fill up between captures
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const std::unique_ptr<ThreadBuffer> &buffer : m_threads)
+        {
+            ZoneRecord zone;
+            while (buffer->zones.pop(zone))
+            {
+                if (m_capturing)
+                {
+                    m_capture.push_back(CapturedZone{zone, buffer->threadId});
+                }
+            }
+        }
+    }
+
+    FrameTimeStats Profiler::getFrameTimeStats() const
+    {
+        FrameTimeStats stats;
+        if (m_frameTimes.empty())
+        {
+            return stats;
+        }
+
+        std::vector<float> sorted(m_frameTimes.begin(), m_frameTimes.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        auto percentile = [&sorted](float fraction)
+        {
+            return sorted[static_cast<std::size_t>(fraction * static_cast<float>(sorted.size() - 1) + 0.5f)];
+        };
+
+        float total = 0.f;
+        for (float frameTime : sorted)
+        {
+            total += frameTime;
+        }
+
+        stats.averageMs = total / static_cast<float>(sorted.size());
+        stats.p50Ms = percentile(0.5f);
+        stats.p90Ms = percentile(0.9f);
+        stats.p99Ms = percentile(0.99f);
+        stats.maxMs = sorted.back();
+        stats.frameCount = sorted.size();
+        return stats;
+    }
+
+    std::vector<float> Profiler::getFrameTimes() const
+    {
+        return std::vector<float>(m_frameTimes.begin(), m_frameTimes.end());
+    }
+
+    void Profiler::startCapture()
+    {
+        m_capture.clear();
+        m_capturing = true;
+    }
+
+    void Profiler::stopCapture()
+    {
+        m_capturing = false;
+    }
+
+    bool Profiler::isCapturing() const
+    {
+        return m_capturing;
+    }
+
+    bool Profiler::writeChromeTrace(const std::string &filepath) const
+    {
+        std::ofstream file(filepath);
+        if (!file)
+        {
+            return false;
+        }
+
+        // Complete events ("X") in microseconds; nesting is inferred from the times
+        file << "{\"traceEvents\":[\n";
+        bool first = true;
+        {
+            std::lock_guard<std::mutex> lock(m_threadsMutex);
+            for (const std::unique_ptr<ThreadBuffer> &buffer : m_threads)
+            {
+                if (buffer->threadName.empty())
+                {
+                    continue;
+                }
+                file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+                writeJsonString(file, buffer->threadName.c_str());
+                file << "}}";
+                first = false;
+            }
+        }
+
+        char times[64];
+        for (const CapturedZone &captured : m_capture)
+        {
+            file << (first ? "" : ",\n") << "{\"name\":";
+            writeJsonString(file, captured.zone.name);
+            std::snprintf(times, sizeof(times), ",\"ts\":%.3f,\"dur\":%.3f",
+                          static_cast<double>(captured.zone.startNs) / 1000.0,
+                          static_cast<double>(captured.zone.endNs - captured.zone.startNs) / 1000.0);
+            file << ",\"ph\":\"X\"" << times << ",\"pid\":1,\"tid\":" << captured.threadId << "}";
+            first = false;
+        }
+        file << "\n]}\n";
+
+        return static_cast<bool>(file);
+    }
+
+    std::uint64_t Profiler::getDroppedZoneCount() const
+    {
+        return m_droppedZones.load(std::memory_order_relaxed);
+    }
+
+    Profiler::ThreadBuffer &Profiler::getThreadBuffer()
+    {
+        thread_local ThreadBuffer *buffer = nullptr;
+        if (!buffer)
+        {
+            std::lock_guard<std::mutex> lock(m_threadsMutex);
+            m_threads.push_back(std::make_unique<ThreadBuffer>(static_cast<std::uint32_t>(m_threads.size() + 1)));
+            buffer = m_threads.back().get();
+        }
+        return *buffer;
+    }
+
+    ProfileZone::ProfileZone(const char *name)
+        : m_name(nullptr), m_start(0)
+    {
+        Profiler &profiler = Profiler::getInstance();
+        if (profiler.isEnabled())
+        {
+            m_name = name;
+            m_start = profiler.now();
+        }
+    }
+
+    ProfileZone::~ProfileZone()
+    {
+        if (m_name)
+        {
+            Profiler &profiler = Profiler::getInstance();
+            profiler.recordZone(m_name, m_start, profiler.now());
+        }
+    }
+
+} // namespace Core
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include "../../include/Core/Scene.hpp"
+#include "../../include/Core/CommandBuffer.hpp"
 
 namespace Core
 {
 
     Scene::Scene(const std::string &name)
-        : m_name(name), m_entityManager(nullptr)
+        : m_name(name), m_entityManager(nullptr), m_loaded(false), m_loadCommands(std::make_unique<CommandBuffer>())
     {
     }
 
@@ -12,6 +13,28 @@ namespace Core
     {
     }
 
+    void Scene::load()
+    {
+    }
+
+    bool Scene::capture(Graphics::RenderSnapshot &)
+    {
+        return false;
+    }
+
+    void Scene::onPause()
+    {
+    }
+
+    void Scene::onResume()
+    {
+    }
+
+    bool Scene::isOverlay() const
+    {
+        return false;
+    }
+
     const std::string &Scene::getName() const
     {
         return m_name;
@@ -27,4 +50,9 @@ namespace Core
         return m_entityManager;
     }
 
+    CommandBuffer &Scene::getLoadCommands()
+    {
+        return *m_loadCommands;
+    }
+
 } // namespace Core
\ No newline at end of file
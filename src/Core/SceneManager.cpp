@@ -0,0 +1,311 @@
+#include "../../include/Core/SceneManager.hpp"
+#include "../../include/Core/CommandBuffer.hpp"
+#include "../../include/Core/Profiler.hpp"
+#include "../../include/Core/Scene.hpp"
+#include <algorithm>
+
+namespace Core
+{
+
+    SceneManager::SceneManager(EntityManager &entityManager)
+        : m_entityManager(entityManager), m_loadRunning(false), m_stopping(false)
+    {
+        m_loader = std::thread(&SceneManager::loaderMain, this);
+    }
+
+    SceneManager::~SceneManager()
+    {
+        // The scene being loaded finishes before anything it uses goes away;
+        // the queued ones are dropped
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_loadQueue.clear();
+            m_loadedCondition.wait(lock, [this]()
+                                   { return !m_loadRunning; });
+            m_stopping = true;
+        }
+        m_loadCondition.notify_one();
+        m_loader.join();
+    }
+
+    void SceneManager::preload(std::shared_ptr<Scene> scene)
+    {
+        if (!scene)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        startLoad(scene);
+    }
+
+    void SceneManager::push(std::shared_ptr<Scene> scene)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        enqueue(OperationType::Push, std::move(scene));
+    }
+
+    void SceneManager::replace(std::shared_ptr<Scene> scene)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        enqueue(OperationType::Replace, std::move(scene));
+    }
+
+    void SceneManager::pop()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        enqueue(OperationType::Pop, nullptr);
+    }
+
+    void SceneManager::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        enqueue(OperationType::Clear, nullptr);
+    }
+
+    void SceneManager::applyPending()
+    {
+        // Take the operations that are ready, stopping at the first scene still
+        // loading so that the changes keep their order
+        std::vector<Operation> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (!m_pending.empty())
+            {
+                Operation &operation = m_pending.front();
+                if (operation.scene && !takeLoaded(operation.scene.get()))
+                {
+                    break;
+                }
+                ready.push_back(std::move(operation));
+                m_pending.pop_front();
+            }
+        }
+
+        // Applied without the lock: a scene's init() may queue further changes
+        for (Operation &operation : ready)
+        {
+            apply(operation);
+        }
+    }
+
+    void SceneManager::finishLoading()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_loadedCondition.wait(lock, [this]()
+                               { return std::all_of(m_loads.begin(), m_loads.end(), [](const Load &load)
+                                                    { return load.done; }); });
+    }
+
+    bool SceneManager::hasPending() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return !m_pending.empty();
+    }
+
+    bool SceneManager::isLoading() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::any_of(m_loads.begin(), m_loads.end(), [](const Load &load)
+                           { return !load.done; });
+    }
+
+    Scene *SceneManager::getActiveScene() const
+    {
+        return m_stack.empty() ? nullptr : m_stack.back().get();
+    }
+
+    std::size_t SceneManager::size() const
+    {
+        return m_stack.size();
+    }
+
+    bool SceneManager::empty() const
+    {
+        return m_stack.empty();
+    }
+
+    void SceneManager::update(float deltaTime)
+    {
+        if (Scene *scene = getActiveScene())
+        {
+            ORENJI_ZONE(Profiler::getInstance().intern(scene->getName() + "::update"));
+            scene->update(deltaTime);
+        }
+    }
+
+    void SceneManager::handleEvent(const sf::Event &event)
+    {
+        if (Scene *scene = getActiveScene())
+        {
+            scene->handleEvent(event);
+        }
+    }
+
+    void SceneManager::render(sf::RenderWindow &window)
+    {
+        for (std::size_t i = firstVisible(); i < m_stack.size(); ++i)
+        {
+            ORENJI_ZONE(Profiler::getInstance().intern(m_stack[i]->getName() + "::render"));
+            m_stack[i]->render(window);
+        }
+    }
+
+    bool SceneManager::capture(Graphics::RenderSnapshot &snapshot)
+    {
+        for (std::size_t i = firstVisible(); i < m_stack.size(); ++i)
+        {
+            if (!m_stack[i]->capture(snapshot))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void SceneManager::enqueue(OperationType type, std::shared_ptr<Scene> scene)
+    {
+        if (scene)
+        {
+            startLoad(scene);
+        }
+        m_pending.push_back(Operation{type, std::move(scene)});
+    }
+
+    void SceneManager::startLoad(const std::shared_ptr<Scene> &scene)
+    {
+        bool loading = std::any_of(m_loads.begin(), m_loads.end(), [&scene](const Load &load)
+                                   { return load.scene == scene; });
+        if (scene->m_loaded || loading)
+        {
+            return;
+        }
+
+        m_loads.push_back(Load{scene, false});
+        m_loadQueue.push_back(scene);
+        m_loadCondition.notify_one();
+    }
+
+    bool SceneManager::takeLoaded(const Scene *scene)
+    {
+        if (scene->m_loaded)
+        {
+            return true;
+        }
+
+        auto it = std::find_if(m_loads.begin(), m_loads.end(), [scene](const Load &load)
+                               { return load.scene.get() == scene; });
+        if (it == m_loads.end() || !it->done)
+        {
+            return false;
+        }
+
+        it->scene->m_loaded = true;
+        m_loads.erase(it);
+        return true;
+    }
+
+    void SceneManager::apply(Operation &operation)
+    {
+        switch (operation.type)
+        {
+        case OperationType::Push:
+            if (!m_stack.empty())
+            {
+                m_stack.back()->onPause();
+            }
+            m_stack.push_back(operation.scene);
+            enter(*operation.scene);
+            break;
+
+        case OperationType::Replace:
+            if (!m_stack.empty())
+            {
+                m_stack.pop_back();
+            }
+            m_stack.push_back(operation.scene);
+            enter(*operation.scene);
+            break;
+
+        case OperationType::Pop:
+            if (!m_stack.empty())
+            {
+                m_stack.pop_back();
+                if (!m_stack.empty())
+                {
+                    m_stack.back()->onResume();
+                }
+            }
+            break;
+
+        case OperationType::Clear:
+            m_stack.clear();
+            break;
+        }
+    }
+
+    void SceneManager::enter(Scene &scene)
+    {
+        if (!scene.getEntityManager())
+        {
+            scene.setEntityManager(&m_entityManager);
+        }
+
+        // Empty once applied, so a scene entering the stack again creates nothing twice
+        scene.getLoadCommands().apply(*scene.getEntityManager());
+        scene.init();
+    }
+
+    void SceneManager::loaderMain()
+    {
+        ORENJI_THREAD_NAME("Scene loader");
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_loadCondition.wait(lock, [this]()
+                                 { return !m_loadQueue.empty() || m_stopping; });
+            if (m_stopping)
+            {
+                return;
+            }
+
+            std::shared_ptr<Scene> scene = std::move(m_loadQueue.front());
+            m_loadQueue.pop_front();
+            m_loadRunning = true;
+
+            // Loaded without the lock, so that scenes can be queued meanwhile
+            lock.unlock();
+            {
+                ORENJI_ZONE(Profiler::getInstance().intern(scene->getName() + "::load"));
+                scene->load();
+            }
+            lock.lock();
+            m_loadRunning = false;
+
+            for (Load &load : m_loads)
+            {
+                if (load.scene == scene)
+                {
+                    load.done = true;
+                }
+            }
+            m_loadedCondition.notify_all();
+        }
+    }
+
+    std::size_t SceneManager::firstVisible() const
+    {
+        std::size_t first = m_stack.size();
+        while (first > 0)
+        {
+            --first;
+            if (!m_stack[first]->isOverlay())
+            {
+                break;
+            }
+        }
+        return first;
+    }
+
+} // namespace Core
\ No newline at end of file
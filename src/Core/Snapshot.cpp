@@ -0,0 +1,456 @@
+#include "../../include/Core/Snapshot.hpp"
+#include <behaviortree_cpp/contrib/json.hpp> // nlohmann::json, vendored with BehaviorTree.CPP
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace Core
+{
+
+    namespace
+    {
+        constexpr std::uint32_t makeTag(char a, char b, char c, char d)
+        {
+            return static_cast<std::uint32_t>(a) | (static_cast<std::uint32_t>(b) << 8) |
+                   (static_cast<std::uint32_t>(c) << 16) | (static_cast<std::uint32_t>(d) << 24);
+        }
+
+        constexpr std::uint32_t SNAPSHOT_MAGIC = makeTag('O', 'R', 'S', 'N');
+        constexpr std::uint32_t ENTITY_CHUNK = makeTag('E', 'N', 'T', 'S');
+        constexpr std::uint32_t COMPONENT_CHUNK = makeTag('C', 'O', 'M', 'P');
+
+        // Fixed-size entity record, so that the entity table is read in one copy
+        struct EntityRecord
+        {
+            std::uint64_t id;
+            std::uint32_t nameLength;
+            std::uint8_t active;
+            std::uint8_t padding[3];
+        };
+    }
+
+    SnapshotWriter::SnapshotWriter(std::vector<std::uint8_t> &buffer)
+        : m_buffer(&buffer), m_fields(nullptr)
+    {
+    }
+
+    SnapshotWriter::SnapshotWriter(std::vector<Field> &fields)
+        : m_buffer(nullptr), m_fields(&fields)
+    {
+    }
+
+    void SnapshotWriter::write(const char *name, std::int32_t value)
+    {
+        if (m_fields)
+            m_fields->push_back({name, static_cast<std::int64_t>(value)});
+        else
+            writeRaw(value);
+    }
+
+    void SnapshotWriter::write(const char *name, std::uint32_t value)
+    {
+        if (m_fields)
+            m_fields->push_back({name, static_cast<std::int64_t>(value)});
+        else
+            writeRaw(value);
+    }
+
+    void SnapshotWriter::write(const char *name, float value)
+    {
+        if (m_fields)
+            m_fields->push_back({name, static_cast<double>(value)});
+        else
+            writeRaw(value);
+    }
+
+    void SnapshotWriter::write(const char *name, bool value)
+    {
+        if (m_fields)
+            m_fields->push_back({name, value});
+        else
+            writeRaw(static_cast<std::uint8_t>(value ? 1 : 0));
+    }
+
+    void SnapshotWriter::write(const char *name, const std::string &value)
+    {
+        if (m_fields)
+        {
+            m_fields->push_back({name, value});
+            return;
+        }
+        writeRaw(static_cast<std::uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+    void SnapshotWriter::write(const char *name, const sf::Vector2f &value)
+    {
+        if (m_fields)
+        {
+            std::string prefix(name);
+            m_fields->push_back({prefix + ".x", static_cast<double>(value.x)});
+            m_fields->push_back({prefix + ".y", static_cast<double>(value.y)});
+            return;
+        }
+        writeRaw(value.x);
+        writeRaw(value.y);
+    }
+
+    void SnapshotWriter::write(const char *name, EntityHandle value)
+    {
+        if (m_fields)
+            m_fields->push_back({name, static_cast<std::int64_t>(value.toId())});
+        else
+            writeRaw(value.toId());
+    }
+
+    void SnapshotWriter::writeBytes(const void *data, std::size_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+        std::size_t offset = m_buffer->size();
+        m_buffer->resize(offset + size);
+        std::memcpy(m_buffer->data() + offset, data, size);
+    }
+
+    SnapshotReader::SnapshotReader(const std::uint8_t *data, std::size_t size,
+                                   const std::unordered_map<EntityId, EntityHandle> *entityMap)
+        : m_data(data), m_size(size), m_offset(0), m_failed(false), m_entityMap(entityMap)
+    {
+    }
+
+    void SnapshotReader::read(std::int32_t &value)
+    {
+        readRaw(value);
+    }
+
+    void SnapshotReader::read(std::uint32_t &value)
+    {
+        readRaw(value);
+    }
+
+    void SnapshotReader::read(float &value)
+    {
+        readRaw(value);
+    }
+
+    void SnapshotReader::read(bool &value)
+    {
+        std::uint8_t byte = value ? 1 : 0;
+        readRaw(byte);
+        value = byte != 0;
+    }
+
+    void SnapshotReader::read(std::string &value)
+    {
+        std::uint32_t length = 0;
+        readRaw(length);
+        const std::uint8_t *bytes = take(length);
+        if (bytes)
+        {
+            value.assign(reinterpret_cast<const char *>(bytes), length);
+        }
+    }
+
+    void SnapshotReader::read(sf::Vector2f &value)
+    {
+        readRaw(value.x);
+        readRaw(value.y);
+    }
+
+    void SnapshotReader::read(EntityHandle &value)
+    {
+        EntityId savedId = EntityHandle().toId();
+        readRaw(savedId);
+
+        value = EntityHandle();
+        if (m_entityMap)
+        {
+            auto it = m_entityMap->find(savedId);
+            if (it != m_entityMap->end())
+            {
+                value = it->second;
+            }
+        }
+    }
+
+    bool SnapshotReader::good() const
+    {
+        return !m_failed;
+    }
+
+    void SnapshotReader::readBytes(void *data, std::size_t size)
+    {
+        const std::uint8_t *bytes = take(size);
+        if (bytes && size > 0)
+        {
+            std::memcpy(data, bytes, size);
+        }
+    }
+
+    const std::uint8_t *SnapshotReader::take(std::size_t size)
+    {
+        if (m_failed || size > m_size - m_offset)
+        {
+            m_failed = true;
+            return nullptr;
+        }
+        const std::uint8_t *bytes = m_data + m_offset;
+        m_offset += size;
+        return bytes;
+    }
+
+    SnapshotSerializer::SnapshotSerializer()
+    {
+    }
+
+    SnapshotSerializer::~SnapshotSerializer()
+    {
+    }
+
+    std::vector<std::uint8_t> SnapshotSerializer::save(EntityManager &entityManager) const
+    {
+        std::vector<std::uint8_t> buffer;
+        SnapshotWriter writer(buffer);
+
+        writer.writeRaw(SNAPSHOT_MAGIC);
+        writer.writeRaw(VERSION);
+        writer.writeRaw(static_cast<std::uint32_t>(1 + m_serializers.size()));
+
+        // Entities are numbered in slot order; components refer to them by this ordinal
+        std::vector<Entity *> entities = entityManager.getAllEntities();
+        std::vector<std::uint32_t> ordinals;
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            unsigned int index = entities[i]->getIndex();
+            if (index >= ordinals.size())
+            {
+                ordinals.resize(index + 1, 0);
+            }
+            ordinals[index] = static_cast<std::uint32_t>(i);
+        }
+
+        // Chunks are written with a placeholder size, patched once their content is known
+        auto beginChunk = [&](std::uint32_t tag)
+        {
+            writer.writeRaw(tag);
+            writer.writeRaw(std::uint32_t(0));
+            return buffer.size();
+        };
+        auto endChunk = [&](std::size_t start)
+        {
+            std::uint32_t size = static_cast<std::uint32_t>(buffer.size() - start);
+            std::memcpy(buffer.data() + start - sizeof(std::uint32_t), &size, sizeof(size));
+        };
+
+        std::size_t chunk = beginChunk(ENTITY_CHUNK);
+        writer.writeRaw(static_cast<std::uint32_t>(entities.size()));
+        for (Entity *entity : entities)
+        {
+            EntityRecord record = {};
+            record.id = entity->getId();
+            record.nameLength = static_cast<std::uint32_t>(entity->getName().size());
+            record.active = entity->isActive() ? 1 : 0;
+            writer.writeRaw(record);
+        }
+        for (Entity *entity : entities)
+        {
+            writer.writeBytes(entity->getName().data(), entity->getName().size());
+        }
+        endChunk(chunk);
+
+        for (const ComponentSerializer &serializer : m_serializers)
+        {
+            chunk = beginChunk(COMPONENT_CHUNK);
+            writer.write("name", serializer.name);
+            serializer.save(entityManager, ordinals, writer);
+            endChunk(chunk);
+        }
+
+        return buffer;
+    }
+
+    bool SnapshotSerializer::load(EntityManager &entityManager, const std::uint8_t *data, std::size_t size) const
+    {
+        SnapshotReader reader(data, size);
+
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        std::uint32_t chunkCount = 0;
+        reader.readRaw(magic);
+        reader.readRaw(version);
+        reader.readRaw(chunkCount);
+
+        if (!reader.good() || magic != SNAPSHOT_MAGIC)
+        {
+            std::cerr << "Invalid snapshot data" << std::endl;
+            return false;
+        }
+        if (version > VERSION)
+        {
+            std::cerr << "Unsupported snapshot version: " << version << std::endl;
+            return false;
+        }
+
+        std::vector<Entity *> entities;
+        std::unordered_map<EntityId, EntityHandle> entityMap;
+        bool entitiesLoaded = false;
+
+        // Any error undoes the load: the entities created so far are removed
+        // with their components, so the entity manager is left as it was
+        auto fail = [&](const std::string &message)
+        {
+            std::cerr << message << std::endl;
+            for (Entity *entity : entities)
+            {
+                entityManager.removeEntity(entity->getHandle());
+            }
+            return false;
+        };
+
+        for (std::uint32_t i = 0; i < chunkCount; ++i)
+        {
+            std::uint32_t tag = 0;
+            std::uint32_t chunkSize = 0;
+            reader.readRaw(tag);
+            reader.readRaw(chunkSize);
+            const std::uint8_t *chunkData = reader.take(chunkSize);
+            if (!chunkData)
+            {
+                return fail("Truncated snapshot");
+            }
+
+            SnapshotReader chunkReader(chunkData, chunkSize, &entityMap);
+
+            if (tag == ENTITY_CHUNK)
+            {
+                if (!loadEntities(entityManager, chunkReader, entities, entityMap))
+                {
+                    return fail("Corrupted entity table in snapshot");
+                }
+                entitiesLoaded = true;
+            }
+            else if (tag == COMPONENT_CHUNK)
+            {
+                std::string name;
+                chunkReader.read(name);
+
+                auto it = m_serializerIndices.find(name);
+                if (it == m_serializerIndices.end())
+                {
+                    // Unknown component type: skip the chunk
+                    continue;
+                }
+
+                if (!entitiesLoaded || !m_serializers[it->second].load(entityManager, entities, chunkReader))
+                {
+                    return fail("Failed to load components: " + name);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool SnapshotSerializer::loadEntities(EntityManager &entityManager, SnapshotReader &reader,
+                                          std::vector<Entity *> &entities, std::unordered_map<EntityId, EntityHandle> &entityMap) const
+    {
+        std::uint32_t count = 0;
+        reader.readRaw(count);
+        if (!reader.good() || count > reader.m_size / sizeof(EntityRecord))
+        {
+            return false;
+        }
+
+        std::vector<EntityRecord> records(count);
+        reader.readBytes(records.data(), count * sizeof(EntityRecord));
+
+        entities.reserve(entities.size() + count);
+        entityMap.reserve(count);
+
+        for (const EntityRecord &record : records)
+        {
+            const std::uint8_t *name = reader.take(record.nameLength);
+            if (!name)
+            {
+                return false;
+            }
+
+            Entity *entity = entityManager.createEntity(std::string(reinterpret_cast<const char *>(name), record.nameLength));
+            entity->setActive(record.active != 0);
+            entities.push_back(entity);
+            entityMap[record.id] = entity->getHandle();
+        }
+
+        return reader.good();
+    }
+
+    bool SnapshotSerializer::saveToFile(EntityManager &entityManager, const std::string &filepath) const
+    {
+        std::ofstream file(filepath, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open snapshot file for writing: " << filepath << std::endl;
+            return false;
+        }
+
+        std::vector<std::uint8_t> data = save(entityManager);
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool SnapshotSerializer::loadFromFile(EntityManager &entityManager, const std::string &filepath) const
+    {
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open snapshot file: " << filepath << std::endl;
+            return false;
+        }
+
+        std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return load(entityManager, data.data(), data.size());
+    }
+
+    std::string SnapshotSerializer::exportJson(EntityManager &entityManager, int indent) const
+    {
+        nlohmann::json root;
+        root["version"] = VERSION;
+        root["entities"] = nlohmann::json::array();
+
+        std::vector<SnapshotWriter::Field> fields;
+        for (Entity *entity : entityManager.getAllEntities())
+        {
+            nlohmann::json entityJson;
+            entityJson["id"] = entity->getId();
+            entityJson["name"] = entity->getName();
+            entityJson["active"] = entity->isActive();
+            entityJson["components"] = nlohmann::json::object();
+
+            for (const ComponentSerializer &serializer : m_serializers)
+            {
+                fields.clear();
+                SnapshotWriter writer(fields);
+                if (!serializer.describe(*entity, writer))
+                {
+                    continue;
+                }
+
+                nlohmann::json componentJson = nlohmann::json::object();
+                for (const SnapshotWriter::Field &field : fields)
+                {
+                    std::visit([&](const auto &value)
+                               { componentJson[field.name] = value; },
+                               field.value);
+                }
+                entityJson["components"][serializer.name] = componentJson;
+            }
+
+            root["entities"].push_back(entityJson);
+        }
+
+        return root.dump(indent);
+    }
+
+} // namespace Core
\ No newline at end of file
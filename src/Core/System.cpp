@@ -1,10 +1,11 @@
 #include "../../include/Core/System.hpp"
+#include "../../include/Core/CommandBuffer.hpp"
 
 namespace Core
 {
 
     System::System(EntityManager &entityManager)
-        : m_entityManager(entityManager)
+        : m_entityManager(entityManager), m_exclusive(false), m_commandBuffer(std::make_unique<CommandBuffer>())
     {
     }
 
@@ -12,4 +13,44 @@ namespace Core
     {
     }
 
+    const ComponentMask &System::getReadMask() const
+    {
+        return m_readMask;
+    }
+
+    const ComponentMask &System::getWriteMask() const
+    {
+        return m_writeMask;
+    }
+
+    bool System::isExclusive() const
+    {
+        return m_exclusive;
+    }
+
+    CommandBuffer &System::getCommandBuffer()
+    {
+        return *m_commandBuffer;
+    }
+
+    TimeSlicer &System::getTimeSlicer()
+    {
+        return m_timeSlicer;
+    }
+
+    const UpdatePolicy &System::getUpdatePolicy() const
+    {
+        return m_timeSlicer.getPolicy();
+    }
+
+    void System::setExclusive(bool exclusive)
+    {
+        m_exclusive = exclusive;
+    }
+
+    void System::declareUpdatePolicy(const UpdatePolicy &policy)
+    {
+        m_timeSlicer.setPolicy(policy);
+    }
+
 } // namespace Core
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include "../../include/Core/SystemScheduler.hpp"
+#include "../../include/Core/CommandBuffer.hpp"
+#include "../../include/Core/EntityManager.hpp"
+#include "../../include/Core/JobSystem.hpp"
+#include "../../include/Core/Profiler.hpp"
+#include "../../include/Core/System.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace Core
+{
+
+    namespace
+    {
+        double nowMs()
+        {
+            using namespace std::chrono;
+            return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    SystemScheduler::SystemScheduler(EntityManager &entityManager, JobSystem &jobSystem)
+        : m_entityManager(entityManager), m_jobSystem(jobSystem), m_dirty(true), m_parallel(true), m_frameStart(0.0)
+    {
+    }
+
+    SystemScheduler::~SystemScheduler()
+    {
+    }
+
+    void SystemScheduler::addSystem(const std::string &name, System &system)
+    {
+        addTask(name, [&system](float deltaTime)
+                { system.update(deltaTime); },
+                system.getReadMask(), system.getWriteMask(), system.isExclusive());
+        m_tasks.back().system = &system;
+        m_tasks.back().interval = system.getUpdatePolicy().interval;
+    }
+
+    void SystemScheduler::addTask(const std::string &name, TaskFunction function,
+                                  const ComponentMask &readMask, const ComponentMask &writeMask,
+                                  bool exclusive)
+    {
+        Task task;
+        task.name = name;
+        task.profileName = Profiler::getInstance().intern(name);
+        task.function = std::move(function);
+        task.readMask = readMask;
+        task.writeMask = writeMask;
+        task.exclusive = exclusive;
+        task.system = nullptr;
+        task.interval = 0.f;
+        task.elapsed = 0.f;
+        m_tasks.push_back(std::move(task));
+        m_dirty = true;
+    }
+
+    bool SystemScheduler::setTaskInterval(const std::string &name, float interval)
+    {
+        for (auto &task : m_tasks)
+        {
+            if (task.name == name)
+            {
+                task.interval = std::max(interval, 0.f);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void SystemScheduler::setFocus(const sf::Vector2f &focus)
+    {
+        for (auto &task : m_tasks)
+        {
+            if (task.system)
+            {
+                task.system->getTimeSlicer().setFocus(focus);
+            }
+        }
+    }
+
+    void SystemScheduler::clear()
+    {
+        m_tasks.clear();
+        m_dirty = true;
+    }
+
+    void SystemScheduler::run(float deltaTime)
+    {
+        if (m_dirty)
+        {
+            build();
+        }
+
+        m_frameStart = nowMs();
+
+        if (m_parallel && m_jobSystem.getWorkerCount() > 0)
+        {
+            runParallel(deltaTime);
+        }
+        else
+        {
+            runSerial(deltaTime);
+        }
+
+        recordTimings();
+        applyCommandBuffers();
+    }
+
+    void SystemScheduler::setParallel(bool parallel)
+    {
+        m_parallel = parallel;
+    }
+
+    bool SystemScheduler::isParallel() const
+    {
+        return m_parallel;
+    }
+
+    const SchedulerFrameStats &SystemScheduler::getFrameStats() const
+    {
+        return m_frameStats;
+    }
+
+    bool SystemScheduler::conflicts(const Task &a, const Task &b)
+    {
+        if (a.exclusive || b.exclusive)
+        {
+            return true;
+        }
+        return (a.writeMask & (b.readMask | b.writeMask)).any() ||
+               (b.writeMask & a.readMask).any();
+    }
+
+    void SystemScheduler::build()
+    {
+        for (auto &task : m_tasks)
+        {
+            task.dependencies.clear();
+            task.dependents.clear();
+        }
+
+        // Each task waits for every earlier task it conflicts with, which
+        // keeps the registration order wherever it matters
+        for (std::size_t i = 0; i < m_tasks.size(); ++i)
+        {
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                if (conflicts(m_tasks[i], m_tasks[j]))
+                {
+                    m_tasks[i].dependencies.push_back(j);
+                    m_tasks[j].dependents.push_back(i);
+                }
+            }
+        }
+
+        m_remainingDependencies.reset(new std::atomic<int>[m_tasks.size()]);
+        m_taskStart.assign(m_tasks.size(), 0.0);
+        m_taskEnd.assign(m_tasks.size(), 0.0);
+        m_dirty = false;
+    }
+
+    void SystemScheduler::runSerial(float deltaTime)
+    {
+        for (std::size_t i = 0; i < m_tasks.size(); ++i)
+        {
+            m_taskStart[i] = nowMs();
+            runTask(i, deltaTime);
+            m_taskEnd[i] = nowMs();
+        }
+    }
+
+    void SystemScheduler::runParallel(float deltaTime)
+    {
+        for (std::size_t i = 0; i < m_tasks.size(); ++i)
+        {
+            m_remainingDependencies[i].store(static_cast<int>(m_tasks[i].dependencies.size()), std::memory_order_relaxed);
+        }
+
+        JobCounter counter;
+        for (std::size_t i = 0; i < m_tasks.size(); ++i)
+        {
+            if (m_tasks[i].dependencies.empty())
+            {
+                m_jobSystem.submit([this, i, deltaTime, &counter]
+                                   { executeTask(i, deltaTime, counter); },
+                                   &counter);
+            }
+        }
+
+        m_jobSystem.wait(counter);
+    }
+
+    void SystemScheduler::executeTask(std::size_t index, float deltaTime, JobCounter &counter)
+    {
+        m_taskStart[index] = nowMs();
+        runTask(index, deltaTime);
+        m_taskEnd[index] = nowMs();
+
+        // Release the dependents whose last dependency just finished; they
+        // are submitted before this job completes so the counter stays busy
+        for (std::size_t dependent : m_tasks[index].dependents)
+        {
+            if (m_remainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                m_jobSystem.submit([this, dependent, deltaTime, &counter]
+                                   { executeTask(dependent, deltaTime, counter); },
+                                   &counter);
+            }
+        }
+    }
+
+    void SystemScheduler::runTask(std::size_t index, float deltaTime)
+    {
+        Task &task = m_tasks[index];
+        task.elapsed += deltaTime;
+
+        // Run on the frame closest to the interval rather than the one after it
+        if (task.elapsed + 0.5f * deltaTime < task.interval)
+        {
+            return;
+        }
+
+        ORENJI_ZONE(task.profileName);
+        task.function(task.elapsed);
+        task.elapsed = 0.f;
+    }
+
+    void SystemScheduler::recordTimings()
+    {
+        SchedulerFrameStats &stats = m_frameStats;
+        stats.tasks.resize(m_tasks.size());
+        stats.totalWorkMs = 0.f;
+        stats.wallTimeMs = 0.f;
+        stats.criticalPathMs = 0.f;
+
+        // Longest chain of dependent tasks, walking the tasks in
+        // registration order which is a topological order of the graph
+        std::vector<double> chainEnd(m_tasks.size(), 0.0);
+        std::vector<std::size_t> chainPrevious(m_tasks.size(), m_tasks.size());
+        std::size_t chainLast = m_tasks.size();
+
+        for (std::size_t i = 0; i < m_tasks.size(); ++i)
+        {
+            double duration = m_taskEnd[i] - m_taskStart[i];
+            TaskTiming &timing = stats.tasks[i];
+            timing.name = m_tasks[i].name;
+            timing.startMs = static_cast<float>(m_taskStart[i] - m_frameStart);
+            timing.durationMs = static_cast<float>(duration);
+            timing.onCriticalPath = false;
+
+            stats.totalWorkMs += timing.durationMs;
+            stats.wallTimeMs = std::max(stats.wallTimeMs, static_cast<float>(m_taskEnd[i] - m_frameStart));
+
+            for (std::size_t dependency : m_tasks[i].dependencies)
+            {
+                if (chainEnd[dependency] > chainEnd[i])
+                {
+                    chainEnd[i] = chainEnd[dependency];
+                    chainPrevious[i] = dependency;
+                }
+            }
+            chainEnd[i] += duration;
+
+            if (chainLast == m_tasks.size() || chainEnd[i] > chainEnd[chainLast])
+            {
+                chainLast = i;
+            }
+        }
+
+        for (std::size_t i = chainLast; i < m_tasks.size(); i = chainPrevious[i])
+        {
+            stats.tasks[i].onCriticalPath = true;
+        }
+        if (chainLast < m_tasks.size())
+        {
+            stats.criticalPathMs = static_cast<float>(chainEnd[chainLast]);
+        }
+    }
+
+    void SystemScheduler::applyCommandBuffers()
+    {
+        for (auto &task : m_tasks)
+        {
+            if (task.system)
+            {
+                task.system->getCommandBuffer().apply(m_entityManager);
+            }
+        }
+        m_entityManager.compactViews();
+    }
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "../../include/Core/TimeSlicer.hpp"
+#include "../../include/Core/Entity.hpp"
+#include "../../include/Core/TransformComponent.hpp"
+#include <algorithm>
+
+namespace Core
+{
+
+    namespace
+    {
+        // Reading the clock for every entity would cost more than small updates
+        const std::size_t BUDGET_CHECK_INTERVAL = 8;
+    }
+
+    TimeSlicer::TimeSlicer()
+        : m_focus(0.f, 0.f), m_farHoles(0), m_frame(0), m_cursor(0), m_updatedCount(0), m_deferredCount(0)
+    {
+    }
+
+    void TimeSlicer::setPolicy(const UpdatePolicy &policy)
+    {
+        m_policy = policy;
+
+        // The near radius may have changed: start over from unplaced entities
+        m_nearEntities.clear();
+        m_farEntities.clear();
+        m_joiningFar.clear();
+        m_farHoles = 0;
+        for (EntityState &state : m_states)
+        {
+            state.placement = Placement::None;
+        }
+    }
+
+    const UpdatePolicy &TimeSlicer::getPolicy() const
+    {
+        return m_policy;
+    }
+
+    void TimeSlicer::setFocus(const sf::Vector2f &focus)
+    {
+        m_focus = focus;
+    }
+
+    std::size_t TimeSlicer::getUpdatedCount() const
+    {
+        return m_updatedCount;
+    }
+
+    std::size_t TimeSlicer::getDeferredCount() const
+    {
+        return m_deferredCount;
+    }
+
+    bool TimeSlicer::isLimited() const
+    {
+        return m_policy.budgetMs > 0.f || m_policy.maxEntities > 0;
+    }
+
+    bool TimeSlicer::isNear(Entity &entity) const
+    {
+        if (m_policy.nearRadius <= 0.f)
+        {
+            return false;
+        }
+
+        // Entities without a position are never near
+        const TransformComponent *transform = entity.getComponent<TransformComponent>();
+        if (!transform)
+        {
+            return false;
+        }
+
+        sf::Vector2f offset = transform->getWorldPosition() - m_focus;
+        return offset.x * offset.x + offset.y * offset.y <= m_policy.nearRadius * m_policy.nearRadius;
+    }
+
+    TimeSlicer::EntityState &TimeSlicer::accumulate(const Entity &entity, float deltaTime)
+    {
+        EntityHandle handle = entity.getHandle();
+        if (handle.index >= m_states.size())
+        {
+            m_states.resize(handle.index + 1);
+        }
+
+        // A recycled slot starts over with the time of this frame
+        EntityState &state = m_states[handle.index];
+        if (state.generation != handle.generation)
+        {
+            state = EntityState();
+            state.generation = handle.generation;
+        }
+        state.elapsed += deltaTime;
+        state.frame = m_frame;
+        return state;
+    }
+
+    bool TimeSlicer::isCurrent(const Entry &entry) const
+    {
+        // Entities removed or left out of this update's range are dropped
+        // without touching the pointer
+        const EntityState &state = m_states[entry.handle.index];
+        return state.generation == entry.handle.generation && state.frame == m_frame;
+    }
+
+    void TimeSlicer::place(const Entry &entry, Placement placement)
+    {
+        EntityState &state = m_states[entry.handle.index];
+        if (state.generation != entry.handle.generation)
+        {
+            // The slot went to another entity, which keeps its own placement
+            return;
+        }
+
+        state.placement = placement;
+        if (placement == Placement::Near)
+        {
+            m_nearEntities.push_back(entry);
+        }
+        else if (placement == Placement::Far)
+        {
+            m_joiningFar.push_back(entry);
+        }
+    }
+
+    TimeSlicer::Entry TimeSlicer::makeEntry(Entity &entity)
+    {
+        return Entry{&entity, entity.getHandle()};
+    }
+
+    bool TimeSlicer::isOverTime(Clock::time_point start, std::size_t count) const
+    {
+        if (m_policy.budgetMs > 0.f && count % BUDGET_CHECK_INTERVAL == 0)
+        {
+            return std::chrono::duration<float, std::milli>(Clock::now() - start).count() >= m_policy.budgetMs;
+        }
+        return false;
+    }
+
+    bool TimeSlicer::isOverBudget(Clock::time_point start, std::size_t farUpdated) const
+    {
+        if (m_policy.maxEntities > 0 && farUpdated >= m_policy.maxEntities)
+        {
+            return true;
+        }
+        return isOverTime(start, farUpdated);
+    }
+
+    std::size_t TimeSlicer::mergeFarEntities()
+    {
+        auto bySlot = [](const Entry &a, const Entry &b)
+        {
+            return a.handle.index < b.handle.index;
+        };
+
+        // Only the entities that went far this frame are sorted. The holes
+        // are dropped with each merge, or once they make up half of the set
+        if (!m_joiningFar.empty() || m_farHoles * 2 > m_farEntities.size())
+        {
+            m_farEntities.erase(std::remove_if(m_farEntities.begin(), m_farEntities.end(), [](const Entry &entry)
+                                               { return entry.entity == nullptr; }),
+                                m_farEntities.end());
+            m_farHoles = 0;
+
+            std::sort(m_joiningFar.begin(), m_joiningFar.end(), bySlot);
+            std::size_t middle = m_farEntities.size();
+            m_farEntities.insert(m_farEntities.end(), m_joiningFar.begin(), m_joiningFar.end());
+            std::inplace_merge(m_farEntities.begin(), m_farEntities.begin() + middle, m_farEntities.end(), bySlot);
+            m_joiningFar.clear();
+        }
+
+        // The turn is kept as an entity slot, so that creations and removals do not skip anyone
+        auto first = std::lower_bound(m_farEntities.begin(), m_farEntities.end(), m_cursor,
+                                      [](const Entry &entry, std::uint32_t slot)
+                                      { return entry.handle.index < slot; });
+        return static_cast<std::size_t>(first - m_farEntities.begin());
+    }
+
+} // namespace Core
@@ -0,0 +1,145 @@
+#include "../../include/Core/TransformComponent.hpp"
+#include "../../include/Core/Snapshot.hpp"
+#include <cmath>
+
+namespace Core
+{
+
+    TransformComponent::TransformComponent(const sf::Vector2f &position, float rotation, const sf::Vector2f &scale)
+        : m_position(position), m_rotation(rotation), m_scale(scale), m_worldRotation(rotation), m_worldScale(scale), m_hasWorldTransform(false), m_previousWorldPosition(position), m_previousWorldRotation(rotation), m_previousWorldScale(scale), m_parentIndex(NO_PARENT), m_depth(0), m_dirty(true), m_worldChanged(false)
+    {
+    }
+
+    void TransformComponent::setPosition(const sf::Vector2f &position)
+    {
+        // Only a real change dirties the subtree, so that unchanged bodies cost nothing to propagate
+        if (position != m_position)
+        {
+            m_position = position;
+            m_dirty = true;
+        }
+    }
+
+    const sf::Vector2f &TransformComponent::getPosition() const
+    {
+        return m_position;
+    }
+
+    void TransformComponent::move(const sf::Vector2f &offset)
+    {
+        setPosition(m_position + offset);
+    }
+
+    void TransformComponent::setRotation(float rotation)
+    {
+        if (rotation != m_rotation)
+        {
+            m_rotation = rotation;
+            m_dirty = true;
+        }
+    }
+
+    float TransformComponent::getRotation() const
+    {
+        return m_rotation;
+    }
+
+    void TransformComponent::rotate(float angle)
+    {
+        setRotation(m_rotation + angle);
+    }
+
+    void TransformComponent::setScale(const sf::Vector2f &scale)
+    {
+        if (scale != m_scale)
+        {
+            m_scale = scale;
+            m_dirty = true;
+        }
+    }
+
+    const sf::Vector2f &TransformComponent::getScale() const
+    {
+        return m_scale;
+    }
+
+    sf::Transform TransformComponent::getLocalTransform() const
+    {
+        sf::Transform transform;
+        transform.translate(m_position).rotate(sf::degrees(m_rotation)).scale(m_scale);
+        return transform;
+    }
+
+    const sf::Transform &TransformComponent::getWorldTransform() const
+    {
+        return m_worldTransform;
+    }
+
+    sf::Transform TransformComponent::getInterpolatedTransform(float alpha) const
+    {
+        if (alpha >= 1.f)
+        {
+            return m_worldTransform;
+        }
+
+        // Turn by at most half a revolution, whatever the angles accumulated
+        float turn = std::remainder(m_worldRotation - m_previousWorldRotation, 360.f);
+
+        sf::Transform transform;
+        transform.translate(m_previousWorldPosition + (getWorldPosition() - m_previousWorldPosition) * alpha)
+            .rotate(sf::degrees(m_previousWorldRotation + turn * alpha))
+            .scale(m_previousWorldScale + (m_worldScale - m_previousWorldScale) * alpha);
+        return transform;
+    }
+
+    void TransformComponent::keepPreviousWorld()
+    {
+        m_previousWorldPosition = getWorldPosition();
+        m_previousWorldRotation = m_worldRotation;
+        m_previousWorldScale = m_worldScale;
+    }
+
+    sf::Vector2f TransformComponent::getWorldPosition() const
+    {
+        return m_worldTransform.transformPoint(sf::Vector2f(0.f, 0.f));
+    }
+
+    float TransformComponent::getWorldRotation() const
+    {
+        return m_worldRotation;
+    }
+
+    EntityHandle TransformComponent::getParent() const
+    {
+        return m_parent;
+    }
+
+    std::uint32_t TransformComponent::getDepth() const
+    {
+        return m_depth;
+    }
+
+    bool TransformComponent::isDirty() const
+    {
+        return m_dirty;
+    }
+
+    void TransformComponent::save(SnapshotWriter &writer) const
+    {
+        writer.write("position", m_position);
+        writer.write("rotation", m_rotation);
+        writer.write("scale", m_scale);
+        writer.write("parent", m_parent);
+    }
+
+    void TransformComponent::load(SnapshotReader &reader)
+    {
+        // The TransformSystem picks up the parent link on its next propagation
+        reader.read(m_position);
+        reader.read(m_rotation);
+        reader.read(m_scale);
+        reader.read(m_parent);
+        m_dirty = true;
+    }
+
+} // namespace Core
\ No newline at end of file
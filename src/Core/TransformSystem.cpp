@@ -0,0 +1,208 @@
+#include "../../include/Core/TransformSystem.hpp"
+#include "../../include/Core/EntityManager.hpp"
+#include "../../include/Core/TransformComponent.hpp"
+#include <vector>
+
+namespace Core
+{
+
+    TransformSystem::TransformSystem(EntityManager &entityManager)
+        : System(entityManager), m_hierarchyDirty(true), m_lastTick(0), m_knownCount(0)
+    {
+        declareWrite<TransformComponent>();
+    }
+
+    TransformSystem::~TransformSystem()
+    {
+    }
+
+    void TransformSystem::init()
+    {
+    }
+
+    void TransformSystem::update(float)
+    {
+        propagate();
+    }
+
+    bool TransformSystem::setParent(Entity &child, Entity *parent)
+    {
+        TransformComponent *childTransform = child.getComponent<TransformComponent>();
+        if (!childTransform)
+        {
+            return false;
+        }
+
+        if (!parent)
+        {
+            childTransform->m_parent = EntityHandle();
+        }
+        else
+        {
+            if (!parent->getComponent<TransformComponent>())
+            {
+                return false;
+            }
+
+            // Refuse to attach an entity below one of its own descendants
+            for (Entity *ancestor = parent; ancestor;)
+            {
+                if (ancestor == &child)
+                {
+                    return false;
+                }
+                ancestor = m_entityManager.getEntity(ancestor->getComponent<TransformComponent>()->m_parent);
+            }
+
+            childTransform->m_parent = parent->getHandle();
+        }
+
+        childTransform->m_dirty = true;
+        m_hierarchyDirty = true;
+        return true;
+    }
+
+    void TransformSystem::propagate()
+    {
+        // A removal relocates the last transform of the pool and breaks the depth order
+        m_entityManager.forEachRemoved<TransformComponent>(m_lastTick, [this](EntityId)
+                                                           { m_hierarchyDirty = true; });
+        m_lastTick = m_entityManager.getCurrentTick();
+
+        ComponentPool<TransformComponent> &pool = m_entityManager.getComponentPool<TransformComponent>();
+
+        // Transforms added with a parent link have not been placed in the hierarchy yet
+        for (std::size_t i = m_knownCount; !m_hierarchyDirty && i < pool.size(); ++i)
+        {
+            const TransformComponent &transform = pool.at(i);
+            if (transform.m_parent.isValid() && transform.m_parentIndex == TransformComponent::NO_PARENT)
+            {
+                m_hierarchyDirty = true;
+            }
+        }
+
+        if (m_hierarchyDirty)
+        {
+            rebuildHierarchy();
+        }
+
+        for (std::size_t i = 0; i < pool.size(); ++i)
+        {
+            TransformComponent &transform = pool.at(i);
+            const TransformComponent *parent = transform.m_parentIndex != TransformComponent::NO_PARENT ? &pool.at(transform.m_parentIndex) : nullptr;
+
+            if (!transform.m_dirty && !(parent && parent->m_worldChanged))
+            {
+                // At rest: stop interpolating from the state before the last move
+                if (transform.m_worldChanged)
+                {
+                    transform.keepPreviousWorld();
+                    transform.m_worldChanged = false;
+                }
+                continue;
+            }
+
+            transform.keepPreviousWorld();
+            if (parent)
+            {
+                transform.m_worldTransform = parent->m_worldTransform * transform.getLocalTransform();
+                transform.m_worldRotation = parent->m_worldRotation + transform.m_rotation;
+                transform.m_worldScale = sf::Vector2f(parent->m_worldScale.x * transform.m_scale.x,
+                                                      parent->m_worldScale.y * transform.m_scale.y);
+            }
+            else
+            {
+                transform.m_worldTransform = transform.getLocalTransform();
+                transform.m_worldRotation = transform.m_rotation;
+                transform.m_worldScale = transform.m_scale;
+            }
+
+            // A new transform appears in place instead of sliding in from the origin
+            if (!transform.m_hasWorldTransform)
+            {
+                transform.keepPreviousWorld();
+                transform.m_hasWorldTransform = true;
+            }
+
+            transform.m_dirty = false;
+            transform.m_worldChanged = true;
+            pool.markChanged(pool.entityAt(i));
+        }
+
+        m_knownCount = pool.size();
+    }
+
+    void TransformSystem::rebuildHierarchy()
+    {
+        ComponentPool<TransformComponent> &pool = m_entityManager.getComponentPool<TransformComponent>();
+        std::size_t count = pool.size();
+
+        // Resolve the parent of each transform to a dense index
+        std::vector<std::size_t> parentIndices(count, TransformComponent::NO_PARENT);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            TransformComponent &transform = pool.at(i);
+            if (!transform.m_parent.isValid())
+            {
+                continue;
+            }
+
+            Entity *parent = m_entityManager.getEntity(transform.m_parent);
+            if (parent && pool.contains(parent->getIndex()))
+            {
+                parentIndices[i] = pool.indexOf(parent->getIndex());
+            }
+            else
+            {
+                // The parent is gone: become a root
+                transform.m_parent = EntityHandle();
+                transform.m_dirty = true;
+            }
+        }
+
+        // Compute the depths, walking up each chain until a known depth
+        const std::uint32_t unknown = static_cast<std::uint32_t>(-1);
+        std::vector<std::uint32_t> depths(count, unknown);
+        std::vector<std::size_t> chain;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t current = i;
+            while (depths[current] == unknown && parentIndices[current] != TransformComponent::NO_PARENT)
+            {
+                chain.push_back(current);
+                current = parentIndices[current];
+            }
+
+            std::uint32_t depth = depths[current] == unknown ? 0 : depths[current];
+            depths[current] = depth;
+            while (!chain.empty())
+            {
+                depths[chain.back()] = ++depth;
+                chain.pop_back();
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            pool.at(i).m_depth = depths[i];
+        }
+
+        pool.sort([](const TransformComponent &a, const TransformComponent &b)
+                  { return a.m_depth < b.m_depth; });
+
+        // Dense indices moved with the sort: resolve the parents again
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            TransformComponent &transform = pool.at(i);
+            transform.m_parentIndex = TransformComponent::NO_PARENT;
+            if (transform.m_parent.isValid())
+            {
+                Entity *parent = m_entityManager.getEntity(transform.m_parent);
+                transform.m_parentIndex = pool.indexOf(parent->getIndex());
+            }
+        }
+
+        m_hierarchyDirty = false;
+    }
+
+} // namespace Core
\ No newline at end of file
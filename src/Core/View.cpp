@@ -0,0 +1,146 @@
+#include "../../include/Core/View.hpp"
+#include "../../include/Core/Entity.hpp"
+
+namespace Core
+{
+
+    EntityView::Iterator::Iterator(const std::vector<Entity *> &entities, std::size_t index)
+        : m_entities(&entities), m_index(index)
+    {
+        skipInvalid();
+    }
+
+    Entity *EntityView::Iterator::operator*() const
+    {
+        return (*m_entities)[m_index];
+    }
+
+    EntityView::Iterator &EntityView::Iterator::operator++()
+    {
+        ++m_index;
+        skipInvalid();
+        return *this;
+    }
+
+    bool EntityView::Iterator::operator==(const Iterator &other) const
+    {
+        return m_index == other.m_index;
+    }
+
+    bool EntityView::Iterator::operator!=(const Iterator &other) const
+    {
+        return m_index != other.m_index;
+    }
+
+    void EntityView::Iterator::skipInvalid()
+    {
+        // Skip holes left by removed entities as well as inactive entities
+        while (m_index < m_entities->size())
+        {
+            Entity *entity = (*m_entities)[m_index];
+            if (entity && entity->isActive())
+            {
+                break;
+            }
+            ++m_index;
+        }
+    }
+
+    EntityView::EntityView(const ComponentMask &mask)
+        : m_mask(mask), m_holes(0)
+    {
+    }
+
+    EntityView::Iterator EntityView::begin() const
+    {
+        return Iterator(m_entities, 0);
+    }
+
+    EntityView::Iterator EntityView::end() const
+    {
+        return Iterator(m_entities, m_entities.size());
+    }
+
+    std::size_t EntityView::size() const
+    {
+        return m_entities.size() - m_holes;
+    }
+
+    bool EntityView::empty() const
+    {
+        return size() == 0;
+    }
+
+    bool EntityView::contains(const Entity &entity) const
+    {
+        unsigned int index = entity.getIndex();
+        return index < m_positions.size() && m_positions[index] != INVALID_POSITION;
+    }
+
+    const ComponentMask &EntityView::getMask() const
+    {
+        return m_mask;
+    }
+
+    void EntityView::onMaskChanged(Entity &entity, const ComponentMask &oldMask, const ComponentMask &newMask)
+    {
+        bool wasMatching = (oldMask & m_mask) == m_mask;
+        bool isMatching = (newMask & m_mask) == m_mask;
+
+        if (isMatching && !wasMatching)
+        {
+            insert(entity);
+        }
+        else if (wasMatching && !isMatching)
+        {
+            erase(entity);
+        }
+    }
+
+    void EntityView::insert(Entity &entity)
+    {
+        unsigned int index = entity.getIndex();
+        if (index >= m_positions.size())
+        {
+            m_positions.resize(index + 1, INVALID_POSITION);
+        }
+        m_positions[index] = static_cast<std::uint32_t>(m_entities.size());
+        m_entities.push_back(&entity);
+    }
+
+    void EntityView::erase(const Entity &entity)
+    {
+        if (!contains(entity))
+        {
+            return;
+        }
+
+        // Leave a hole to preserve the iteration order of the other entities
+        unsigned int index = entity.getIndex();
+        m_entities[m_positions[index]] = nullptr;
+        m_positions[index] = INVALID_POSITION;
+        ++m_holes;
+    }
+
+    void EntityView::compact()
+    {
+        if (m_holes == 0)
+        {
+            return;
+        }
+
+        std::size_t write = 0;
+        for (std::size_t read = 0; read < m_entities.size(); ++read)
+        {
+            Entity *entity = m_entities[read];
+            if (entity)
+            {
+                m_positions[entity->getIndex()] = static_cast<std::uint32_t>(write);
+                m_entities[write++] = entity;
+            }
+        }
+        m_entities.resize(write);
+        m_holes = 0;
+    }
+
+} // namespace Core
\ No newline at end of file
@@ -1,16 +1,31 @@
 #include "../include/Engine.hpp"
 #include "../include/Physics/PhysicsSystem.hpp"
+#include "../include/Graphics/ProfilerOverlay.hpp"
+#include "../include/Graphics/RenderSnapshot.hpp"
 #include "../include/Graphics/RenderSystem.hpp"
 #include "../include/AI/AISystem.hpp"
 #include "../include/UI/UIManager.hpp"
 #include "../include/Resources/TiledMapLoader.hpp"
-
+#include "../include/Core/FrameArena.hpp"
+#include "../include/Core/FramePacer.hpp"
+#include "../include/Core/InputQueue.hpp"
+#include "../include/Core/JobSystem.hpp"
+#include "../include/Core/Profiler.hpp"
+#include "../include/Core/SceneManager.hpp"
+#include "../include/Core/SystemScheduler.hpp"
+#include "../include/Core/TransformSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
 #include <iostream>
 
 namespace Core
 {
     Engine::Engine(const std::string &title, int width, int height)
-        : m_title(title), m_width(width), m_height(height)
+        : m_title(title), m_width(width), m_height(height), m_deltaTime(0.f), m_fixedTimeStep(1.f / 60.f), m_accumulator(0.f), m_maxCatchUpSteps(5), m_fixedTimestepEnabled(true), m_pipelineEnabled(false), m_headless(false), m_interpolation(1.f)
     {
         std::cout << "Engine created" << std::endl;
     }
@@ -21,12 +36,16 @@ namespace Core
         std::cout << "Engine destroyed" << std::endl;
     }
 
-    bool Engine::initialize()
+    bool Engine::initialize(bool headless)
     {
+        m_headless = headless;
+
         // Create window
-        m_window.create(sf::VideoMode(sf::Vector2u(m_width, m_height)),
-                        m_title, sf::Style::Close);
-        m_window.setFramerateLimit(60);
+        if (!m_headless)
+        {
+            m_window.create(sf::VideoMode(sf::Vector2u(m_width, m_height)),
+                            m_title, sf::Style::Close);
+        }
 
         // Initialize resource manager
         m_resourceManager = std::make_unique<Resources::ResourceManager>();
@@ -34,11 +53,47 @@ namespace Core
         // Initialize entity manager
         m_entityManager = std::make_unique<Core::EntityManager>();
 
+        // Initialize input queue
+        m_inputQueue = std::make_unique<Core::InputQueue>();
+
+        // The frame pacer limits the frame rate, 60 FPS by default
+        m_framePacer = std::make_unique<Core::FramePacer>(60.f);
+
         // Initialize physics system
         m_physicsSystem = std::make_unique<Physics::PhysicsSystem>(*m_entityManager);
-        m_renderSystem = std::make_unique<Graphics::RenderSystem>(*m_entityManager, m_window);
+        m_transformSystem = std::make_unique<Core::TransformSystem>(*m_entityManager);
         m_aiSystem = std::make_unique<AI::AISystem>(*m_entityManager);
-        m_uiManager = std::make_unique<UI::UIManager>(m_window);
+
+        // Rendering and UI need a window
+        if (!m_headless)
+        {
+            m_renderSystem = std::make_unique<Graphics::RenderSystem>(*m_entityManager, m_window);
+            m_uiManager = std::make_unique<UI::UIManager>(m_window);
+        }
+
+        // Schedule the updates; the scheduler orders the systems by their
+        // component access, the scene may touch anything. The UI is updated
+        // on the main thread, once per frame, since it is drawn there.
+        //
+        // With the current systems this is a single chain: Physics writes
+        // the transforms, the TransformSystem rewrites them and the AI reads
+        // them, so each waits for the previous one and nothing overlaps.
+        // Only systems added later with disjoint access run concurrently
+        m_jobSystem = std::make_unique<Core::JobSystem>();
+        m_simulationCounter = std::make_unique<Core::JobCounter>();
+        m_sceneManager = std::make_unique<Core::SceneManager>(*m_entityManager);
+        m_scheduler = std::make_unique<Core::SystemScheduler>(*m_entityManager, *m_jobSystem);
+        m_scheduler->addSystem("Physics", *m_physicsSystem);
+        m_scheduler->addSystem("Transform", *m_transformSystem);
+        m_scheduler->addSystem("AI", *m_aiSystem);
+        m_scheduler->addTask("Scene", [this](float deltaTime)
+                             { m_sceneManager->update(deltaTime); }, Core::ComponentMask(), Core::ComponentMask(), true);
+
+        // Let the frame pacer scale the systems down when frames run over budget
+        addQualityKnobs();
+
+        // Frames captured for pipelined rendering
+        m_renderSnapshot = std::make_unique<Graphics::RenderSnapshot>();
 
         // Initialize TiledMapLoader
         m_tiledMapLoader = std::make_unique<Resources::TiledMapLoader>(*m_resourceManager);
@@ -48,17 +103,28 @@ namespace Core
 
     void Engine::run()
     {
-        if (!m_currentScene)
+        if (m_headless)
+        {
+            std::cerr << "Engine is headless, use runHeadless() to step the simulation" << std::endl;
+            return;
+        }
+
+        if (m_sceneManager->empty() && !m_sceneManager->hasPending())
         {
             std::cerr << "No scene set, cannot run engine!" << std::endl;
             return;
         }
 
+        ORENJI_THREAD_NAME("Main");
+
         // Initialize time tracking
         m_clock.restart();
+        m_accumulator = 0.f;
 
         while (m_window.isOpen())
         {
+            m_framePacer->beginFrame();
+
             // Calculate delta time
             m_deltaTime = m_clock.restart().asSeconds();
 
@@ -70,20 +136,131 @@ namespace Core
 
             processEvents();
 
-            update(m_deltaTime);
+            if (m_pipelineEnabled)
+            {
+                runPipelinedFrame();
+            }
+            else
+            {
+                m_sceneManager->applyPending();
+                dispatchInput();
+                m_uiManager->update(m_deltaTime);
+                updateFocus();
+                simulate(m_deltaTime);
+
+                // Draw between the last two simulated states
+                render(m_interpolation);
+                pruneRemovals();
+
+                // The frame is over: its transient memory can be reused, and
+                // the systems are idle to apply the last quality decision
+                m_framePacer->applyQuality();
+                FrameArena::nextFrame();
+            }
+
+            m_framePacer->endFrame();
+            ORENJI_FRAME_MARK();
+            m_framePacer->waitForNextFrame();
+        }
+
+        waitForSimulation();
+    }
+
+    HeadlessRunStats Engine::runHeadless(int ticks)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        HeadlessRunStats stats;
+        waitForSimulation();
+
+        // Start with the scenes set up; loading them is not part of the measure
+        m_sceneManager->finishLoading();
+        m_sceneManager->applyPending();
+
+        Clock::time_point runStart = Clock::now();
+        for (int tick = 0; tick < ticks; ++tick)
+        {
+            Clock::time_point tickStart = Clock::now();
+            m_sceneManager->applyPending();
+            update(m_fixedTimeStep);
+            pruneRemovals();
+            FrameArena::nextFrame();
+            double tickMs = std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count();
+            stats.maxTickMs = std::max(stats.maxTickMs, tickMs);
+
+            // Accumulate the scheduler's timings per system
+            for (const TaskTiming &timing : m_scheduler->getFrameStats().tasks)
+            {
+                auto it = std::find_if(stats.systems.begin(), stats.systems.end(), [&timing](const SystemBenchmark &system)
+                                       { return system.name == timing.name; });
+                if (it == stats.systems.end())
+                {
+                    stats.systems.push_back(SystemBenchmark());
+                    stats.systems.back().name = timing.name;
+                    it = stats.systems.end() - 1;
+                }
+                it->totalMs += timing.durationMs;
+                it->maxMs = std::max(it->maxMs, static_cast<double>(timing.durationMs));
+            }
 
-            render();
+            ORENJI_FRAME_MARK();
         }
+
+        stats.ticks = ticks;
+        stats.wallTimeMs = std::chrono::duration<double, std::milli>(Clock::now() - runStart).count();
+        if (ticks > 0)
+        {
+            stats.averageTickMs = stats.wallTimeMs / ticks;
+            for (SystemBenchmark &system : stats.systems)
+            {
+                system.averageMs = system.totalMs / ticks;
+            }
+        }
+        if (stats.wallTimeMs > 0.0)
+        {
+            stats.ticksPerSecond = ticks * 1000.0 / stats.wallTimeMs;
+        }
+
+        std::ios::fmtflags flags = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Headless run: " << stats.ticks << " ticks in " << stats.wallTimeMs << " ms ("
+                  << stats.ticksPerSecond << " ticks/s, max " << stats.maxTickMs << " ms)" << std::endl;
+        for (const SystemBenchmark &system : stats.systems)
+        {
+            std::cout << "  " << std::left << std::setw(16) << system.name << std::right
+                      << " avg " << system.averageMs << " ms, max " << system.maxMs << " ms" << std::endl;
+        }
+        std::cout.flags(flags);
+        std::cout.precision(precision);
+
+        return stats;
+    }
+
+    bool Engine::isHeadless() const
+    {
+        return m_headless;
     }
 
     void Engine::shutdown()
     {
+        waitForSimulation();
+
+        m_sceneManager.reset();
         m_tiledMapLoader.reset();
+        m_scheduler.reset();
+        m_simulationCounter.reset();
+        m_jobSystem.reset();
+        m_framePacer.reset();
+        m_renderSnapshot.reset();
+        m_profilerOverlay.reset();
         m_uiManager.reset();
         m_aiSystem.reset();
         m_renderSystem.reset();
+        m_transformSystem.reset();
         m_physicsSystem.reset();
         m_entityManager.reset();
+        m_inputQueue.reset();
         m_resourceManager.reset();
 
         if (m_window.isOpen())
@@ -104,17 +281,123 @@ namespace Core
 
     void Engine::setScene(std::shared_ptr<Core::Scene> scene)
     {
-        m_currentScene = scene;
-        if (m_currentScene)
+        m_sceneManager->clear();
+        if (scene)
+        {
+            m_sceneManager->push(scene);
+        }
+    }
+
+    Core::SceneManager &Engine::getSceneManager()
+    {
+        return *m_sceneManager;
+    }
+
+    void Engine::setTickRate(float ticksPerSecond)
+    {
+        if (ticksPerSecond > 0.f)
+        {
+            m_fixedTimeStep = 1.f / ticksPerSecond;
+        }
+    }
+
+    float Engine::getTickRate() const
+    {
+        return 1.f / m_fixedTimeStep;
+    }
+
+    void Engine::setMaxCatchUpSteps(int steps)
+    {
+        m_maxCatchUpSteps = steps > 0 ? steps : 1;
+    }
+
+    void Engine::setFixedTimestepEnabled(bool enabled)
+    {
+        m_fixedTimestepEnabled = enabled;
+        m_accumulator = 0.f;
+    }
+
+    bool Engine::isFixedTimestepEnabled() const
+    {
+        return m_fixedTimestepEnabled;
+    }
+
+    void Engine::setFramerateLimit(unsigned int limit)
+    {
+        if (!m_framePacer)
+        {
+            return;
+        }
+
+        if (limit > 0)
+        {
+            m_framePacer->setTargetFramerate(static_cast<float>(limit));
+        }
+        m_framePacer->setFrameLimitEnabled(limit > 0);
+    }
+
+    void Engine::setVerticalSyncEnabled(bool enabled)
+    {
+        m_window.setVerticalSyncEnabled(enabled);
+    }
+
+    void Engine::setPipelineEnabled(bool enabled)
+    {
+        if (!enabled)
+        {
+            waitForSimulation();
+        }
+        m_pipelineEnabled = enabled;
+    }
+
+    bool Engine::isPipelineEnabled() const
+    {
+        return m_pipelineEnabled;
+    }
+
+    void Engine::setProfilerOverlay(const sf::Font *font)
+    {
+        if (font)
         {
-            m_currentScene->init();
+            m_profilerOverlay = std::make_unique<Graphics::ProfilerOverlay>(*font);
         }
+        else
+        {
+            m_profilerOverlay.reset();
+        }
+    }
+
+    Core::FramePacer &Engine::getFramePacer()
+    {
+        return *m_framePacer;
+    }
+
+    Core::JobSystem &Engine::getJobSystem()
+    {
+        return *m_jobSystem;
+    }
+
+    Core::SystemScheduler &Engine::getScheduler()
+    {
+        return *m_scheduler;
+    }
+
+    Core::TransformSystem &Engine::getTransformSystem()
+    {
+        return *m_transformSystem;
+    }
+
+    Core::InputQueue &Engine::getInputQueue()
+    {
+        return *m_inputQueue;
     }
 
     void Engine::processEvents()
     {
-        // Process window events
-        if (auto event = m_window.pollEvent())
+        ORENJI_ZONE("Engine::processEvents");
+
+        // Drain every pending window event, so that input never lags behind by whole frames
+        while (const std::optional event = m_window.pollEvent())
         {
             // Check for window close event
             if (event->is<sf::Event::Closed>())
@@ -133,57 +416,220 @@ namespace Core
                 }
             }
 
+            if (!m_inputQueue->push(*event))
+            {
+                std::cerr << "Input queue full, event dropped" << std::endl;
+            }
+        }
+    }
+
+    void Engine::dispatchInput()
+    {
+        Core::InputEvent input;
+        while (m_inputQueue->pop(input))
+        {
             // Pass event to UI manager first
-            if (m_uiManager->handleEvent(*event))
+            if (m_uiManager->handleEvent(input.event))
             {
                 // UI consumed the event, don't pass to scene
-                return;
+                continue;
             }
 
             // Pass event to current scene
-            if (m_currentScene)
-            {
-                m_currentScene->handleEvent(*event);
-            }
+            m_sceneManager->handleEvent(input.event);
         }
     }
 
-    void Engine::update(float deltaTime)
+    void Engine::simulate(float frameTime)
     {
-        // Update physics
-        m_physicsSystem->update(deltaTime);
+        ORENJI_ZONE("Engine::simulate");
 
-        // Update AI
-        m_aiSystem->update(deltaTime);
+        if (!m_fixedTimestepEnabled)
+        {
+            update(frameTime);
+            m_interpolation = 1.f;
+            return;
+        }
 
-        // Update current scene
-        if (m_currentScene)
+        // Run the simulation in fixed ticks, whatever the frame rate
+        m_accumulator += frameTime;
+        int steps = 0;
+        while (m_accumulator >= m_fixedTimeStep && steps < m_maxCatchUpSteps)
         {
-            m_currentScene->update(deltaTime);
+            update(m_fixedTimeStep);
+            m_accumulator -= m_fixedTimeStep;
+            ++steps;
         }
 
-        // Update UI
-        m_uiManager->update(deltaTime);
+        // Too far behind: drop the backlog rather than spending ever more time catching up
+        if (m_accumulator >= m_fixedTimeStep)
+        {
+            m_accumulator = 0.f;
+        }
+
+        m_interpolation = m_accumulator / m_fixedTimeStep;
     }
 
-    void Engine::render()
+    void Engine::update(float deltaTime)
     {
+        ORENJI_ZONE("Engine::update");
+
+        // Stamp this frame's component additions, changes and removals
+        m_entityManager->advanceTick();
+
+        // Run physics, AI and the scene, in parallel where their component access allows
+        m_scheduler->run(deltaTime);
+
+        // Sync point: apply the structural changes deferred during the updates
+        m_entityManager->flushCommands();
+    }
+
+    void Engine::render(float interpolation)
+    {
+        ORENJI_ZONE("Engine::render");
+
         // Clear the window
         m_window.clear(sf::Color(40, 40, 40));
 
         // Render objects via render system
-        m_renderSystem->render();
+        m_renderSystem->render(interpolation);
 
-        // Render current scene
-        if (m_currentScene)
-        {
-            m_currentScene->render(m_window);
-        }
+        // Render the visible scenes
+        m_sceneManager->render(m_window);
 
         // Render UI on top
         m_uiManager->render();
+        drawProfilerOverlay(m_renderSystem->getDrawCallCount());
 
         // Display the window
+        present();
+
+        // The input handled this frame is now visible
+        m_inputQueue->notifyPresented();
+    }
+
+    void Engine::runPipelinedFrame()
+    {
+        // The entities, the scene and the frame arenas are only touched once the last simulation is over
+        waitForSimulation();
+        m_framePacer->applyQuality();
+        FrameArena::nextFrame();
+        m_sceneManager->applyPending();
+        dispatchInput();
+
+        // The widgets are drawn below on this thread: update them here, while
+        // the simulation is idle, rather than in the simulation job
+        m_uiManager->update(m_deltaTime);
+
+        // Capture the state simulated during the previous frame
+        {
+            ORENJI_ZONE("Engine::capture");
+            m_renderSnapshot->clear();
+            if (!m_sceneManager->capture(*m_renderSnapshot))
+            {
+                // The scene draws straight to the window: no overlap for this frame
+                simulate(m_deltaTime);
+                render(m_interpolation);
+                pruneRemovals();
+                return;
+            }
+            m_renderSystem->capture(*m_renderSnapshot, m_interpolation);
+        }
+        pruneRemovals();
+
+        // Simulate the next frame while this one is submitted and presented
+        updateFocus();
+        float deltaTime = m_deltaTime;
+        m_jobSystem->submit([this, deltaTime]()
+                            { simulate(deltaTime); }, m_simulationCounter.get());
+
+        {
+            ORENJI_ZONE("Engine::render");
+            m_window.clear(sf::Color(40, 40, 40));
+            m_renderSnapshot->render(m_window);
+            m_uiManager->render();
+            drawProfilerOverlay(m_renderSnapshot->getDrawCallCount());
+        }
+
+        present();
+
+        m_inputQueue->notifyPresented();
+    }
+
+    void Engine::pruneRemovals()
+    {
+        // Every consumer of removals has seen the ticks simulated so far: the
+        // render system once per frame, the others every tick. The current
+        // tick is kept since queries are inclusive
+        m_entityManager->pruneRemoved(m_entityManager->getCurrentTick());
+    }
+
+    void Engine::waitForSimulation()
+    {
+        if (m_jobSystem && m_simulationCounter)
+        {
+            ORENJI_ZONE("Engine::waitForSimulation");
+            m_jobSystem->wait(*m_simulationCounter);
+        }
+    }
+
+    void Engine::drawProfilerOverlay(std::size_t drawCalls)
+    {
+#if defined(ORENJI_PROFILING)
+        if (!m_profilerOverlay)
+        {
+            return;
+        }
+
+        // Show the frame pacer's measures and decisions under the frame times
+        const FramePacerStats &pacing = m_framePacer->getStats();
+        char status[128];
+        std::snprintf(status, sizeof(status), "cpu %.2f  present %.2f ms  quality level %d/%d  draw calls %zu",
+                      pacing.cpuMs, pacing.presentMs, pacing.qualityLevel, pacing.maxQualityLevel, drawCalls);
+        m_profilerOverlay->setStatus(status);
+
+        Core::Profiler &profiler = Core::Profiler::getInstance();
+        m_profilerOverlay->update(profiler.getFrameTimeStats(), profiler.getFrameTimes());
+
+        // Screen space, whatever the camera
+        sf::View view = m_window.getView();
+        m_window.setView(m_window.getDefaultView());
+        m_window.draw(*m_profilerOverlay);
+        m_window.setView(view);
+#else
+        (void)drawCalls;
+#endif
+    }
+
+    void Engine::addQualityKnobs()
+    {
+        Physics::Box2DWrapper &physics = m_physicsSystem->getPhysics();
+        m_framePacer->addKnob("Physics substeps", static_cast<float>(physics.getSubStepCount()), 1.f, [&physics](float value)
+                              { physics.setSubStepCount(static_cast<int>(std::lround(value))); });
+
+        // From the interval the AI declares down to 10 updates per second
+        float aiInterval = m_aiSystem->getUpdatePolicy().interval;
+        m_framePacer->addKnob("AI interval", aiInterval, std::max(aiInterval, 0.1f), [this](float value)
+                              { m_scheduler->setTaskInterval("AI", value); });
+
+        if (m_renderSystem)
+        {
+            m_framePacer->addKnob("Culling margin", m_renderSystem->getCullingMargin(), 0.f, [this](float value)
+                                  { m_renderSystem->setCullingMargin(value); });
+        }
+    }
+
+    void Engine::updateFocus()
+    {
+        // Time-sliced systems always update the entities around the camera
+        m_scheduler->setFocus(m_window.getView().getCenter());
+    }
+
+    void Engine::present()
+    {
+        ORENJI_ZONE("Engine::present");
+        m_framePacer->beginPresent();
         m_window.display();
+        m_framePacer->endPresent();
     }
 } // namespace Core
\ No newline at end of file
@@ -5,45 +5,47 @@
 namespace Gameplay
 {
     Enemy::Enemy(Core::EntityManager &manager,
+                 Core::EntityHandle handle,
+                 Physics::Box2DWrapper &physics,
                  const std::string &behaviorTreePath,
                  const sf::Vector2f &position)
-        : Entity(manager), m_movementSpeed(100.0f), m_maxHealth(100.0f), m_health(100.0f), m_behaviorTreePath(behaviorTreePath), m_isFacingRight(true), m_physicsComponent(nullptr), m_spriteComponent(nullptr), m_aiComponent(nullptr)
+        : Entity(manager, handle), m_physics(physics), m_spawnPosition(position), m_movementSpeed(100.0f), m_maxHealth(100.0f), m_health(100.0f), m_behaviorTreePath(behaviorTreePath), m_isFacingRight(true)
     {
-        setPosition(position);
     }
 
     void Enemy::initialize()
     {
         // Create physics component
-        m_physicsComponent = &addComponent<Physics::PhysicsComponent>();
+        auto &physicsComponent = addComponent<Physics::PhysicsComponent>(m_physics, b2Vec2{m_spawnPosition.x, m_spawnPosition.y},
+                                                                         Physics::BodyType::Dynamic);
 
         // Set up collision box
-        m_physicsComponent->createBody(b2BodyType::b2_dynamicBody);
-        m_physicsComponent->addBoxShape(sf::Vector2f(32.0f, 48.0f));
+        physicsComponent.createBody(b2BodyType::b2_dynamicBody);
+        physicsComponent.addBoxShape(sf::Vector2f(32.0f, 48.0f));
 
         // Set collision filtering
-        m_physicsComponent->setFilterData(
+        physicsComponent.setFilterData(
             Physics::CollisionCategory::ENEMY,
             Physics::CollisionCategory::GROUND |
                 Physics::CollisionCategory::PLAYER |
                 Physics::CollisionCategory::PROJECTILE);
 
         // Set physical properties
-        m_physicsComponent->setFixedRotation(true);
-        m_physicsComponent->setDensity(1.0f);
-        m_physicsComponent->setFriction(0.3f);
+        physicsComponent.setFixedRotation(true);
+        physicsComponent.setDensity(1.0f);
+        physicsComponent.setFriction(0.3f);
 
         // Initialize graphical representation
-        m_spriteComponent = &addComponent<Graphics::Components::SpriteComponent>();
-        m_spriteComponent->setSize(sf::Vector2f(64.0f, 64.0f));
-        m_spriteComponent->setColor(sf::Color::Red); // Default color until texture is loaded
+        auto &spriteComponent = addComponent<Graphics::Components::SpriteComponent>();
+        spriteComponent.setSize(sf::Vector2f(64.0f, 64.0f));
+        spriteComponent.setColor(sf::Color::Red); // Default color until texture is loaded
 
         // Initialize AI component with behavior tree
-        m_aiComponent = &addComponent<AI::Components::AIComponent>();
-        m_aiComponent->loadBehaviorTree(m_behaviorTreePath);
+        auto &aiComponent = addComponent<AI::Components::AIComponent>();
+        aiComponent.loadBehaviorTree(m_behaviorTreePath);
 
         // Set up blackboard with initial values
-        auto &blackboard = m_aiComponent->getBlackboard();
+        auto &blackboard = aiComponent.getBlackboard();
         blackboard.setFloat("movementSpeed", m_movementSpeed);
         blackboard.setFloat("health", m_health);
         blackboard.setBool("isFacingRight", m_isFacingRight);
@@ -52,25 +54,25 @@ namespace Gameplay
     void Enemy::update(float deltaTime)
     {
         // Update the AI component first to make decisions
-        if (m_aiComponent)
+        if (auto *aiComponent = getComponent<AI::Components::AIComponent>())
         {
-            m_aiComponent->update(deltaTime);
+            aiComponent->update(deltaTime);
 
             // Read updated values from the blackboard
-            auto &blackboard = m_aiComponent->getBlackboard();
+            auto &blackboard = aiComponent->getBlackboard();
             m_isFacingRight = blackboard.getBool("isFacingRight", m_isFacingRight);
         }
 
         // Update the sprite based on facing direction
-        if (m_spriteComponent)
+        if (auto *spriteComponent = getComponent<Graphics::Components::SpriteComponent>())
         {
             if (m_isFacingRight)
             {
-                m_spriteComponent->setScale(1.0f, 1.0f);
+                spriteComponent->setScale(1.0f, 1.0f);
             }
             else
             {
-                m_spriteComponent->setScale(-1.0f, 1.0f);
+                spriteComponent->setScale(-1.0f, 1.0f);
             }
         }
 
@@ -83,9 +85,9 @@ namespace Gameplay
         m_movementSpeed = speed;
 
         // Update AI blackboard
-        if (m_aiComponent)
+        if (auto *aiComponent = getComponent<AI::Components::AIComponent>())
         {
-            m_aiComponent->getBlackboard().setFloat("movementSpeed", m_movementSpeed);
+            aiComponent->getBlackboard().setFloat("movementSpeed", m_movementSpeed);
         }
     }
 
@@ -105,9 +107,9 @@ namespace Gameplay
         }
 
         // Update AI blackboard
-        if (m_aiComponent)
+        if (auto *aiComponent = getComponent<AI::Components::AIComponent>())
         {
-            m_aiComponent->getBlackboard().setFloat("maxHealth", m_maxHealth);
+            aiComponent->getBlackboard().setFloat("maxHealth", m_maxHealth);
         }
     }
 
@@ -121,9 +123,9 @@ namespace Gameplay
         m_health = std::max(0.0f, std::min(health, m_maxHealth));
 
         // Update AI blackboard
-        if (m_aiComponent)
+        if (auto *aiComponent = getComponent<AI::Components::AIComponent>())
         {
-            m_aiComponent->getBlackboard().setFloat("health", m_health);
+            aiComponent->getBlackboard().setFloat("health", m_health);
         }
     }
 
@@ -137,10 +139,10 @@ namespace Gameplay
         setHealth(m_health - amount);
 
         // Notify AI that entity was damaged
-        if (m_aiComponent)
+        if (auto *aiComponent = getComponent<AI::Components::AIComponent>())
         {
-            m_aiComponent->getBlackboard().setBool("wasDamaged", true);
-            m_aiComponent->getBlackboard().setFloat("lastDamageAmount", amount);
+            aiComponent->getBlackboard().setBool("wasDamaged", true);
+            aiComponent->getBlackboard().setFloat("lastDamageAmount", amount);
         }
 
         return isAlive();
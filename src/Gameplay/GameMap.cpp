@@ -68,14 +68,14 @@ namespace Gameplay
             tileCoords.y * tileSize.y);
     }
 
-    std::vector<Resources::MapObject> GameMap::getObjectsByType(const std::string &type) const
+    void GameMap::getObjectsByType(const std::string &type, Core::FrameVector<const Resources::MapObject *> &result) const
     {
-        return m_tiledMapLoader.getObjectsByType(type);
+        m_tiledMapLoader.getObjectsByType(type, result);
     }
 
-    std::vector<Resources::MapObject> GameMap::getObjectsByName(const std::string &name) const
+    void GameMap::getObjectsByName(const std::string &name, Core::FrameVector<const Resources::MapObject *> &result) const
     {
-        return m_tiledMapLoader.getObjectsByName(name);
+        m_tiledMapLoader.getObjectsByName(name, result);
     }
 
     Physics::TiledMapCollider *GameMap::getCollider()
@@ -2,39 +2,39 @@
 
 namespace Gameplay
 {
-    Player::Player(Core::EntityManager &manager, const sf::Vector2f &position)
-        : Core::Entity(manager, "Player"), m_movementSpeed(200.0f), m_jumpForce(350.0f), m_isGrounded(false), m_isFacingRight(true), m_physicsComponent(nullptr), m_spriteComponent(nullptr)
+    Player::Player(Core::EntityManager &manager, Core::EntityHandle handle, Physics::Box2DWrapper &physics,
+                   const sf::Vector2f &position)
+        : Core::Entity(manager, handle, "Player"), m_physics(physics), m_spawnPosition(position), m_movementSpeed(200.0f), m_jumpForce(350.0f), m_isGrounded(false), m_isFacingRight(true)
     {
         initialize();
-
-        // Set initial position
-        if (m_physicsComponent)
-        {
-            m_physicsComponent->setPosition(position.x, position.y);
-        }
+        getComponent<Core::TransformComponent>()->setPosition(position);
     }
 
     void Player::initialize()
     {
+        // World position, written by the PhysicsSystem after each step
+        addComponent<Core::TransformComponent>();
+
         // Add physics component
-        m_physicsComponent = addComponent<Physics::PhysicsComponent>();
-        if (m_physicsComponent)
+        Physics::PhysicsComponent *physicsComponent = &addComponent<Physics::PhysicsComponent>(
+            m_physics, b2Vec2{m_spawnPosition.x, m_spawnPosition.y}, Physics::BodyType::Dynamic);
+        if (physicsComponent)
         {
             // Set up player's physical properties
-            m_physicsComponent->initialize(Physics::BodyType::Dynamic, 1.0f, 0.1f, 0.0f);
+            physicsComponent->initialize(Physics::BodyType::Dynamic, 1.0f, 0.1f, 0.0f);
 
             // Create a box shape for the player
-            m_physicsComponent->addBoxShape(32.0f, 64.0f);
+            physicsComponent->addBoxShape(32.0f, 64.0f);
 
             // Set player collision filter
-            m_physicsComponent->setCollisionFilter(
+            physicsComponent->setCollisionFilter(
                 Physics::CollisionCategory::PLAYER,
                 Physics::CollisionCategory::GROUND |
                     Physics::CollisionCategory::ENEMY |
                     Physics::CollisionCategory::SENSOR);
 
             // Register collision callback to detect ground contact
-            m_physicsComponent->setCollisionCallback([this](const Physics::CollisionResult &result)
+            physicsComponent->setCollisionCallback([this](const Physics::CollisionResult &result)
                                                      {
                                                          // Check if collision is with ground
                                                          if (result.categoryB & Physics::CollisionCategory::GROUND)
@@ -51,14 +51,14 @@ namespace Gameplay
         }
 
         // Add sprite component
-        m_spriteComponent = addComponent<Graphics::Components::SpriteComponent>();
-        if (m_spriteComponent)
+        Graphics::Components::SpriteComponent *spriteComponent = &addComponent<Graphics::Components::SpriteComponent>();
+        if (spriteComponent)
         {
             // Set the origin to center of sprite for proper physics alignment
-            m_spriteComponent->setOrigin(16.0f, 32.0f);
+            spriteComponent->setOrigin(16.0f, 32.0f);
 
             // Set render layer (higher draws on top)
-            m_spriteComponent->setLayer(10);
+            spriteComponent->setLayer(10);
         }
     }
 
@@ -69,31 +69,29 @@ namespace Gameplay
         // Reset grounded state each frame (will be set by collision callback if touching ground)
         m_isGrounded = false;
 
-        // Update sprite position to match physics
-        if (m_physicsComponent && m_spriteComponent)
+        // The position comes from the TransformComponent, synced by the
+        // PhysicsSystem; the sprite only keeps its local flip
+        if (auto *spriteComponent = getComponent<Graphics::Components::SpriteComponent>())
         {
-            sf::Vector2f position = m_physicsComponent->getPosition();
-            m_spriteComponent->getSprite().setPosition(position);
-
-            // Flip sprite based on facing direction
-            if (m_isFacingRight && m_spriteComponent->getSprite().getScale().x < 0)
-            {
-                m_spriteComponent->getSprite().setScale(1.0f, 1.0f);
-            }
-            else if (!m_isFacingRight && m_spriteComponent->getSprite().getScale().x > 0)
+            float scaleX = spriteComponent->getSprite().getScale().x;
+            if ((m_isFacingRight && scaleX < 0) || (!m_isFacingRight && scaleX > 0))
             {
-                m_spriteComponent->getSprite().setScale(-1.0f, 1.0f);
+                spriteComponent->getSprite().setScale(m_isFacingRight ? 1.0f : -1.0f, 1.0f);
+
+                // The sprite's bounds changed: let the render system know
+                markChanged<Graphics::Components::SpriteComponent>();
             }
         }
     }
 
     void Player::handleInput(float deltaTime)
     {
-        if (!m_physicsComponent)
+        auto *physicsComponent = getComponent<Physics::PhysicsComponent>();
+        if (!physicsComponent)
             return;
 
         // Reset horizontal velocity
-        sf::Vector2f velocity = m_physicsComponent->getLinearVelocity();
+        sf::Vector2f velocity = physicsComponent->getLinearVelocity();
         velocity.x = 0.0f;
 
         // Handle horizontal movement
@@ -120,7 +118,7 @@ namespace Gameplay
         }
 
         // Apply the velocity
-        m_physicsComponent->setLinearVelocity(velocity);
+        physicsComponent->setLinearVelocity(velocity);
     }
 
     void Player::setMovementSpeed(float speed)
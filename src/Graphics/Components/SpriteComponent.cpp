@@ -1,4 +1,5 @@
 #include "Graphics/Components/SpriteComponent.hpp"
+#include "Core/EntityManager.hpp"
 
 namespace Graphics
 {
@@ -22,6 +23,7 @@ namespace Graphics
             {
                 m_sprite.setTexture(*texture);
             }
+            markBoundsChanged();
         }
 
         sf::Sprite &SpriteComponent::getSprite()
@@ -32,11 +34,13 @@ namespace Graphics
         void SpriteComponent::setTextureRect(const sf::IntRect &rect)
         {
             m_sprite.setTextureRect(rect);
+            markBoundsChanged();
         }
 
         void SpriteComponent::setOrigin(float x, float y)
         {
             m_sprite.setOrigin(x, y);
+            markBoundsChanged();
         }
 
         void SpriteComponent::setColor(const sf::Color &color)
@@ -64,5 +68,13 @@ namespace Graphics
             return m_visible;
         }
 
+        void SpriteComponent::markBoundsChanged()
+        {
+            if (Core::Entity *owner = getOwner())
+            {
+                owner->markChanged<SpriteComponent>();
+            }
+        }
+
     }
 } // namespace Graphics::Components
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "Graphics/ParticleSystem.hpp"
+#include "Core/JobSystem.hpp"
+#include "Graphics/RenderQueue.hpp"
+#include <atomic>
 #include <cmath>
 #include <random>
 #include <algorithm>
@@ -12,6 +15,12 @@ namespace Orenji
     namespace Graphics
     {
 
+        namespace
+        {
+            // Particules mises à jour par job quand le système est parallélisé
+            const size_t PARTICLES_PER_JOB = 1024;
+        }
+
         ParticleSystem::ParticleSystem(unsigned int maxParticles)
             : m_vertices(sf::PrimitiveType::Triangles),
               m_maxParticles(maxParticles),
@@ -21,6 +30,7 @@ namespace Orenji
               m_emitterRadius(0.f),
               m_useCircularEmitter(false),
               m_emissionRate(10.f),
+              m_emissionScale(1.f),
               m_emissionAccumulator(0.f),
               m_globalForce(0.f, 0.f),
               m_acceleration(0.f, 0.f),
@@ -39,7 +49,8 @@ namespace Orenji
               m_endColor(sf::Color(255, 255, 255, 0)),
               m_blendMode(sf::BlendAlpha),
               m_emitterEnabled(true),
-              m_activeParticleCount(0)
+              m_activeParticleCount(0),
+              m_jobSystem(nullptr)
         {
             // Seed the random number generator
             std::random_device rd;
@@ -79,6 +90,11 @@ namespace Orenji
             m_emissionRate = particlesPerSecond;
         }
 
+        void ParticleSystem::setEmissionScale(float scale)
+        {
+            m_emissionScale = std::clamp(scale, 0.f, 1.f);
+        }
+
         void ParticleSystem::setEmitterPosition(const sf::Vector2f &position)
         {
             m_emitterPosition = position;
@@ -598,12 +614,13 @@ namespace Orenji
 
         void ParticleSystem::update(float deltaTime)
         {
-            // Émettre de nouvelles particules selon le taux d'émission
-            if (m_emitterEnabled)
+            // Émettre de nouvelles particules selon le taux d'émission, réduit par l'échelle de qualité
+            size_t emissionCap = static_cast<size_t>(m_maxParticles * m_emissionScale);
+            if (m_emitterEnabled && m_activeParticleCount < emissionCap)
             {
                 m_emissionAccumulator += deltaTime;
 
-                float particlesThisFrame = m_emissionRate * deltaTime;
+                float particlesThisFrame = m_emissionRate * m_emissionScale * deltaTime;
                 int wholeParticles = static_cast<int>(particlesThisFrame);
                 float fractionalPart = particlesThisFrame - wholeParticles;
 
@@ -619,10 +636,32 @@ namespace Orenji
                 }
             }
 
-            // Mettre à jour toutes les particules
+            // Mettre à jour toutes les particules, par blocs répartis sur le job system s'il y en a un
+            if (m_jobSystem)
+            {
+                std::atomic<size_t> activeCount(0);
+                m_jobSystem->parallelFor(0, m_particles.size(), PARTICLES_PER_JOB, [this, deltaTime, &activeCount](size_t begin, size_t end)
+                                         { activeCount.fetch_add(updateParticles(begin, end, deltaTime), std::memory_order_relaxed); },
+                                         "ParticleSystem::update");
+                m_activeParticleCount = activeCount.load();
+            }
+            else
+            {
+                m_activeParticleCount = updateParticles(0, m_particles.size(), deltaTime);
+            }
+        }
+
+        void ParticleSystem::setJobSystem(Core::JobSystem *jobSystem)
+        {
+            m_jobSystem = jobSystem;
+        }
+
+        size_t ParticleSystem::updateParticles(size_t begin, size_t end, float deltaTime)
+        {
             size_t activeCount = 0;
-            for (auto &particle : m_particles)
+            for (size_t i = begin; i < end; ++i)
             {
+                Particle &particle = m_particles[i];
                 if (!particle.active)
                     continue;
 
@@ -683,10 +722,9 @@ namespace Orenji
                 activeCount++;
             }
 
-            m_activeParticleCount = activeCount;
-
-            // Mettre à jour le tableau de vertices pour l'affichage
-            updateVertices();
+            // Mettre à jour les vertices du bloc pour l'affichage
+            updateVertices(begin, end);
+            return activeCount;
         }
 
         void ParticleSystem::setParticleBehavior(ParticleBehavior behavior)
@@ -710,6 +748,20 @@ namespace Orenji
             }
         }
 
+        void ParticleSystem::enqueue(::Graphics::RenderQueue &queue, int layer) const
+        {
+            if (m_activeParticleCount == 0)
+            {
+                return;
+            }
+
+            // Mêmes états que draw() ; profondeur à l'émetteur, l'effet est trié d'un bloc
+            sf::RenderStates states;
+            states.texture = m_texture.get();
+            states.blendMode = m_blendMode;
+            queue.addTriangles(&m_vertices[0], m_vertices.getVertexCount(), states, layer, m_emitterPosition.y);
+        }
+
         Particle &ParticleSystem::emitParticle()
         {
             // Trouver une particule inactive ou la plus ancienne
@@ -787,9 +839,9 @@ namespace Orenji
             return -1; // Aucune particule inactive trouvée
         }
 
-        void ParticleSystem::updateVertices()
+        void ParticleSystem::updateVertices(size_t begin, size_t end)
         {
-            for (size_t i = 0; i < m_particles.size(); ++i)
+            for (size_t i = begin; i < end; ++i)
             {
                 const Particle &particle = m_particles[i];
 
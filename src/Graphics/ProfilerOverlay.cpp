@@ -0,0 +1,84 @@
+#include "../../include/Graphics/ProfilerOverlay.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace Graphics
+{
+
+    namespace
+    {
+        const float GRAPH_WIDTH = 300.f;
+        const float GRAPH_HEIGHT = 60.f;
+        const float LINE_HEIGHT = 20.f;
+        const float PADDING = 6.f;
+        const float BUDGET_MS = 1000.f / 60.f;
+    }
+
+    ProfilerOverlay::ProfilerOverlay(const sf::Font &font)
+        : m_position(10.f, 10.f), m_text(font, "", 14), m_graph(sf::PrimitiveType::Lines)
+    {
+        m_background.setFillColor(sf::Color(0, 0, 0, 160));
+        m_text.setFillColor(sf::Color::White);
+    }
+
+    void ProfilerOverlay::update(const Core::FrameTimeStats &stats, const std::vector<float> &frameTimes)
+    {
+        char text[160];
+        std::snprintf(text, sizeof(text), "avg %.2f ms  (%.0f FPS)\np50 %.2f  p90 %.2f  p99 %.2f  max %.2f",
+                      stats.averageMs, stats.averageMs > 0.f ? 1000.f / stats.averageMs : 0.f,
+                      stats.p50Ms, stats.p90Ms, stats.p99Ms, stats.maxMs);
+        float textHeight = 2.f * LINE_HEIGHT;
+        if (m_status.empty())
+        {
+            m_text.setString(text);
+        }
+        else
+        {
+            m_text.setString(std::string(text) + "\n" + m_status);
+            textHeight += LINE_HEIGHT;
+        }
+        m_background.setSize(sf::Vector2f(GRAPH_WIDTH + 2.f * PADDING, textHeight + GRAPH_HEIGHT + 3.f * PADDING));
+
+        // Scale the graph so that both the budget and the worst frame fit
+        float scaleMs = std::max(2.f * BUDGET_MS, stats.maxMs);
+        float bottom = textHeight + 2.f * PADDING + GRAPH_HEIGHT;
+
+        m_graph.clear();
+        float budgetY = bottom - GRAPH_HEIGHT * BUDGET_MS / scaleMs;
+        m_graph.append(sf::Vertex{sf::Vector2f(PADDING, budgetY), sf::Color(255, 255, 0, 160)});
+        m_graph.append(sf::Vertex{sf::Vector2f(PADDING + GRAPH_WIDTH, budgetY), sf::Color(255, 255, 0, 160)});
+
+        // One bar per frame, newest on the right
+        float barWidth = GRAPH_WIDTH / static_cast<float>(std::max<std::size_t>(frameTimes.size(), 1));
+        for (std::size_t i = 0; i < frameTimes.size(); ++i)
+        {
+            float x = PADDING + barWidth * static_cast<float>(i);
+            float height = GRAPH_HEIGHT * std::min(frameTimes[i] / scaleMs, 1.f);
+            sf::Color color = frameTimes[i] > BUDGET_MS ? sf::Color(230, 70, 70) : sf::Color(80, 200, 120);
+            m_graph.append(sf::Vertex{sf::Vector2f(x, bottom), color});
+            m_graph.append(sf::Vertex{sf::Vector2f(x, bottom - height), color});
+        }
+    }
+
+    void ProfilerOverlay::setStatus(const std::string &status)
+    {
+        m_status = status;
+    }
+
+    void ProfilerOverlay::setPosition(const sf::Vector2f &position)
+    {
+        m_position = position;
+    }
+
+    void ProfilerOverlay::draw(sf::RenderTarget &target, sf::RenderStates states) const
+    {
+        states.transform.translate(m_position);
+        target.draw(m_background, states);
+
+        sf::RenderStates textStates = states;
+        textStates.transform.translate(sf::Vector2f(PADDING, PADDING));
+        target.draw(m_text, textStates);
+        target.draw(m_graph, states);
+    }
+
+} // namespace Graphics
\ No newline at end of file
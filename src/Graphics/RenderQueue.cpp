@@ -0,0 +1,363 @@
+#include "../../include/Graphics/RenderQueue.hpp"
+#include "../../include/Core/Profiler.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+    constexpr std::uint64_t DEPTH_MAX = (1u << 20) - 1;
+    constexpr std::uint32_t TEXTURE_ID_MAX = (1u << 16) - 1;
+    constexpr std::uint32_t SHADER_ID_MAX = (1u << 8) - 1;
+    constexpr std::uint32_t BLEND_MODE_ID_MAX = (1u << 4) - 1;
+}
+
+namespace Graphics
+{
+
+    RenderQueue::RenderQueue()
+        : m_lastTexture(nullptr), m_lastTextureId(NONE),
+          m_vertexBuffer(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Stream), m_drawCallCount(0)
+    {
+        setDepthRange(-32768.f, 32768.f);
+    }
+
+    void RenderQueue::clear()
+    {
+        m_items.clear();
+        m_entries.clear();
+        m_vertices.clear();
+        m_drawables.clear();
+
+        m_textureIds.clear();
+        m_shaders.clear();
+        m_blendModes.clear();
+        m_lastTexture = nullptr;
+        m_lastTextureId = NONE;
+    }
+
+    void RenderQueue::setDepthRange(float top, float bottom)
+    {
+        m_depthTop = top;
+        m_depthScale = bottom > top ? static_cast<float>(DEPTH_MAX) / (bottom - top) : 0.f;
+    }
+
+    void RenderQueue::setLayerOrder(int layer, LayerOrder order)
+    {
+        if (order == LayerOrder::Batched)
+        {
+            m_layerOrders.erase(layer);
+        }
+        else
+        {
+            m_layerOrders[layer] = order;
+        }
+    }
+
+    RenderQueue::LayerOrder RenderQueue::getLayerOrder(int layer) const
+    {
+        auto it = m_layerOrders.find(layer);
+        return it != m_layerOrders.end() ? it->second : LayerOrder::Batched;
+    }
+
+    void RenderQueue::addSprite(const sf::Sprite &sprite, const sf::Transform &transform, int layer,
+                                const sf::BlendMode &blendMode, const sf::Shader *shader)
+    {
+        // Same geometry as sf::Sprite: a negative texture rect size flips the texture
+        const sf::FloatRect rect(sprite.getTextureRect());
+        const sf::Vector2f size(std::abs(rect.size.x), std::abs(rect.size.y));
+        const sf::Transform combined = transform * sprite.getTransform();
+        const sf::Color color = sprite.getColor();
+
+        const sf::Vertex topLeft{combined.transformPoint({0.f, 0.f}), color, rect.position};
+        const sf::Vertex bottomLeft{combined.transformPoint({0.f, size.y}), color,
+                                    {rect.position.x, rect.position.y + rect.size.y}};
+        const sf::Vertex topRight{combined.transformPoint({size.x, 0.f}), color,
+                                  {rect.position.x + rect.size.x, rect.position.y}};
+        const sf::Vertex bottomRight{combined.transformPoint(size), color, rect.position + rect.size};
+
+        float depth = std::max(std::max(topLeft.position.y, bottomLeft.position.y),
+                               std::max(topRight.position.y, bottomRight.position.y));
+
+        push(Item{&sprite.getTexture(), shader, blendMode, static_cast<std::uint32_t>(m_vertices.size()), 6}, layer, depth);
+        m_vertices.insert(m_vertices.end(), {topLeft, bottomLeft, topRight, topRight, bottomLeft, bottomRight});
+    }
+
+    void RenderQueue::addTriangles(const sf::Vertex *vertices, std::size_t count, const sf::RenderStates &states,
+                                   int layer, float depth)
+    {
+        count -= count % 3;
+        if (count == 0)
+        {
+            return;
+        }
+
+        push(Item{states.texture, states.shader, states.blendMode, static_cast<std::uint32_t>(m_vertices.size()),
+                  static_cast<std::uint32_t>(count)},
+             layer, depth);
+
+        // Transformed now, so that items with different transforms still share a draw call
+        m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+        for (auto it = m_vertices.end() - count; it != m_vertices.end(); ++it)
+        {
+            it->position = states.transform.transformPoint(it->position);
+        }
+    }
+
+    void RenderQueue::addDrawable(std::unique_ptr<sf::Drawable> drawable, const sf::RenderStates &states,
+                                  int layer, float depth)
+    {
+        push(Item{states.texture, states.shader, states.blendMode, static_cast<std::uint32_t>(m_drawables.size()), 0},
+             layer, depth);
+        const sf::Drawable *pointer = drawable.get();
+        m_drawables.push_back(DrawableItem{pointer, std::move(drawable), states});
+    }
+
+    void RenderQueue::addDrawable(const sf::Drawable &drawable, const sf::RenderStates &states,
+                                  int layer, float depth)
+    {
+        push(Item{states.texture, states.shader, states.blendMode, static_cast<std::uint32_t>(m_drawables.size()), 0},
+             layer, depth);
+        m_drawables.push_back(DrawableItem{&drawable, nullptr, states});
+    }
+
+    void RenderQueue::draw(sf::RenderTarget &target, sf::RenderStates states)
+    {
+        ORENJI_ZONE("RenderQueue::draw");
+        m_drawCallCount = 0;
+        if (m_items.empty())
+        {
+            return;
+        }
+
+        sortKeys();
+
+        m_sortedVertices.clear();
+        m_sortedVertices.reserve(m_vertices.size());
+        for (const SortEntry &entry : m_entries)
+        {
+            const Item &item = m_items[entry.item];
+            if (item.count == 0)
+            {
+                continue;
+            }
+            m_sortedVertices.insert(m_sortedVertices.end(), m_vertices.begin() + item.first,
+                                    m_vertices.begin() + item.first + item.count);
+        }
+
+        bool useVertexBuffer = upload();
+
+        // One draw call per run of vertex items sharing their texture, blend
+        // mode and shader; drawables end the current run
+        const Item *run = nullptr;
+        std::size_t runFirst = 0;
+        std::size_t runCount = 0;
+        auto flush = [&]()
+        {
+            if (!run)
+            {
+                return;
+            }
+
+            sf::RenderStates runStates = states;
+            runStates.texture = run->texture;
+            runStates.blendMode = run->blendMode;
+            runStates.shader = run->shader;
+            if (useVertexBuffer)
+            {
+                target.draw(m_vertexBuffer, runFirst, runCount, runStates);
+            }
+            else
+            {
+                target.draw(m_sortedVertices.data() + runFirst, runCount, sf::PrimitiveType::Triangles, runStates);
+            }
+            ++m_drawCallCount;
+            runFirst += runCount;
+            runCount = 0;
+            run = nullptr;
+        };
+
+        for (const SortEntry &entry : m_entries)
+        {
+            const Item &item = m_items[entry.item];
+            if (item.count == 0)
+            {
+                flush();
+                const DrawableItem &drawable = m_drawables[item.first];
+                sf::RenderStates drawableStates = drawable.states;
+                drawableStates.transform = states.transform * drawableStates.transform;
+                target.draw(*drawable.drawable, drawableStates);
+                ++m_drawCallCount;
+                continue;
+            }
+
+            if (run && !isSameRun(*run, item))
+            {
+                flush();
+            }
+            if (!run)
+            {
+                run = &item;
+            }
+            runCount += item.count;
+        }
+        flush();
+    }
+
+    std::size_t RenderQueue::getItemCount() const
+    {
+        return m_items.size();
+    }
+
+    std::size_t RenderQueue::getDrawCallCount() const
+    {
+        return m_drawCallCount;
+    }
+
+    void RenderQueue::push(const Item &item, int layer, float depth)
+    {
+        m_entries.push_back(SortEntry{makeKey(item, layer, depth), static_cast<std::uint32_t>(m_items.size())});
+        m_items.push_back(item);
+    }
+
+    std::uint64_t RenderQueue::makeKey(const Item &item, int layer, float depth)
+    {
+        const std::uint64_t layerBits = static_cast<std::uint64_t>(std::clamp(layer, -32768, 32767) + 32768) << 48;
+        LayerOrder order = m_layerOrders.empty() ? LayerOrder::Batched : getLayerOrder(layer);
+        if (order == LayerOrder::Submission)
+        {
+            // Equal keys: the stable sort keeps the order of addition
+            return layerBits;
+        }
+
+        // Clamped to the depth range, NaN included
+        float scaled = (depth - m_depthTop) * m_depthScale;
+        std::uint64_t depthBits = scaled > 0.f ? static_cast<std::uint64_t>(std::min(scaled, static_cast<float>(DEPTH_MAX))) : 0;
+
+        // Identifiers past the field's maximum share it: their items may interleave
+        // and take more draw calls, but runs compare the actual states
+        const std::uint64_t stateBits = static_cast<std::uint64_t>(getBlendModeId(item.blendMode)) << 24 |
+                                        static_cast<std::uint64_t>(getShaderId(item.shader)) << 16 |
+                                        getTextureId(item.texture);
+
+        if (order == LayerOrder::DepthSorted)
+        {
+            return layerBits | depthBits << 28 | stateBits;
+        }
+        return layerBits | stateBits << 20 | depthBits;
+    }
+
+    std::uint32_t RenderQueue::getTextureId(const sf::Texture *texture)
+    {
+        if (texture != m_lastTexture || m_lastTextureId == NONE)
+        {
+            auto id = static_cast<std::uint32_t>(std::min<std::size_t>(m_textureIds.size(), TEXTURE_ID_MAX));
+            m_lastTexture = texture;
+            m_lastTextureId = m_textureIds.emplace(texture, id).first->second;
+        }
+        return m_lastTextureId;
+    }
+
+    std::uint32_t RenderQueue::getShaderId(const sf::Shader *shader)
+    {
+        // Few shaders and blend modes per frame: a linear search is enough
+        auto it = std::find(m_shaders.begin(), m_shaders.end(), shader);
+        if (it != m_shaders.end())
+        {
+            return static_cast<std::uint32_t>(it - m_shaders.begin());
+        }
+        if (m_shaders.size() == SHADER_ID_MAX)
+        {
+            return SHADER_ID_MAX;
+        }
+        m_shaders.push_back(shader);
+        return static_cast<std::uint32_t>(m_shaders.size() - 1);
+    }
+
+    std::uint32_t RenderQueue::getBlendModeId(const sf::BlendMode &blendMode)
+    {
+        auto it = std::find(m_blendModes.begin(), m_blendModes.end(), blendMode);
+        if (it != m_blendModes.end())
+        {
+            return static_cast<std::uint32_t>(it - m_blendModes.begin());
+        }
+        if (m_blendModes.size() == BLEND_MODE_ID_MAX)
+        {
+            return BLEND_MODE_ID_MAX;
+        }
+        m_blendModes.push_back(blendMode);
+        return static_cast<std::uint32_t>(m_blendModes.size() - 1);
+    }
+
+    void RenderQueue::sortKeys()
+    {
+        ORENJI_ZONE("RenderQueue::sortKeys");
+
+        // Least significant digit radix sort, one byte per pass. Every
+        // histogram is counted in a single read of the keys
+        constexpr std::size_t PASSES = 8;
+        std::array<std::array<std::uint32_t, 256>, PASSES> counts{};
+        for (const SortEntry &entry : m_entries)
+        {
+            for (std::size_t pass = 0; pass < PASSES; ++pass)
+            {
+                ++counts[pass][(entry.key >> (pass * 8)) & 0xFF];
+            }
+        }
+
+        m_sortBuffer.resize(m_entries.size());
+        for (std::size_t pass = 0; pass < PASSES; ++pass)
+        {
+            // A byte shared by every key leaves the order unchanged: skip the
+            // pass, as for the unused bits of the layer and identifiers
+            std::array<std::uint32_t, 256> &count = counts[pass];
+            const std::size_t shift = pass * 8;
+            if (count[(m_entries.front().key >> shift) & 0xFF] == m_entries.size())
+            {
+                continue;
+            }
+
+            std::uint32_t offset = 0;
+            for (std::uint32_t &bucket : count)
+            {
+                std::uint32_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for (const SortEntry &entry : m_entries)
+            {
+                m_sortBuffer[count[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+            m_entries.swap(m_sortBuffer);
+        }
+    }
+
+    bool RenderQueue::upload()
+    {
+        if (!sf::VertexBuffer::isAvailable())
+        {
+            return false;
+        }
+
+        // Grow geometrically so that a slowly rising item count does not recreate the buffer every frame
+        std::size_t count = m_sortedVertices.size();
+        if (count == 0)
+        {
+            return true;
+        }
+        if (m_vertexBuffer.getVertexCount() < count &&
+            !m_vertexBuffer.create(std::max(count, m_vertexBuffer.getVertexCount() * 2)))
+        {
+            return false;
+        }
+
+        return m_vertexBuffer.update(m_sortedVertices.data(), count, 0);
+    }
+
+    bool RenderQueue::isSameRun(const Item &a, const Item &b)
+    {
+        return a.texture == b.texture && a.shader == b.shader && a.blendMode == b.blendMode;
+    }
+
+} // namespace Graphics
@@ -0,0 +1,59 @@
+#include "../../include/Graphics/RenderSnapshot.hpp"
+
+namespace Graphics
+{
+
+    RenderSnapshot::RenderSnapshot()
+        : m_spriteCount(0)
+    {
+        m_queue.setLayerOrder(OVERLAY_LAYER, RenderQueue::LayerOrder::Submission);
+    }
+
+    void RenderSnapshot::clear()
+    {
+        m_queue.clear();
+        m_spriteCount = 0;
+    }
+
+    void RenderSnapshot::setView(const sf::View &view)
+    {
+        m_view = view;
+
+        // World area seen through the view, rotation included
+        sf::FloatRect bounds = view.getInverseTransform().transformRect(sf::FloatRect({-1.f, -1.f}, {2.f, 2.f}));
+        m_queue.setDepthRange(bounds.position.y, bounds.position.y + bounds.size.y);
+    }
+
+    const sf::View &RenderSnapshot::getView() const
+    {
+        return m_view;
+    }
+
+    void RenderSnapshot::addSprite(const sf::Sprite &sprite, const sf::Transform &transform, int layer)
+    {
+        m_queue.addSprite(sprite, transform, layer);
+        ++m_spriteCount;
+    }
+
+    std::size_t RenderSnapshot::getSpriteCount() const
+    {
+        return m_spriteCount;
+    }
+
+    RenderQueue &RenderSnapshot::getQueue()
+    {
+        return m_queue;
+    }
+
+    void RenderSnapshot::render(sf::RenderTarget &target)
+    {
+        target.setView(m_view);
+        m_queue.draw(target);
+    }
+
+    std::size_t RenderSnapshot::getDrawCallCount() const
+    {
+        return m_queue.getDrawCallCount();
+    }
+
+} // namespace Graphics
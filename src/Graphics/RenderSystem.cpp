@@ -1,17 +1,21 @@
 #include "../../include/Graphics/RenderSystem.hpp"
 #include "../../include/Core/EntityManager.hpp"
+#include "../../include/Core/Profiler.hpp"
+#include "../../include/Core/TransformComponent.hpp"
 #include "../../include/Graphics/Components/SpriteComponent.hpp"
 #include <iostream>
 #include <algorithm>
-#include <map>
 #include <vector>
 
 namespace Graphics
 {
 
     RenderSystem::RenderSystem(Core::EntityManager &entityManager, sf::RenderWindow &window)
-        : Core::System(entityManager), m_window(window)
+        : Core::System(entityManager), m_window(window), m_cullingMargin(64.f), m_lastTick(0)
     {
+        // The spatial index follows the sprites and transforms changed since the last capture
+        m_entityManager.enableChangeLog<Components::SpriteComponent>();
+        m_entityManager.enableChangeLog<Core::TransformComponent>();
         std::cout << "RenderSystem created" << std::endl;
     }
 
@@ -31,76 +35,139 @@ namespace Graphics
         // Actual rendering happens in the render() method
     }
 
-    void RenderSystem::render()
+    void RenderSystem::render(float interpolation)
     {
-        // Get all entities with sprite components
-        auto entities = m_entityManager.getEntitiesWithComponent<Components::SpriteComponent>();
+        m_snapshot.clear();
+        capture(m_snapshot, interpolation);
+        m_snapshot.render(m_window);
+    }
 
-        // Optimization: Skip if no sprite entities
-        if (entities.empty())
-        {
-            return;
-        }
+    std::size_t RenderSystem::getDrawCallCount() const
+    {
+        return m_snapshot.getDrawCallCount();
+    }
 
-        // Sort entities by layer (higher layers drawn on top)
-        std::sort(entities.begin(), entities.end(), [this](Core::Entity *a, Core::Entity *b)
-                  {
-            auto* spriteA = a->getComponent<Components::SpriteComponent>();
-            auto* spriteB = b->getComponent<Components::SpriteComponent>();
-            return spriteA->getLayer() < spriteB->getLayer(); });
+    void RenderSystem::setCullingMargin(float margin)
+    {
+        m_cullingMargin = std::max(margin, 0.f);
+    }
 
+    float RenderSystem::getCullingMargin() const
+    {
+        return m_cullingMargin;
+    }
+
+    void RenderSystem::capture(RenderSnapshot &snapshot, float interpolation)
+    {
         // View culling - Get current view
         sf::View view = m_window.getView();
-        sf::FloatRect viewBounds(
-            sf::Vector2f(view.getCenter().x - view.getSize().x / 2.f,
-                         view.getCenter().y - view.getSize().y / 2.f),
-            sf::Vector2f(view.getSize().x, view.getSize().y));
-
-        // Batching - Group by texture
-        std::map<const sf::Texture *, std::vector<Components::SpriteComponent *>> batchMap;
-
-        // Collect all visible sprites within view
-        for (const auto &entity : entities)
-        {
-            auto *spriteComponent = entity->getComponent<Components::SpriteComponent>();
+        snapshot.setView(view);
+
+        updateSpatialIndex();
+
+        // World area seen through the view, rotation included, plus the culling margin
+        sf::FloatRect viewBounds = view.getInverseTransform().transformRect(sf::FloatRect({-1.f, -1.f}, {2.f, 2.f}));
+        viewBounds.position -= sf::Vector2f(m_cullingMargin, m_cullingMargin);
+        viewBounds.size += sf::Vector2f(2.f * m_cullingMargin, 2.f * m_cullingMargin);
+
+        // Collect the sprites overlapping the view; the snapshot's render queue
+        // sorts them by layer and groups them by state
+        m_staleSlots.clear();
+        m_spatialIndex.query(viewBounds, [&](std::uint32_t slot)
+                             {
+            Core::Entity *entity = m_entityManager.getEntity(m_indexedEntities[slot]);
+            auto *spriteComponent = entity ? entity->getComponent<Components::SpriteComponent>() : nullptr;
             if (!spriteComponent)
             {
-                continue;
+                // Removed in a tick whose removals were already pruned
+                m_staleSlots.push_back(slot);
+                return;
             }
 
             // Skip invisible sprites
             if (!spriteComponent->isVisible())
             {
-                continue;
+                return;
             }
 
-            // Get sprite global bounds for culling
-            sf::FloatRect spriteBounds = spriteComponent->getSprite().getGlobalBounds();
-
-            // View culling - Skip sprites outside view
-            // SFML 3: check if any corner of the sprite bounds is within the view
-            if (!viewBounds.contains(spriteBounds.position) &&
-                !viewBounds.contains(sf::Vector2f(spriteBounds.position.x + spriteBounds.size.x, spriteBounds.position.y)) &&
-                !viewBounds.contains(sf::Vector2f(spriteBounds.position.x, spriteBounds.position.y + spriteBounds.size.y)) &&
-                !viewBounds.contains(sf::Vector2f(spriteBounds.position.x + spriteBounds.size.x, spriteBounds.position.y + spriteBounds.size.y)))
+            // The entity's position lives in its TransformComponent, if any
+            sf::Transform worldTransform;
+            if (const auto *transform = entity->getComponent<Core::TransformComponent>())
             {
-                continue;
+                worldTransform = transform->getInterpolatedTransform(interpolation);
             }
 
-            // SFML 3: getTexture() renvoie une référence et non un pointeur
-            // On l'ajoute directement au batchMap en utilisant son adresse comme clé
-            const sf::Texture &texture = spriteComponent->getSprite().getTexture();
-            batchMap[&texture].push_back(spriteComponent);
-        }
+            snapshot.addSprite(spriteComponent->getSprite(), worldTransform, spriteComponent->getLayer()); });
 
-        // Render batches
-        for (const auto &[texture, sprites] : batchMap)
+        for (std::uint32_t slot : m_staleSlots)
         {
-            for (const auto &sprite : sprites)
+            unindexSprite(slot);
+        }
+    }
+
+    void RenderSystem::updateSpatialIndex()
+    {
+        ORENJI_ZONE("RenderSystem::updateSpatialIndex");
+        std::uint32_t sinceTick = m_lastTick;
+        m_lastTick = m_entityManager.getCurrentTick();
+
+        m_entityManager.forEachRemoved<Components::SpriteComponent>(sinceTick, [this](Core::EntityId id)
+                                                                    {
+            std::uint32_t slot = Core::EntityHandle::fromId(id).index;
+            if (slot < m_indexedEntities.size() && m_indexedEntities[slot] == id)
             {
-                m_window.draw(sprite->getSprite());
-            }
+                unindexSprite(slot);
+            } });
+
+        // A sprite losing its transform is drawn at the origin again
+        m_entityManager.forEachRemoved<Core::TransformComponent>(sinceTick, [this](Core::EntityId id)
+                                                                 {
+            Core::Entity *entity = m_entityManager.getEntity(id);
+            auto *sprite = entity ? entity->getComponent<Components::SpriteComponent>() : nullptr;
+            if (sprite)
+            {
+                indexSprite(*entity, *sprite);
+            } });
+
+        // New sprites and changed sprites or transforms, from the change logs
+        // rather than a scan of the world; the TransformSystem marks the
+        // transforms whose world transform it recomputed
+        m_entityManager.drainChanged<Components::SpriteComponent>([this](Core::Entity &entity, Components::SpriteComponent &sprite)
+                                                                  { indexSprite(entity, sprite); });
+        m_entityManager.drainChanged<Core::TransformComponent>([this](Core::Entity &entity, Core::TransformComponent &)
+                                                               {
+            if (auto *sprite = entity.getComponent<Components::SpriteComponent>())
+            {
+                indexSprite(entity, *sprite);
+            } });
+    }
+
+    void RenderSystem::indexSprite(Core::Entity &entity, Components::SpriteComponent &sprite)
+    {
+        sf::FloatRect bounds = sprite.getSprite().getGlobalBounds();
+        if (const auto *transform = entity.getComponent<Core::TransformComponent>())
+        {
+            // Rendering interpolates from the previous world transform: cover both
+            sf::FloatRect current = transform->getWorldTransform().transformRect(bounds);
+            sf::FloatRect previous = transform->getInterpolatedTransform(0.f).transformRect(bounds);
+            sf::Vector2f topLeft(std::min(current.position.x, previous.position.x), std::min(current.position.y, previous.position.y));
+            sf::Vector2f bottomRight(std::max(current.position.x + current.size.x, previous.position.x + previous.size.x),
+                                     std::max(current.position.y + current.size.y, previous.position.y + previous.size.y));
+            bounds = sf::FloatRect(topLeft, bottomRight - topLeft);
+        }
+
+        std::uint32_t slot = entity.getIndex();
+        if (slot >= m_indexedEntities.size())
+        {
+            m_indexedEntities.resize(static_cast<std::size_t>(slot) + 1);
         }
+        m_indexedEntities[slot] = entity.getId();
+        m_spatialIndex.insert(slot, bounds);
+    }
+
+    void RenderSystem::unindexSprite(std::uint32_t slot)
+    {
+        m_spatialIndex.remove(slot);
     }
 
 } // namespace Graphics
\ No newline at end of file
@@ -6,7 +6,7 @@
 namespace Physics
 {
     Box2DWrapper::Box2DWrapper(b2Vec2 gravity)
-        : m_debugDrawEnabled(false)
+        : m_debugDrawEnabled(false), m_subStepCount(4)
     {
         // Créer une définition de monde avec la gravité
         b2WorldDef worldDef;
@@ -28,10 +28,20 @@ namespace Physics
     {
         if (b2World_IsValid(m_worldId))
         {
-            b2World_Step(m_worldId, timeStep, 1); // subStepCount = 1
+            b2World_Step(m_worldId, timeStep, m_subStepCount);
         }
     }
 
+    void Box2DWrapper::setSubStepCount(int subStepCount)
+    {
+        m_subStepCount = subStepCount > 0 ? subStepCount : 1;
+    }
+
+    int Box2DWrapper::getSubStepCount() const
+    {
+        return m_subStepCount;
+    }
+
     b2BodyId Box2DWrapper::createStaticBody(b2Vec2 position, float angle, void *userData)
     {
         b2BodyDef bodyDef;
@@ -1,6 +1,7 @@
 #include "../../include/Physics/PhysicsSystem.hpp"
 #include "../../include/Core/EntityManager.hpp"
 #include "../../include/Physics/PhysicsComponent.hpp"
+#include "../../include/Core/TransformComponent.hpp"
 #include <iostream>
 
 namespace Physics
@@ -68,6 +69,11 @@ namespace Physics
     PhysicsSystem::PhysicsSystem(Core::EntityManager &entityManager, b2Vec2 gravity)
         : Core::System(entityManager), m_physics(std::make_unique<Box2DWrapper>(gravity)), m_velocityIterations(6), m_positionIterations(2)
     {
+        // Les callbacks de collision doivent passer par getCommandBuffer()
+        // pour les changements structurels
+        declareWrite<PhysicsComponent, Core::TransformComponent>();
+        declareView<PhysicsComponent, Core::TransformComponent>();
+
         std::cout << "PhysicsSystem created" << std::endl;
     }
 
@@ -95,6 +101,9 @@ namespace Physics
         // Faire avancer la simulation physique
         m_physics->step(deltaTime, m_velocityIterations, m_positionIterations);
 
+        // Recopier la position des corps dans les transformations des entités
+        syncTransforms();
+
         // Récupérer le listener de contact
         ContactListener *listener = static_cast<ContactListener *>(b2World_GetUserData(m_physics->getWorld()));
         if (!listener)
@@ -145,6 +154,17 @@ namespace Physics
         listener->endContacts.clear();
     }
 
+    void PhysicsSystem::syncTransforms()
+    {
+        m_entityManager.getView<PhysicsComponent, Core::TransformComponent>().each(
+            [](Core::Entity &, PhysicsComponent &physics, Core::TransformComponent &transform)
+            {
+                b2Vec2 position = physics.getPosition();
+                transform.setPosition(sf::Vector2f(position.x, position.y));
+                transform.setRotation(physics.getAngle());
+            });
+    }
+
     Box2DWrapper &PhysicsSystem::getPhysics()
     {
         return *m_physics;
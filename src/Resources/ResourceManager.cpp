@@ -19,6 +19,7 @@ namespace Resources
 
     void ResourceManager::init(const std::string &basePath)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         m_basePath = basePath;
 
         // Ensure the base path ends with a slash
@@ -39,6 +40,7 @@ namespace Resources
 
     void ResourceManager::setResourcePath(const std::string &resourceType, const std::string &path)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         m_resourcePaths[resourceType] = path;
 
         // Ensure the path ends with a slash
@@ -52,6 +54,7 @@ namespace Resources
 
     std::string ResourceManager::getResourcePath(const std::string &resourceType) const
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         auto it = m_resourcePaths.find(resourceType);
         if (it != m_resourcePaths.end())
         {
@@ -92,6 +95,7 @@ namespace Resources
             texturePtr->setRepeated(repeated);
 
             // Store the texture
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
             auto inserted = m_textures.insert(std::make_pair(id, std::move(texturePtr)));
             std::cout << "Texture loaded: " << fullPath << std::endl;
 
@@ -105,23 +109,71 @@ namespace Resources
 
     sf::Texture &ResourceManager::getTexture(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         auto it = m_textures.find(id);
         if (it == m_textures.end())
         {
+            if (m_textureAtlas.contains(id))
+            {
+                // The whole page would show the neighbours of the image
+                throw std::invalid_argument("Texture is packed in the texture atlas, use getTextureRegion(): " + id);
+            }
             throw std::out_of_range("Texture does not exist: " + id);
         }
 
         return *it->second;
     }
 
+    void ResourceManager::addAtlasTexture(const std::string &id, const std::string &filePath)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        m_textureAtlas.add(id, getFullPath("textures", filePath));
+    }
+
+    void ResourceManager::buildTextureAtlas(const std::string &cacheDirectory)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        if (!m_textureAtlas.build(cacheDirectory))
+        {
+            throw ResourceLoadException("Failed to pack some textures into the texture atlas");
+        }
+    }
+
+    TextureAtlas &ResourceManager::getTextureAtlas()
+    {
+        return m_textureAtlas;
+    }
+
+    TextureRegion ResourceManager::getTextureRegion(const std::string &id)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        auto it = m_textures.find(id);
+        if (it == m_textures.end())
+        {
+            if (m_textureAtlas.contains(id))
+            {
+                return m_textureAtlas.getRegion(id);
+            }
+            throw std::out_of_range("Texture does not exist: " + id);
+        }
+
+        return TextureRegion{it->second.get(), sf::IntRect({0, 0}, sf::Vector2i(it->second->getSize()))};
+    }
+
+    sf::Sprite ResourceManager::createSprite(const std::string &id)
+    {
+        TextureRegion region = getTextureRegion(id);
+        return sf::Sprite(*region.texture, region.rect);
+    }
+
     SpriteSheet &ResourceManager::loadSpriteSheet(const std::string &id, const std::string &textureId,
                                                   int frameWidth, int frameHeight, int frameCount)
     {
-        // Get the texture
-        sf::Texture *texture = nullptr;
+        // Get the texture, or the part of an atlas page holding it
+        TextureRegion region;
         try
         {
-            texture = &getTexture(textureId);
+            region = getTextureRegion(textureId);
         }
         catch (const std::exception &e)
         {
@@ -130,18 +182,19 @@ namespace Resources
 
         // Create the frames
         std::vector<sf::IntRect> frames;
-        sf::Vector2u textureSize = texture->getSize();
-        int cols = static_cast<int>(textureSize.x) / frameWidth;
+        int cols = region.rect.size.x / frameWidth;
 
         for (int i = 0; i < frameCount; i++)
         {
             int col = i % cols;
             int row = i / cols;
-            frames.emplace_back(col * frameWidth, row * frameHeight, frameWidth, frameHeight);
+            frames.emplace_back(region.rect.position + sf::Vector2i(col * frameWidth, row * frameHeight),
+                                sf::Vector2i(frameWidth, frameHeight));
         }
 
         // Create the sprite sheet
-        SpriteSheet spriteSheet{texture, frames, {}};
+        SpriteSheet spriteSheet{region.texture, frames, {}};
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         m_spriteSheets[id] = spriteSheet;
 
         std::cout << "Sprite sheet created: " << id << " with " << frameCount << " frames" << std::endl;
@@ -152,19 +205,24 @@ namespace Resources
                                                   const std::vector<sf::IntRect> &frames,
                                                   const std::unordered_map<std::string, int> &namedFrames)
     {
-        // Get the texture
-        sf::Texture *texture = nullptr;
+        // Get the texture, or the part of an atlas page holding it
+        TextureRegion region;
         try
         {
-            texture = &getTexture(textureId);
+            region = getTextureRegion(textureId);
         }
         catch (const std::exception &e)
         {
             throw ResourceLoadException("Failed to load sprite sheet: Texture '" + textureId + "' not found - " + e.what());
         }
 
-        // Create the sprite sheet
-        SpriteSheet spriteSheet{texture, frames, namedFrames};
+        // Create the sprite sheet, with the frames moved into the atlas page
+        SpriteSheet spriteSheet{region.texture, frames, namedFrames};
+        for (sf::IntRect &frame : spriteSheet.frames)
+        {
+            frame.position += region.rect.position;
+        }
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         m_spriteSheets[id] = spriteSheet;
 
         std::cout << "Sprite sheet created: " << id << " with " << frames.size() << " frames" << std::endl;
@@ -173,6 +231,7 @@ namespace Resources
 
     SpriteSheet &ResourceManager::getSpriteSheet(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         auto it = m_spriteSheets.find(id);
         if (it == m_spriteSheets.end())
         {
@@ -194,6 +253,7 @@ namespace Resources
                 throw ResourceLoadException("Failed to load font: " + fullPath);
             }
 
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
             auto inserted = m_fonts.insert(std::make_pair(id, std::move(fontPtr)));
             std::cout << "Font loaded: " << fullPath << std::endl;
 
@@ -207,6 +267,7 @@ namespace Resources
 
     sf::Font &ResourceManager::getFont(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         auto it = m_fonts.find(id);
         if (it == m_fonts.end())
         {
@@ -228,6 +289,7 @@ namespace Resources
                 throw ResourceLoadException("Failed to load sound: " + fullPath);
             }
 
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
             auto inserted = m_soundBuffers.insert(std::make_pair(id, std::move(bufferPtr)));
             std::cout << "Sound loaded: " << fullPath << std::endl;
 
@@ -241,6 +303,7 @@ namespace Resources
 
     sf::SoundBuffer &ResourceManager::getSoundBuffer(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         auto it = m_soundBuffers.find(id);
         if (it == m_soundBuffers.end())
         {
@@ -262,6 +325,7 @@ namespace Resources
                 throw ResourceLoadException("Failed to load music: " + fullPath);
             }
 
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
             auto inserted = m_music.insert(std::make_pair(id, std::move(musicPtr)));
             std::cout << "Music loaded: " << fullPath << std::endl;
 
@@ -275,6 +339,7 @@ namespace Resources
 
     sf::Music &ResourceManager::getMusic(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         auto it = m_music.find(id);
         if (it == m_music.end())
         {
@@ -299,6 +364,7 @@ namespace Resources
                 throw ResourceLoadException("Failed to load shader: " + vertexPath + ", " + fragmentPath);
             }
 
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
             auto inserted = m_shaders.insert(std::make_pair(id, std::move(shaderPtr)));
             std::cout << "Shader loaded: " << vertexPath << ", " << fragmentPath << std::endl;
 
@@ -322,6 +388,7 @@ namespace Resources
                 throw ResourceLoadException("Failed to load fragment shader: " + fragmentPath);
             }
 
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
             auto inserted = m_shaders.insert(std::make_pair(id, std::move(shaderPtr)));
             std::cout << "Fragment shader loaded: " << fragmentPath << std::endl;
 
@@ -335,6 +402,7 @@ namespace Resources
 
     sf::Shader &ResourceManager::getShader(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         auto it = m_shaders.find(id);
         if (it == m_shaders.end())
         {
@@ -346,67 +414,82 @@ namespace Resources
 
     bool ResourceManager::hasTexture(const std::string &id) const
     {
-        return m_textures.find(id) != m_textures.end();
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        return m_textures.find(id) != m_textures.end() || m_textureAtlas.contains(id);
     }
 
     bool ResourceManager::hasSpriteSheet(const std::string &id) const
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_spriteSheets.find(id) != m_spriteSheets.end();
     }
 
     bool ResourceManager::hasFont(const std::string &id) const
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_fonts.find(id) != m_fonts.end();
     }
 
     bool ResourceManager::hasSoundBuffer(const std::string &id) const
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_soundBuffers.find(id) != m_soundBuffers.end();
     }
 
     bool ResourceManager::hasMusic(const std::string &id) const
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_music.find(id) != m_music.end();
     }
 
     bool ResourceManager::hasShader(const std::string &id) const
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_shaders.find(id) != m_shaders.end();
     }
 
     bool ResourceManager::removeTexture(const std::string &id)
     {
-        return m_textures.erase(id) > 0;
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        bool removed = m_textures.erase(id) > 0;
+        return m_textureAtlas.remove(id) || removed;
     }
 
     bool ResourceManager::removeSpriteSheet(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_spriteSheets.erase(id) > 0;
     }
 
     bool ResourceManager::removeFont(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_fonts.erase(id) > 0;
     }
 
     bool ResourceManager::removeSoundBuffer(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_soundBuffers.erase(id) > 0;
     }
 
     bool ResourceManager::removeMusic(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_music.erase(id) > 0;
     }
 
     bool ResourceManager::removeShader(const std::string &id)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_shaders.erase(id) > 0;
     }
 
     void ResourceManager::clear()
     {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         m_textures.clear();
+        m_textureAtlas.clear();
         m_spriteSheets.clear();
         m_fonts.clear();
         m_soundBuffers.clear();
@@ -425,6 +508,9 @@ namespace Resources
             return;
         }
 
+        // Held for the whole scan, which reads the resource paths throughout
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
         // Initialize with the directory as base path
         init(directory);
 
@@ -0,0 +1,486 @@
+#include "../../include/Resources/TextureAtlas.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace Resources
+{
+
+    namespace
+    {
+        const char *const CACHE_MANIFEST = "atlas.json";
+
+        /**
+         * @brief Free space of one page, as the maximal free rectangles of the MaxRects algorithm
+         */
+        class MaxRectsBin
+        {
+        public:
+            explicit MaxRectsBin(sf::Vector2i size)
+                : m_free{sf::IntRect({0, 0}, size)}, m_usedSize(0, 0)
+            {
+            }
+
+            /**
+             * @brief Place a rectangle where it leaves the shortest leftover side
+             * @param size Size of the rectangle
+             * @param position Receives the top-left corner of the placed rectangle
+             * @return false if the rectangle does not fit
+             */
+            bool insert(sf::Vector2i size, sf::Vector2i &position)
+            {
+                int bestShortSide = std::numeric_limits<int>::max();
+                int bestLongSide = std::numeric_limits<int>::max();
+                for (const sf::IntRect &free : m_free)
+                {
+                    if (free.size.x < size.x || free.size.y < size.y)
+                    {
+                        continue;
+                    }
+
+                    int leftoverX = free.size.x - size.x;
+                    int leftoverY = free.size.y - size.y;
+                    int shortSide = std::min(leftoverX, leftoverY);
+                    int longSide = std::max(leftoverX, leftoverY);
+                    if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+                    {
+                        bestShortSide = shortSide;
+                        bestLongSide = longSide;
+                        position = free.position;
+                    }
+                }
+
+                if (bestShortSide == std::numeric_limits<int>::max())
+                {
+                    return false;
+                }
+
+                sf::IntRect used(position, size);
+                split(used);
+                prune();
+                m_usedSize.x = std::max(m_usedSize.x, position.x + size.x);
+                m_usedSize.y = std::max(m_usedSize.y, position.y + size.y);
+                return true;
+            }
+
+            /**
+             * @brief Get the extent of the placed rectangles
+             * @return Smallest size containing every placed rectangle
+             */
+            sf::Vector2i getUsedSize() const
+            {
+                return m_usedSize;
+            }
+
+        private:
+            // Replace the free rectangles overlapping the used one by their parts around it
+            void split(const sf::IntRect &used)
+            {
+                std::vector<sf::IntRect> parts;
+                for (auto it = m_free.begin(); it != m_free.end();)
+                {
+                    const sf::IntRect free = *it;
+                    if (!free.findIntersection(used))
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    int freeRight = free.position.x + free.size.x;
+                    int freeBottom = free.position.y + free.size.y;
+                    int usedRight = used.position.x + used.size.x;
+                    int usedBottom = used.position.y + used.size.y;
+                    if (used.position.x > free.position.x)
+                    {
+                        parts.emplace_back(free.position, sf::Vector2i(used.position.x - free.position.x, free.size.y));
+                    }
+                    if (usedRight < freeRight)
+                    {
+                        parts.emplace_back(sf::Vector2i(usedRight, free.position.y), sf::Vector2i(freeRight - usedRight, free.size.y));
+                    }
+                    if (used.position.y > free.position.y)
+                    {
+                        parts.emplace_back(free.position, sf::Vector2i(free.size.x, used.position.y - free.position.y));
+                    }
+                    if (usedBottom < freeBottom)
+                    {
+                        parts.emplace_back(sf::Vector2i(free.position.x, usedBottom), sf::Vector2i(free.size.x, freeBottom - usedBottom));
+                    }
+                    it = m_free.erase(it);
+                }
+                m_free.insert(m_free.end(), parts.begin(), parts.end());
+            }
+
+            // Remove the free rectangles contained in another one
+            void prune()
+            {
+                for (std::size_t i = 0; i < m_free.size(); ++i)
+                {
+                    for (std::size_t j = i + 1; j < m_free.size(); ++j)
+                    {
+                        if (contains(m_free[j], m_free[i]))
+                        {
+                            m_free.erase(m_free.begin() + static_cast<std::ptrdiff_t>(i));
+                            --i;
+                            break;
+                        }
+                        if (contains(m_free[i], m_free[j]))
+                        {
+                            m_free.erase(m_free.begin() + static_cast<std::ptrdiff_t>(j));
+                            --j;
+                        }
+                    }
+                }
+            }
+
+            static bool contains(const sf::IntRect &outer, const sf::IntRect &inner)
+            {
+                return inner.position.x >= outer.position.x && inner.position.y >= outer.position.y &&
+                       inner.position.x + inner.size.x <= outer.position.x + outer.size.x &&
+                       inner.position.y + inner.size.y <= outer.position.y + outer.size.y;
+            }
+
+            std::vector<sf::IntRect> m_free;
+            sf::Vector2i m_usedSize;
+        };
+    }
+
+    TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding, unsigned int extrusion)
+        : m_pageSize(std::max(pageSize, 1u)), m_padding(padding), m_extrusion(extrusion), m_smooth(false)
+    {
+    }
+
+    void TextureAtlas::add(const std::string &id, const std::string &filePath)
+    {
+        m_pending.push_back(PendingImage{id, filePath});
+    }
+
+    bool TextureAtlas::build(const std::string &cacheDirectory)
+    {
+        if (m_pending.empty())
+        {
+            return true;
+        }
+
+        std::string signature = getSignature();
+        if (!cacheDirectory.empty() && loadCache(cacheDirectory, signature))
+        {
+            std::cout << "Texture atlas loaded from cache: " << cacheDirectory << std::endl;
+            m_pending.clear();
+            return true;
+        }
+
+        // Decode the images, leaving out the unreadable ones
+        bool complete = true;
+        std::vector<sf::Image> images;
+        std::vector<std::string> ids;
+        images.reserve(m_pending.size());
+        for (const PendingImage &pending : m_pending)
+        {
+            sf::Image image;
+            if (!image.loadFromFile(std::filesystem::path(pending.filePath)))
+            {
+                std::cerr << "Failed to load atlas image: " << pending.filePath << std::endl;
+                complete = false;
+                continue;
+            }
+            images.push_back(std::move(image));
+            ids.push_back(pending.id);
+        }
+        m_pending.clear();
+
+        // Largest images first: they are the hardest to fit
+        std::vector<std::size_t> order(images.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&images](std::size_t a, std::size_t b)
+                  {
+            sf::Vector2u sizeA = images[a].getSize();
+            sf::Vector2u sizeB = images[b].getSize();
+            unsigned int sideA = std::max(sizeA.x, sizeA.y);
+            unsigned int sideB = std::max(sizeB.x, sizeB.y);
+            if (sideA != sideB)
+            {
+                return sideA > sideB;
+            }
+            return sizeA.x * sizeA.y > sizeB.x * sizeB.y; });
+
+        // Each image takes its extruded size plus the padding on its right and bottom
+        const int border = static_cast<int>(m_extrusion);
+        const int pageSize = static_cast<int>(m_pageSize);
+        std::vector<MaxRectsBin> bins;
+        std::vector<PackedImage> packed;
+        packed.reserve(images.size());
+        for (std::size_t index : order)
+        {
+            sf::Vector2i imageSize(images[index].getSize());
+            sf::Vector2i slot = imageSize + sf::Vector2i(2 * border + static_cast<int>(m_padding),
+                                                         2 * border + static_cast<int>(m_padding));
+
+            // First page with room; an image larger than a page gets a page of its size
+            bool oversized = slot.x > pageSize || slot.y > pageSize;
+            sf::Vector2i position;
+            std::size_t page = 0;
+            while (!oversized && page < bins.size() && !bins[page].insert(slot, position))
+            {
+                ++page;
+            }
+            if (oversized || page == bins.size())
+            {
+                bins.emplace_back(oversized ? slot : sf::Vector2i(pageSize, pageSize));
+                page = bins.size() - 1;
+                bins[page].insert(slot, position);
+            }
+
+            packed.push_back(PackedImage{ids[index], page, sf::IntRect(position + sf::Vector2i(border, border), imageSize)});
+        }
+
+        // Compose the pages, cropped to their content; the padding is left transparent
+        std::vector<sf::Image> pages(bins.size());
+        for (std::size_t page = 0; page < bins.size(); ++page)
+        {
+            pages[page].resize(sf::Vector2u(bins[page].getUsedSize()), sf::Color::Transparent);
+        }
+        for (std::size_t i = 0; i < packed.size(); ++i)
+        {
+            const sf::Image &image = images[order[i]];
+            extrude(pages[packed[i].page], image, sf::Vector2u(packed[i].rect.position));
+        }
+
+        std::vector<std::unique_ptr<sf::Texture>> textures;
+        for (const sf::Image &page : pages)
+        {
+            auto texture = std::make_unique<sf::Texture>();
+            if (!texture->loadFromImage(page))
+            {
+                std::cerr << "Failed to create atlas page of " << page.getSize().x << "x" << page.getSize().y << std::endl;
+                return false;
+            }
+            textures.push_back(std::move(texture));
+        }
+        addPages(textures, packed);
+
+        std::cout << "Texture atlas built: " << packed.size() << " images in " << pages.size() << " pages" << std::endl;
+
+        // A partial atlas is not cached, so that the missing images are retried next time
+        if (complete && !cacheDirectory.empty())
+        {
+            saveCache(cacheDirectory, signature, pages, packed);
+        }
+        return complete;
+    }
+
+    void TextureAtlas::setSmooth(bool smooth)
+    {
+        m_smooth = smooth;
+        for (auto &page : m_pages)
+        {
+            page->setSmooth(smooth);
+        }
+    }
+
+    bool TextureAtlas::contains(const std::string &id) const
+    {
+        return m_regions.find(id) != m_regions.end();
+    }
+
+    const TextureRegion &TextureAtlas::getRegion(const std::string &id) const
+    {
+        auto it = m_regions.find(id);
+        if (it == m_regions.end())
+        {
+            throw std::out_of_range("Atlas region does not exist: " + id);
+        }
+
+        return it->second;
+    }
+
+    bool TextureAtlas::remove(const std::string &id)
+    {
+        return m_regions.erase(id) > 0;
+    }
+
+    void TextureAtlas::clear()
+    {
+        m_pending.clear();
+        m_regions.clear();
+        m_pages.clear();
+    }
+
+    std::size_t TextureAtlas::getPageCount() const
+    {
+        return m_pages.size();
+    }
+
+    std::string TextureAtlas::getSignature() const
+    {
+        // Settings, then every image with its file size and modification time
+        std::string signature = std::to_string(m_pageSize) + "/" + std::to_string(m_padding) + "/" +
+                                std::to_string(m_extrusion) + "\n";
+        for (const PendingImage &pending : m_pending)
+        {
+            std::error_code sizeError;
+            std::error_code timeError;
+            std::filesystem::path path(pending.filePath);
+            auto size = std::filesystem::file_size(path, sizeError);
+            auto time = std::filesystem::last_write_time(path, timeError);
+
+            signature += pending.id + "|" + pending.filePath + "|";
+            signature += sizeError ? "-" : std::to_string(size);
+            signature += "|";
+            signature += timeError ? "-" : std::to_string(time.time_since_epoch().count());
+            signature += "\n";
+        }
+        return signature;
+    }
+
+    bool TextureAtlas::loadCache(const std::string &cacheDirectory, const std::string &signature)
+    {
+        std::filesystem::path directory(cacheDirectory);
+        std::ifstream file(directory / CACHE_MANIFEST);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        try
+        {
+            nlohmann::json manifest = nlohmann::json::parse(file);
+            if (manifest.at("signature").get<std::string>() != signature)
+            {
+                return false;
+            }
+
+            std::vector<std::unique_ptr<sf::Texture>> textures;
+            for (const nlohmann::json &page : manifest.at("pages"))
+            {
+                auto texture = std::make_unique<sf::Texture>();
+                if (!texture->loadFromFile(directory / page.get<std::string>()))
+                {
+                    return false;
+                }
+                textures.push_back(std::move(texture));
+            }
+
+            std::vector<PackedImage> packed;
+            for (const nlohmann::json &region : manifest.at("regions"))
+            {
+                std::size_t page = region.at("page").get<std::size_t>();
+                if (page >= textures.size())
+                {
+                    return false;
+                }
+                packed.push_back(PackedImage{region.at("id").get<std::string>(), page,
+                                             sf::IntRect({region.at("x").get<int>(), region.at("y").get<int>()},
+                                                         {region.at("width").get<int>(), region.at("height").get<int>()})});
+            }
+
+            addPages(textures, packed);
+            return true;
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            std::cerr << "Ignoring invalid texture atlas cache: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    void TextureAtlas::saveCache(const std::string &cacheDirectory, const std::string &signature,
+                                 const std::vector<sf::Image> &pages, const std::vector<PackedImage> &packed) const
+    {
+        std::filesystem::path directory(cacheDirectory);
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+
+        nlohmann::json manifest;
+        manifest["signature"] = signature;
+        manifest["pages"] = nlohmann::json::array();
+        for (std::size_t page = 0; page < pages.size(); ++page)
+        {
+            std::string fileName = "atlas_" + std::to_string(page) + ".png";
+            if (!pages[page].saveToFile(directory / fileName))
+            {
+                std::cerr << "Failed to save texture atlas cache: " << (directory / fileName).string() << std::endl;
+                return;
+            }
+            manifest["pages"].push_back(fileName);
+        }
+
+        manifest["regions"] = nlohmann::json::array();
+        for (const PackedImage &image : packed)
+        {
+            manifest["regions"].push_back({{"id", image.id},
+                                           {"page", image.page},
+                                           {"x", image.rect.position.x},
+                                           {"y", image.rect.position.y},
+                                           {"width", image.rect.size.x},
+                                           {"height", image.rect.size.y}});
+        }
+
+        // The manifest goes last: pages without one are never used
+        std::ofstream file(directory / CACHE_MANIFEST);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to save texture atlas cache: " << (directory / CACHE_MANIFEST).string() << std::endl;
+            return;
+        }
+        file << manifest.dump(2);
+    }
+
+    void TextureAtlas::extrude(sf::Image &page, const sf::Image &image, sf::Vector2u position) const
+    {
+        sf::Vector2i size(image.getSize());
+        if (size.x == 0 || size.y == 0)
+        {
+            return;
+        }
+
+        if (!page.copy(image, position))
+        {
+            std::cerr << "Failed to copy an image into an atlas page" << std::endl;
+            return;
+        }
+
+        // Repeat the edge pixels around the image: rows above and below, then columns on both sides
+        const int border = static_cast<int>(m_extrusion);
+        for (int y = -border; y < size.y + border; ++y)
+        {
+            bool edgeRow = y < 0 || y >= size.y;
+            unsigned int sourceY = static_cast<unsigned int>(std::clamp(y, 0, size.y - 1));
+            for (int x = -border; x < size.x + border; ++x)
+            {
+                if (!edgeRow && x == 0)
+                {
+                    // Skip the copied pixels
+                    x = size.x - 1;
+                    continue;
+                }
+
+                unsigned int sourceX = static_cast<unsigned int>(std::clamp(x, 0, size.x - 1));
+                page.setPixel(sf::Vector2u(static_cast<unsigned int>(static_cast<int>(position.x) + x),
+                                           static_cast<unsigned int>(static_cast<int>(position.y) + y)),
+                              image.getPixel({sourceX, sourceY}));
+            }
+        }
+    }
+
+    void TextureAtlas::addPages(std::vector<std::unique_ptr<sf::Texture>> &pages, const std::vector<PackedImage> &packed)
+    {
+        std::size_t firstPage = m_pages.size();
+        for (auto &page : pages)
+        {
+            page->setSmooth(m_smooth);
+            m_pages.push_back(std::move(page));
+        }
+
+        for (const PackedImage &image : packed)
+        {
+            m_regions[image.id] = TextureRegion{m_pages[firstPage + image.page].get(), image.rect};
+        }
+    }
+
+} // namespace Resources
@@ -1,14 +1,18 @@
 #include "../../include/Resources/TiledMapLoader.hpp"
+#include "../../include/Graphics/RenderQueue.hpp"
 #include "../../include/Resources/ResourceManager.hpp"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
 #include "../../lib/tileson/tileson.hpp"
 
 namespace Resources
 {
 
     TiledMapLoader::TiledMapLoader(ResourceManager &resourceManager)
-        : m_resourceManager(resourceManager), m_mapSize(0, 0), m_tileSize(0, 0)
+        : m_resourceManager(resourceManager), m_mapSize(0, 0), m_tileSize(0, 0), m_parallaxOrigin(0.f, 0.f)
     {
         std::cout << "TiledMapLoader created" << std::endl;
     }
@@ -42,6 +46,7 @@ namespace Resources
             m_tileSize.y = m_map->getTileSize().y;
             m_mapSize.x = m_map->getSize().x;
             m_mapSize.y = m_map->getSize().y;
+            m_parallaxOrigin = sf::Vector2f(m_map->getParallaxOrigin().x, m_map->getParallaxOrigin().y);
 
             // Charger tous les tilesets
             for (auto &tileset : m_map->getTilesets())
@@ -79,30 +84,80 @@ namespace Resources
         }
     }
 
-    void TiledMapLoader::draw(sf::RenderTarget &target, sf::RenderStates states) const
+    template <typename Func>
+    void TiledMapLoader::forEachVisibleChunk(const sf::View &view, const sf::Transform &transform, Func &&func) const
     {
-        // Dessiner toutes les couches de tuiles
-        for (const auto &layer : m_tileLayers)
+        // Zone vue par la caméra, rotation comprise, dans le repère de la carte
+        sf::FloatRect viewBounds = view.getInverseTransform().transformRect(sf::FloatRect({-1.f, -1.f}, {2.f, 2.f}));
+        viewBounds = transform.getInverse().transformRect(viewBounds);
+
+        for (std::size_t i = 0; i < m_tileLayers.size(); ++i)
         {
-            if (layer.visible)
+            const TileLayer &layer = m_tileLayers[i];
+            if (!layer.visible)
             {
-                sf::RenderStates layerStates = states;
-
-                // Appliquer l'opacité et le décalage
-                sf::Transform transform;
-                transform.translate(layer.offset);
-                layerStates.transform *= transform;
+                continue;
+            }
 
-                for (const auto &sprite : layer.sprites)
+            sf::Vector2f translation = getLayerTranslation(layer, view.getCenter());
+            sf::FloatRect area(viewBounds.position - translation, viewBounds.size);
+            for (const TileChunk &chunk : layer.chunks)
+            {
+                if (chunk.bounds.findIntersection(area))
                 {
-                    sf::Sprite s = sprite;
-                    s.setColor(sf::Color(255, 255, 255, static_cast<uint8_t>(255 * layer.opacity)));
-                    target.draw(s, layerStates);
+                    func(i, chunk, translation);
                 }
             }
         }
     }
 
+    void TiledMapLoader::draw(sf::RenderTarget &target, sf::RenderStates states) const
+    {
+        forEachVisibleChunk(target.getView(), states.transform, [&](std::size_t, const TileChunk &chunk, const sf::Vector2f &translation)
+                            {
+            sf::RenderStates chunkStates = states;
+            chunkStates.transform.translate(translation);
+            chunkStates.texture = chunk.texture;
+            if (chunk.vertices.empty())
+            {
+                target.draw(chunk.vertexBuffer, chunkStates);
+            }
+            else
+            {
+                target.draw(chunk.vertices.data(), chunk.vertices.size(), sf::PrimitiveType::Triangles, chunkStates);
+            } });
+    }
+
+    void TiledMapLoader::enqueue(Graphics::RenderQueue &queue, const sf::View &view, int firstLayer) const
+    {
+        forEachVisibleChunk(view, sf::Transform::Identity, [&](std::size_t layerIndex, const TileChunk &chunk, const sf::Vector2f &translation)
+                            {
+            sf::RenderStates chunkStates;
+            chunkStates.transform.translate(translation);
+            chunkStates.texture = chunk.texture;
+
+            // Une couche de dessin par couche de tuiles
+            int drawLayer = firstLayer + static_cast<int>(layerIndex);
+            float depth = chunk.bounds.position.y + chunk.bounds.size.y + translation.y;
+            if (chunk.vertices.empty())
+            {
+                queue.addDrawable(chunk.vertexBuffer, chunkStates, drawLayer, depth);
+            }
+            else
+            {
+                queue.addTriangles(chunk.vertices.data(), chunk.vertices.size(), chunkStates, drawLayer, depth);
+            } });
+    }
+
+    sf::Vector2f TiledMapLoader::getLayerTranslation(const TileLayer &layer, const sf::Vector2f &viewCenter) const
+    {
+        // Comme Tiled : une couche de facteur f suit la caméra de (1 - f) fois son
+        // déplacement depuis l'origine de la parallaxe ; à 1, elle reste fixe sur la carte
+        sf::Vector2f cameraOffset = viewCenter - m_parallaxOrigin;
+        return layer.offset + sf::Vector2f(cameraOffset.x * (1.f - layer.parallaxFactor.x),
+                                           cameraOffset.y * (1.f - layer.parallaxFactor.y));
+    }
+
     sf::Vector2f TiledMapLoader::getMapSize() const
     {
         return sf::Vector2f(m_mapSize.x * m_tileSize.x, m_mapSize.y * m_tileSize.y);
@@ -138,46 +193,36 @@ namespace Resources
         return {};
     }
 
-    std::vector<MapObject> TiledMapLoader::getObjectsByType(const std::string &type) const
+    void TiledMapLoader::getObjectsByType(const std::string &type, Core::FrameVector<const MapObject *> &result) const
     {
-        std::vector<MapObject> result;
-
         for (const auto &[layerName, objects] : m_objectLayers)
         {
             for (const auto &obj : objects)
             {
                 if (obj.type == type)
                 {
-                    result.push_back(obj);
+                    result.push_back(&obj);
                 }
             }
         }
-
-        return result;
     }
 
-    std::vector<MapObject> TiledMapLoader::getObjectsByName(const std::string &name) const
+    void TiledMapLoader::getObjectsByName(const std::string &name, Core::FrameVector<const MapObject *> &result) const
     {
-        std::vector<MapObject> result;
-
         for (const auto &[layerName, objects] : m_objectLayers)
         {
             for (const auto &obj : objects)
             {
                 if (obj.name == name)
                 {
-                    result.push_back(obj);
+                    result.push_back(&obj);
                 }
             }
         }
-
-        return result;
     }
 
-    std::vector<MapObject> TiledMapLoader::getCollidableObjects() const
+    void TiledMapLoader::getCollidableObjects(Core::FrameVector<const MapObject *> &result) const
     {
-        std::vector<MapObject> result;
-
         for (const auto &[layerName, objects] : m_objectLayers)
         {
             for (const auto &obj : objects)
@@ -185,12 +230,10 @@ namespace Resources
                 auto it = obj.properties.find("collidable");
                 if (it != obj.properties.end() && it->second == "true")
                 {
-                    result.push_back(obj);
+                    result.push_back(&obj);
                 }
             }
         }
-
-        return result;
     }
 
     void TiledMapLoader::parseTileLayer(const tson::Layer *layer)
@@ -261,7 +304,67 @@ namespace Resources
             }
         }
 
-        m_tileLayers.push_back(tileLayer);
+        bakeChunks(tileLayer);
+        m_tileLayers.push_back(std::move(tileLayer));
+    }
+
+    void TiledMapLoader::bakeChunks(TileLayer &layer) const
+    {
+        // Un bloc par carré de CHUNK_SIZE x CHUNK_SIZE tuiles et par tileset
+        const sf::Vector2f chunkSize(static_cast<float>(std::max(m_tileSize.x, 1) * CHUNK_SIZE),
+                                     static_cast<float>(std::max(m_tileSize.y, 1) * CHUNK_SIZE));
+        const sf::Color color(255, 255, 255, static_cast<uint8_t>(255 * std::clamp(layer.opacity, 0.f, 1.f)));
+
+        std::map<std::tuple<int, int, const sf::Texture *>, std::size_t> chunkIndices;
+        std::vector<std::vector<sf::Vertex>> chunkVertices;
+
+        for (const auto &sprite : layer.sprites)
+        {
+            const sf::Vector2f position = sprite.getPosition();
+            const auto key = std::make_tuple(static_cast<int>(std::floor(position.x / chunkSize.x)),
+                                             static_cast<int>(std::floor(position.y / chunkSize.y)),
+                                             &sprite.getTexture());
+            const sf::FloatRect spriteBounds = sprite.getGlobalBounds();
+
+            auto [it, inserted] = chunkIndices.try_emplace(key, layer.chunks.size());
+            if (inserted)
+            {
+                layer.chunks.emplace_back();
+                layer.chunks.back().texture = &sprite.getTexture();
+                layer.chunks.back().bounds = spriteBounds;
+                chunkVertices.emplace_back();
+            }
+
+            // Les grandes tuiles peuvent déborder du bloc
+            TileChunk &chunk = layer.chunks[it->second];
+            sf::Vector2f topLeft(std::min(chunk.bounds.position.x, spriteBounds.position.x),
+                                 std::min(chunk.bounds.position.y, spriteBounds.position.y));
+            sf::Vector2f bottomRight(std::max(chunk.bounds.position.x + chunk.bounds.size.x, spriteBounds.position.x + spriteBounds.size.x),
+                                     std::max(chunk.bounds.position.y + chunk.bounds.size.y, spriteBounds.position.y + spriteBounds.size.y));
+            chunk.bounds = sf::FloatRect(topLeft, bottomRight - topLeft);
+
+            // Deux triangles par tuile, avec la géométrie de sf::Sprite
+            const sf::Transform &transform = sprite.getTransform();
+            const sf::FloatRect rect(sprite.getTextureRect());
+            const sf::Vector2f size(std::abs(rect.size.x), std::abs(rect.size.y));
+            const sf::Vertex tl{transform.transformPoint({0.f, 0.f}), color, rect.position};
+            const sf::Vertex bl{transform.transformPoint({0.f, size.y}), color, {rect.position.x, rect.position.y + rect.size.y}};
+            const sf::Vertex tr{transform.transformPoint({size.x, 0.f}), color, {rect.position.x + rect.size.x, rect.position.y}};
+            const sf::Vertex br{transform.transformPoint(size), color, rect.position + rect.size};
+            chunkVertices[it->second].insert(chunkVertices[it->second].end(), {tl, bl, tr, tr, bl, br});
+        }
+
+        // Envoyés une fois pour toutes ; gardés en mémoire seulement sans vertex buffers
+        for (std::size_t i = 0; i < layer.chunks.size(); ++i)
+        {
+            TileChunk &chunk = layer.chunks[i];
+            std::vector<sf::Vertex> &vertices = chunkVertices[i];
+            if (!sf::VertexBuffer::isAvailable() || !chunk.vertexBuffer.create(vertices.size()) ||
+                !chunk.vertexBuffer.update(vertices.data()))
+            {
+                chunk.vertices = std::move(vertices);
+            }
+        }
     }
 
     void TiledMapLoader::parseObjectLayer(const tson::Layer *layer)
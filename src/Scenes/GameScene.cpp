@@ -1,5 +1,6 @@
 #include "../../include/Scenes/GameScene.hpp"
 #include "../../include/Engine.hpp"
+#include "../../include/Graphics/RenderSnapshot.hpp"
 #include <iostream>
 #include <SFML/Graphics.hpp>
 
@@ -42,6 +43,12 @@ namespace Scenes
         // mais nous pouvons ajouter du rendu spécifique à la scène ici
     }
 
+    bool GameScene::capture(Graphics::RenderSnapshot &)
+    {
+        // Rien de plus que les sprites du système de rendu
+        return true;
+    }
+
     void GameScene::handleEvent(const sf::Event &event)
     {
         // Gestion des événements spécifiques à la scène
@@ -1,6 +1,8 @@
 #include "../../include/Scenes/MainMenuScene.hpp"
 #include "../../include/Engine.hpp"
 #include "../../include/Scenes/GameScene.hpp"
+#include "../../include/Core/SceneManager.hpp"
+#include "../../include/Graphics/RenderSnapshot.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -16,7 +18,7 @@ namespace Scenes
     MainMenuScene::MainMenuScene(Core::Engine &engine)
         : Scene("MainMenu"), m_engine(engine), m_showDemosList(false),
           m_selectedDemo(0), m_selectedItem(0), m_music(nullptr),
-          m_transitionAlpha(0.0f), m_isTransitioning(false), m_selectionSound(nullptr)
+          m_transitionAlpha(0.0f), m_isTransitioning(false), m_selectionSound(nullptr), m_resourcesLoaded(false)
     {
         std::cout << "MainMenuScene created" << std::endl;
     }
@@ -41,7 +43,7 @@ namespace Scenes
         }
     }
 
-    void MainMenuScene::init()
+    void MainMenuScene::load()
     {
         // Load font
         try
@@ -59,8 +61,6 @@ namespace Scenes
         try
         {
             m_resourceManager.loadSoundBuffer("menu_change", "resources/sounds/se/002-System02.ogg");
-            m_selectionSound = new sf::Sound(m_resourceManager.getSoundBuffer("menu_change"));
-            m_selectionSound->setVolume(80.0f);
         }
         catch (const std::exception &e)
         {
@@ -80,6 +80,30 @@ namespace Scenes
             return;
         }
 
+        m_resourcesLoaded = true;
+    }
+
+    void MainMenuScene::init()
+    {
+        // Load the game scene in the background while the menu is shown
+        if (!m_gameScene)
+        {
+            m_gameScene = std::make_shared<GameScene>(m_engine);
+            m_engine.getSceneManager().preload(m_gameScene);
+        }
+
+        // Failures were reported by load()
+        if (!m_resourcesLoaded)
+        {
+            return;
+        }
+
+        if (m_resourceManager.hasSoundBuffer("menu_change"))
+        {
+            m_selectionSound = new sf::Sound(m_resourceManager.getSoundBuffer("menu_change"));
+            m_selectionSound->setVolume(80.0f);
+        }
+
         // Create title text
         try
         {
@@ -271,67 +295,78 @@ namespace Scenes
         }
     }
 
-    void MainMenuScene::render(sf::RenderWindow &window)
+    template <typename Target>
+    void MainMenuScene::drawMenu(Target &target, const sf::Vector2u &windowSize)
     {
         // Draw background
         if (m_background)
         {
-            window.draw(*m_background);
+            target.draw(*m_background);
         }
 
         // Draw title overlay background
         if (m_backgroundSprite)
         {
-            window.draw(*m_backgroundSprite);
+            target.draw(*m_backgroundSprite);
         }
 
         // Draw title
         if (m_titleText)
         {
-            window.draw(*m_titleText);
+            target.draw(*m_titleText);
         }
 
         // Draw menu items
         for (auto &item : m_menuItems)
         {
-            window.draw(item);
+            target.draw(item);
         }
 
         // Draw demos list if examples menu is active
         if (m_showDemosList)
         {
             // Draw semi-transparent background
-            sf::Vector2u windowSize = window.getSize();
             sf::RectangleShape overlay(sf::Vector2f(windowSize.x, windowSize.y));
             overlay.setFillColor(sf::Color(0, 0, 0, 200));
-            window.draw(overlay);
+            target.draw(overlay);
 
             // Draw demos title
             if (m_demosTitle)
             {
-                window.draw(*m_demosTitle);
+                target.draw(*m_demosTitle);
             }
 
             // Draw demos list
             for (auto &item : m_demoItems)
             {
-                window.draw(item);
+                target.draw(item);
             }
 
             // Draw back instruction
             if (m_backText)
             {
-                window.draw(*m_backText);
+                target.draw(*m_backText);
             }
 
             // Draw coming soon message
             if (m_comingSoonText)
             {
-                window.draw(*m_comingSoonText);
+                target.draw(*m_comingSoonText);
             }
         }
     }
 
+    void MainMenuScene::render(sf::RenderWindow &window)
+    {
+        drawMenu(window, window.getSize());
+    }
+
+    bool MainMenuScene::capture(Graphics::RenderSnapshot &snapshot)
+    {
+        drawMenu(snapshot, m_engine.getWindow().getSize());
+        return true;
+    }
+
     void MainMenuScene::handleEvent(const sf::Event &event)
     {
         // Skip input during initial transition
@@ -400,13 +435,13 @@ namespace Scenes
                     switch (m_selectedItem)
                     {
                     case 0: // New Game
-                        // TODO: Create and set GameScene when implemented
-                        // For now, let's just show a placeholder effect
+                        // Highlight the title until the game scene, preloaded in init(), takes over
                         if (m_titleText)
                         {
                             m_titleText->setFillColor(sf::Color(0, 255, 128));
                             m_titleText->setOutlineColor(sf::Color(0, 128, 64));
                         }
+                        m_engine.getSceneManager().replace(m_gameScene);
                         break;
                     case 1: // Examples
                         showDemosList();
@@ -415,7 +450,8 @@ namespace Scenes
                         // TODO: Show options screen
                         break;
                     case 3: // Exit
-                        m_engine.shutdown();
+                        // Leave the main loop; the engine shuts down once this scene is no longer running
+                        m_engine.getWindow().close();
                         break;
                     }
                 }
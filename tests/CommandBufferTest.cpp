@@ -0,0 +1,89 @@
+#include "Core/CommandBuffer.hpp"
+#include "TestMain.hpp"
+
+using Test::check;
+
+// Checks that a command buffer applies the additions and removals of a
+// component in the order they were recorded, for existing entities and
+// for entities it creates itself
+namespace
+{
+    struct Health : public Core::Component
+    {
+        explicit Health(int value = 0) : value(value) {}
+        int value;
+    };
+
+    struct Speed : public Core::Component
+    {
+        explicit Speed(float value = 0.f) : value(value) {}
+        float value;
+    };
+}
+
+int main()
+{
+    Core::EntityManager entityManager;
+    Core::CommandBuffer commands;
+
+    Core::Entity *added = entityManager.createEntity("added");
+    Core::Entity *readded = entityManager.createEntity("readded");
+    readded->addComponent<Health>(10);
+    Core::Entity *bystander = entityManager.createEntity("bystander");
+    bystander->addComponent<Health>(5);
+
+    // Add then remove: the entity ends without the component
+    commands.addComponent<Health>(added->getHandle(), 1);
+    commands.removeComponent<Health>(added->getHandle());
+
+    // Remove then add: the entity ends with the new component
+    commands.removeComponent<Health>(readded->getHandle());
+    commands.addComponent<Health>(readded->getHandle(), 20);
+
+    // Interleaved with the changes of another type and entity
+    commands.addComponent<Speed>(bystander->getHandle(), 2.f);
+    commands.apply(entityManager);
+
+    check(!added->hasComponent<Health>(), "Adding then removing a component leaves the entity without it");
+    const Health *health = readded->getComponent<Health>();
+    check(health && health->value == 20, "Removing then adding a component leaves the entity with the new one");
+    check(bystander->getComponent<Health>()->value == 5 && bystander->getComponent<Speed>()->value == 2.f,
+          "Other entities only receive their own changes");
+
+    // Several changes in a row: the last one wins
+    commands.addComponent<Health>(added->getHandle(), 1);
+    commands.removeComponent<Health>(added->getHandle());
+    commands.addComponent<Health>(added->getHandle(), 3);
+    commands.removeComponent<Health>(readded->getHandle());
+    commands.addComponent<Health>(readded->getHandle(), 30);
+    commands.removeComponent<Health>(readded->getHandle());
+    commands.apply(entityManager);
+    health = added->getComponent<Health>();
+    check(health && health->value == 3 && !readded->hasComponent<Health>(), "The last change recorded wins");
+
+    // The same orders on an entity created by the buffer
+    Core::CommandBuffer::EntityRef first = commands.createEntity("first");
+    Core::CommandBuffer::EntityRef second = commands.createEntity("second");
+    commands.addComponent<Health>(first, 1);
+    commands.removeComponent<Health>(first);
+    commands.removeComponent<Health>(second);
+    commands.addComponent<Health>(second, 2);
+    commands.apply(entityManager);
+
+    Core::Entity *createdFirst = entityManager.getEntity(commands.getCreatedEntities()[0]);
+    Core::Entity *createdSecond = entityManager.getEntity(commands.getCreatedEntities()[1]);
+    check(createdFirst && createdFirst->getName() == "first" && createdSecond && createdSecond->getName() == "second",
+          "Created entities are listed in creation order");
+    check(createdFirst && !createdFirst->hasComponent<Health>() && createdSecond &&
+              createdSecond->getComponent<Health>() && createdSecond->getComponent<Health>()->value == 2,
+          "Created entities keep the recording order too");
+
+    // Destroying an entity wins over any later change
+    commands.destroyEntity(bystander->getHandle());
+    commands.addComponent<Health>(bystander->getHandle(), 7);
+    Core::EntityHandle bystanderHandle = bystander->getHandle();
+    commands.apply(entityManager);
+    check(!entityManager.isAlive(bystanderHandle) && commands.empty(), "Destroying an entity wins, and apply clears the buffer");
+
+    return Test::result();
+}
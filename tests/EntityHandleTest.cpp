@@ -0,0 +1,62 @@
+#include "Core/EntityManager.hpp"
+#include "TestMain.hpp"
+
+using Test::check;
+
+// Checks that entity slots are recycled with a new generation, so that
+// handles to removed entities never resolve to the slot's next occupant
+namespace
+{
+    struct Marker : public Core::Component
+    {
+        explicit Marker(int value = 0) : value(value) {}
+        int value;
+    };
+}
+
+int main()
+{
+    Core::EntityManager entityManager;
+
+    Core::Entity *first = entityManager.createEntity("first");
+    first->addComponent<Marker>(1);
+    Core::EntityHandle firstHandle = first->getHandle();
+    Core::EntityId firstId = first->getId();
+
+    check(firstHandle.isValid(), "A new entity has a valid handle");
+    check(entityManager.getEntity(firstHandle) == first, "The handle resolves to its entity");
+    check(Core::EntityHandle::fromId(firstId) == firstHandle, "The packed ID round-trips to the handle");
+
+    // Remove the entity and take its slot again
+    check(entityManager.removeEntity(firstHandle), "The entity is removed");
+    check(!entityManager.isAlive(firstHandle), "The removed entity's handle is stale");
+    check(!entityManager.removeEntity(firstHandle), "A stale handle cannot remove anything");
+
+    Core::Entity *second = entityManager.createEntity("second");
+    second->addComponent<Marker>(2);
+    Core::EntityHandle secondHandle = second->getHandle();
+
+    check(secondHandle.index == firstHandle.index, "The freed slot is recycled");
+    check(secondHandle.generation != firstHandle.generation, "The recycled slot has a new generation");
+    check(entityManager.getEntity(firstHandle) == nullptr, "The stale handle does not resolve to the new occupant");
+    check(entityManager.getEntity(firstId) == nullptr, "The stale ID does not resolve to the new occupant");
+    check(entityManager.getEntity(secondHandle) == second, "The new handle resolves to the new occupant");
+    check(second->getComponent<Marker>() && second->getComponent<Marker>()->value == 2,
+          "The new occupant does not inherit the old components");
+
+    // Recycle the same slot many times: every generation stays distinct
+    Core::EntityHandle previous = secondHandle;
+    bool distinct = true;
+    for (int i = 0; i < 1000; ++i)
+    {
+        entityManager.removeEntity(previous);
+        Core::EntityHandle next = entityManager.createEntity()->getHandle();
+        distinct = distinct && next.index == previous.index && next.generation != previous.generation &&
+                   !entityManager.isAlive(previous);
+        previous = next;
+    }
+    check(distinct, "Each reuse of a slot invalidates the handles of the previous occupant");
+    check(entityManager.getEntityCount() == 1, "Only the last occupant is alive");
+
+    return Test::result();
+}
@@ -0,0 +1,118 @@
+#include "Core/FrameArena.hpp"
+#include "TestMain.hpp"
+#include <cstdint>
+#include <thread>
+
+using Test::check;
+
+// Checks the frame arena: alignment, scopes and markers, block merging on
+// reset, arena-backed containers and the per-thread frame arenas
+namespace
+{
+    bool isAligned(const void *pointer, std::size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+    }
+
+    struct Point
+    {
+        float x;
+        float y;
+    };
+}
+
+int main()
+{
+    Core::FrameArena arena(1024);
+
+    // Allocations honour their alignment
+    arena.allocate(1, 1);
+    void *aligned16 = arena.allocate(8, 16);
+    arena.allocate(3, 1);
+    void *aligned64 = arena.allocate(8, 64);
+    check(isAligned(aligned16, 16) && isAligned(aligned64, 64), "Allocations are aligned as requested");
+
+    Point *point = arena.create<Point>(Point{1.f, 2.f});
+    check(point->x == 1.f && point->y == 2.f, "Objects are constructed in place");
+
+    // A scope releases what was allocated inside it, and only that
+    std::size_t usedBefore = arena.getUsedBytes();
+    {
+        Core::FrameArena::Scope scope(arena);
+        arena.allocate(200);
+        arena.allocate(300);
+        check(arena.getUsedBytes() >= usedBefore + 500, "Allocations inside a scope are counted");
+    }
+    check(arena.getUsedBytes() == usedBefore, "Leaving a scope releases its allocations");
+    check(point->x == 1.f && point->y == 2.f, "Leaving a scope keeps the allocations made before it");
+
+    // Nested scopes unwind in order
+    {
+        Core::FrameArena::Scope outer(arena);
+        void *outerAllocation = arena.allocate(64);
+        std::size_t usedInOuter = arena.getUsedBytes();
+        {
+            Core::FrameArena::Scope inner(arena);
+            arena.allocate(64);
+        }
+        check(arena.getUsedBytes() == usedInOuter, "An inner scope only releases its own allocations");
+        check(arena.allocate(64) != outerAllocation, "Memory still in use is not handed out again");
+    }
+    check(arena.getUsedBytes() == usedBefore, "Nested scopes release everything once both are left");
+
+    // A marker taken before a rewind hands the same memory out again
+    Core::FrameArena::Marker marker = arena.getMarker();
+    void *first = arena.allocate(32);
+    arena.rewind(marker);
+    check(arena.allocate(32) == first, "Rewinding reuses the released memory");
+
+    // Outgrow the first block, then reset: the blocks merge into one
+    for (int i = 0; i < 10; ++i)
+    {
+        arena.allocate(512);
+    }
+    std::size_t capacity = arena.getCapacity();
+    std::size_t peak = arena.getPeakBytes();
+    check(capacity > 1024 && peak > 5000, "The arena grows with new blocks when full");
+
+    arena.reset();
+    check(arena.getUsedBytes() == 0 && arena.getPeakBytes() == 0, "Reset releases everything");
+    check(arena.getCapacity() == capacity, "Reset keeps the memory");
+
+    // The same amount now fits without adding a block
+    for (int i = 0; i < 10; ++i)
+    {
+        arena.allocate(512);
+    }
+    check(arena.getCapacity() == capacity, "After a reset, the same frame fits in the merged block");
+
+    // Containers on the arena
+    arena.reset();
+    {
+        Core::FrameArena::Scope scope(arena);
+        Core::FrameVector<int> values{Core::ArenaAllocator<int>(arena)};
+        for (int i = 0; i < 100; ++i)
+        {
+            values.push_back(i);
+        }
+        check(values.size() == 100 && values[99] == 99, "FrameVector stores its elements in the arena");
+        check(arena.getUsedBytes() >= 100 * sizeof(int), "FrameVector memory is counted by the arena");
+    }
+    check(arena.getUsedBytes() == 0, "FrameVector memory is released with its scope");
+
+    // Thread arenas: one per thread, reset by the first use after nextFrame()
+    Core::FrameArena &mainArena = Core::FrameArena::getThreadArena();
+    mainArena.allocate(128);
+    check(mainArena.getUsedBytes() >= 128, "The thread arena keeps its allocations within a frame");
+
+    Core::FrameArena *workerArena = nullptr;
+    std::thread worker([&workerArena]()
+                       { workerArena = &Core::FrameArena::getThreadArena(); });
+    worker.join();
+    check(workerArena != &mainArena, "Each thread has its own frame arena");
+
+    Core::FrameArena::nextFrame();
+    check(Core::FrameArena::getThreadArena().getUsedBytes() == 0, "The thread arena is reset in the next frame");
+
+    return Test::result();
+}
@@ -28,7 +28,7 @@ int main()
                           Physics::CollisionCategory::PLAYER | Physics::CollisionCategory::ENEMY);
 
     // Create player
-    auto &player = entityManager.createEntity<Gameplay::Player>(entityManager, sf::Vector2f(200.0f, 400.0f));
+    auto &player = *entityManager.createEntity<Gameplay::Player>(physics, sf::Vector2f(200.0f, 400.0f));
     player.initialize();
     player.setMovementSpeed(150.0f);
     player.setJumpForce(250.0f);
@@ -37,8 +37,8 @@ int main()
     std::vector<std::unique_ptr<Gameplay::Enemy>> enemies;
 
     // Basic patrol enemy
-    auto &patrolEnemy = entityManager.createEntity<Gameplay::Enemy>(
-        entityManager, "resources/ai/patrol_behavior.xml", sf::Vector2f(500.0f, 400.0f));
+    auto &patrolEnemy = *entityManager.createEntity<Gameplay::Enemy>(
+        physics, "resources/ai/patrol_behavior.xml", sf::Vector2f(500.0f, 400.0f));
     patrolEnemy.initialize();
     patrolEnemy.setMovementSpeed(70.0f);
 
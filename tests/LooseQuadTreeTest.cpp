@@ -0,0 +1,136 @@
+#include "Core/LooseQuadTree.hpp"
+#include "TestMain.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using Test::check;
+
+// Checks the loose quadtree against a brute-force search: queries after
+// insertions, moves and removals, and items outside the initial bounds,
+// near ones making the tree grow and far ones kept in the root
+namespace
+{
+    bool overlaps(const sf::FloatRect &a, const sf::FloatRect &b)
+    {
+        return a.position.x < b.position.x + b.size.x && b.position.x < a.position.x + a.size.x &&
+               a.position.y < b.position.y + b.size.y && b.position.y < a.position.y + a.size.y;
+    }
+
+    // Bounds of the items by identifier, and whether each one is in the tree
+    struct Reference
+    {
+        std::vector<sf::FloatRect> bounds;
+        std::vector<bool> present;
+    };
+
+    std::vector<std::uint32_t> queryTree(const Core::LooseQuadTree &tree, const sf::FloatRect &area)
+    {
+        std::vector<std::uint32_t> result;
+        tree.query(area, [&result](std::uint32_t id)
+                   { result.push_back(id); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<std::uint32_t> queryReference(const Reference &reference, const sf::FloatRect &area)
+    {
+        std::vector<std::uint32_t> result;
+        for (std::uint32_t id = 0; id < reference.bounds.size(); ++id)
+        {
+            if (reference.present[id] && overlaps(reference.bounds[id], area))
+            {
+                result.push_back(id);
+            }
+        }
+        return result;
+    }
+
+    // Compare the tree with the brute-force search over many random areas
+    bool matches(const Core::LooseQuadTree &tree, const Reference &reference, std::mt19937 &random,
+                 float minCoordinate, float maxCoordinate)
+    {
+        std::uniform_real_distribution<float> coordinate(minCoordinate, maxCoordinate);
+        std::uniform_real_distribution<float> extent(1.f, (maxCoordinate - minCoordinate) / 4.f);
+        for (int i = 0; i < 500; ++i)
+        {
+            sf::FloatRect area({coordinate(random), coordinate(random)}, {extent(random), extent(random)});
+            if (queryTree(tree, area) != queryReference(reference, area))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    std::mt19937 random(1234);
+    const std::uint32_t count = 2000;
+
+    Core::LooseQuadTree tree(sf::FloatRect({0.f, 0.f}, {1024.f, 1024.f}), 6);
+    Reference reference{std::vector<sf::FloatRect>(count), std::vector<bool>(count, false)};
+
+    std::uniform_real_distribution<float> position(0.f, 1000.f);
+    std::uniform_real_distribution<float> size(1.f, 64.f);
+    auto randomBounds = [&]()
+    { return sf::FloatRect({position(random), position(random)}, {size(random), size(random)}); };
+
+    for (std::uint32_t id = 0; id < count; ++id)
+    {
+        reference.bounds[id] = randomBounds();
+        reference.present[id] = true;
+        tree.insert(id, reference.bounds[id]);
+    }
+    check(tree.size() == count, "Every inserted item is counted");
+    check(matches(tree, reference, random, -100.f, 1100.f), "Queries find the same items as a brute-force search");
+
+    // Move a third of the items and remove another third
+    for (std::uint32_t id = 0; id < count; id += 3)
+    {
+        reference.bounds[id] = randomBounds();
+        tree.insert(id, reference.bounds[id]);
+    }
+    for (std::uint32_t id = 1; id < count; id += 3)
+    {
+        reference.present[id] = false;
+        tree.remove(id);
+    }
+    check(tree.size() == count - (count + 1) / 3, "Moving an item does not add it twice");
+    check(!tree.contains(1) && tree.contains(0), "Removed items are gone, moved ones are kept");
+    check(!tree.remove(1), "Removing an absent item fails");
+    check(matches(tree, reference, random, -100.f, 1100.f), "Queries are right after moves and removals");
+
+    // Items beyond the bounds: the tree grows toward the near ones, and the
+    // far ones stay in the root; both are found
+    std::uint32_t nearId = count;
+    std::uint32_t farId = count + 1;
+    reference.bounds.resize(count + 2);
+    reference.present.resize(count + 2, true);
+    reference.bounds[nearId] = sf::FloatRect({1100.f, 1150.f}, {20.f, 20.f});
+    reference.bounds[farId] = sf::FloatRect({-50000.f, 80000.f}, {10.f, 10.f});
+    tree.insert(nearId, reference.bounds[nearId]);
+    tree.insert(farId, reference.bounds[farId]);
+
+    std::vector<std::uint32_t> nearResult = queryTree(tree, sf::FloatRect({1090.f, 1140.f}, {10.f, 10.f}));
+    check(std::find(nearResult.begin(), nearResult.end(), nearId) != nearResult.end(), "An item just outside the bounds is found");
+    std::vector<std::uint32_t> farResult = queryTree(tree, sf::FloatRect({-50005.f, 80005.f}, {10.f, 10.f}));
+    check(farResult == std::vector<std::uint32_t>{farId}, "An item far outside the bounds is found");
+    check(matches(tree, reference, random, -200.f, 2200.f), "Queries are right after the tree grew");
+
+    // Spread items well beyond the initial bounds
+    std::uniform_real_distribution<float> widePosition(-3000.f, 4000.f);
+    for (std::uint32_t id = 0; id < count; id += 2)
+    {
+        reference.bounds[id] = sf::FloatRect({widePosition(random), widePosition(random)}, {size(random), size(random)});
+        reference.present[id] = true;
+        tree.insert(id, reference.bounds[id]);
+    }
+    check(matches(tree, reference, random, -3500.f, 4500.f), "Queries are right with items spread beyond the bounds");
+
+    tree.clear();
+    check(tree.size() == 0 && queryTree(tree, sf::FloatRect({-1e6f, -1e6f}, {2e6f, 2e6f})).empty(), "Clear removes every item");
+
+    return Test::result();
+}
@@ -0,0 +1,142 @@
+#include "Graphics/RenderQueue.hpp"
+#include "TestMain.hpp"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using Test::check;
+
+// Checks the order in which the render queue draws its items: layers,
+// batching by texture, depth sorting, submission order and the stability
+// of the sort, on a small offscreen target
+namespace
+{
+    // Drawable recording when it is drawn
+    class Marker : public sf::Drawable
+    {
+    public:
+        Marker(int id, std::vector<int> &log) : m_id(id), m_log(log) {}
+
+    private:
+        void draw(sf::RenderTarget &, sf::RenderStates) const override
+        {
+            m_log.push_back(m_id);
+        }
+
+        int m_id;
+        std::vector<int> &m_log;
+    };
+
+    void addMarker(Graphics::RenderQueue &queue, std::vector<int> &log, int id, int layer, float depth = 0.f)
+    {
+        queue.addDrawable(std::make_unique<Marker>(id, log), sf::RenderStates::Default, layer, depth);
+    }
+
+    std::vector<int> drawOrder(Graphics::RenderQueue &queue, sf::RenderTarget &target, std::vector<int> &log)
+    {
+        log.clear();
+        queue.draw(target);
+        return log;
+    }
+}
+
+int main()
+{
+    sf::RenderTexture target({64, 64});
+    std::vector<int> log;
+
+    using LayerOrder = Graphics::RenderQueue::LayerOrder;
+    Graphics::RenderQueue queue;
+    queue.setDepthRange(0.f, 1000.f);
+    queue.setLayerOrder(1, LayerOrder::DepthSorted);
+    queue.setLayerOrder(2, LayerOrder::Submission);
+
+    // Higher layers are drawn on top, negative layers included
+    addMarker(queue, log, 0, 3);
+    addMarker(queue, log, 1, -1);
+    addMarker(queue, log, 2, 0);
+    check(drawOrder(queue, target, log) == std::vector<int>({1, 2, 0}), "Layers are drawn from the lowest up");
+
+    // A depth-sorted layer draws from the top down; a submission layer in
+    // order of addition, whatever the depth
+    queue.clear();
+    addMarker(queue, log, 0, 1, 300.f);
+    addMarker(queue, log, 1, 1, 100.f);
+    addMarker(queue, log, 2, 1, 200.f);
+    addMarker(queue, log, 3, 2, 300.f);
+    addMarker(queue, log, 4, 2, 100.f);
+    addMarker(queue, log, 5, 2, 200.f);
+    check(drawOrder(queue, target, log) == std::vector<int>({1, 2, 0, 3, 4, 5}),
+          "Depth-sorted layers follow the depth, submission layers the order of addition");
+
+    // Items sharing a texture are drawn together in a batched layer
+    queue.clear();
+    sf::Texture first;
+    sf::Texture second;
+    std::vector<sf::Vertex> triangle(3);
+    for (int i = 0; i < 8; ++i)
+    {
+        sf::RenderStates states;
+        states.texture = i % 2 == 0 ? &first : &second;
+        queue.addTriangles(triangle.data(), triangle.size(), states, 0, static_cast<float>(i));
+    }
+    queue.draw(target);
+    check(queue.getItemCount() == 8 && queue.getDrawCallCount() == 2, "Interleaved textures take one draw call each");
+
+    // The same items in a submission layer cannot be merged
+    queue.clear();
+    for (int i = 0; i < 8; ++i)
+    {
+        sf::RenderStates states;
+        states.texture = i % 2 == 0 ? &first : &second;
+        queue.addTriangles(triangle.data(), triangle.size(), states, 2);
+    }
+    queue.draw(target);
+    check(queue.getDrawCallCount() == 8, "Submission layers keep the texture changes");
+
+    // Many items over every kind of layer, depths beyond the range
+    // included: the order matches a stable sort on layer then depth. The
+    // range bounds fall between the depths, which the float scaling could
+    // otherwise round apart from the clamped ones
+    struct Expected
+    {
+        int id;
+        int layer;
+        float depth;
+    };
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> layers(-3, 3);
+    std::uniform_int_distribution<int> depths(-100, 1100);
+    std::vector<Expected> expected;
+    queue.clear();
+    queue.setDepthRange(-0.5f, 1000.5f);
+    for (int id = 0; id < 20000; ++id)
+    {
+        Expected item{id, layers(random), static_cast<float>(depths(random))};
+        addMarker(queue, log, id, item.layer, item.depth);
+
+        // Submission layers ignore the depth, the others clamp it to the range
+        item.depth = item.layer == 2 ? 0.f : std::clamp(item.depth, -0.5f, 1000.5f);
+        expected.push_back(item);
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const Expected &a, const Expected &b)
+                     { return a.layer != b.layer ? a.layer < b.layer : a.depth < b.depth; });
+    std::vector<int> expectedOrder;
+    for (const Expected &item : expected)
+    {
+        expectedOrder.push_back(item.id);
+    }
+    check(drawOrder(queue, target, log) == expectedOrder, "The sort is stable and matches the layer and depth order");
+    check(queue.getDrawCallCount() == expectedOrder.size(), "Each drawable takes its own draw call");
+
+    // Clearing removes the items but keeps the layer orders
+    queue.clear();
+    check(queue.getItemCount() == 0 && drawOrder(queue, target, log).empty() && queue.getDrawCallCount() == 0,
+          "Clear removes every item");
+    check(queue.getLayerOrder(1) == LayerOrder::DepthSorted && queue.getLayerOrder(2) == LayerOrder::Submission &&
+              queue.getLayerOrder(0) == LayerOrder::Batched,
+          "Clear keeps the layer orders");
+
+    return Test::result();
+}
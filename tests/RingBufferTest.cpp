@@ -0,0 +1,79 @@
+#include "Core/RingBuffer.hpp"
+#include "TestMain.hpp"
+#include <cstdint>
+#include <thread>
+
+using Test::check;
+
+// Checks the single-producer single-consumer ring buffer: capacity
+// rounding, full and empty states, wrap-around, and ordering when a
+// producer and a consumer thread run at the same time
+int main()
+{
+    Core::RingBuffer<int> buffer(5);
+    check(buffer.capacity() == 8, "The capacity is rounded up to a power of two");
+    check(buffer.empty(), "A new buffer is empty");
+
+    int value = -1;
+    check(!buffer.pop(value) && value == -1, "Popping an empty buffer fails and leaves the value untouched");
+
+    // Fill it up: the element after the capacity is rejected
+    bool pushed = true;
+    for (int i = 0; i < 8; ++i)
+    {
+        pushed = pushed && buffer.push(i);
+    }
+    check(pushed && buffer.size() == 8, "The buffer holds as many elements as its capacity");
+    check(!buffer.push(8), "A full buffer rejects new elements");
+
+    bool ordered = true;
+    for (int i = 0; i < 8; ++i)
+    {
+        ordered = buffer.pop(value) && value == i && ordered;
+    }
+    check(ordered && buffer.empty(), "Elements come out in the order they were pushed");
+
+    // Push and pop past the end of the storage many times
+    bool wrapped = true;
+    for (int i = 0; i < 1000; ++i)
+    {
+        wrapped = buffer.push(i) && buffer.push(i + 1) && wrapped;
+        int first = -1;
+        int second = -1;
+        wrapped = buffer.pop(first) && buffer.pop(second) && first == i && second == i + 1 && wrapped;
+    }
+    check(wrapped && buffer.empty(), "Indices wrap around the storage");
+
+    // One producer and one consumer thread
+    const std::uint32_t count = 1000000;
+    Core::RingBuffer<std::uint32_t> shared(64);
+    std::thread producer([&shared, count]()
+                         {
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            while (!shared.push(i))
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    bool inOrder = true;
+    std::uint32_t received = 0;
+    while (received < count)
+    {
+        std::uint32_t next = 0;
+        if (shared.pop(next))
+        {
+            inOrder = inOrder && next == received;
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    check(inOrder && shared.empty(), "Elements cross threads without loss, duplication or reordering");
+
+    return Test::result();
+}
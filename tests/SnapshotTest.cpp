@@ -0,0 +1,174 @@
+#include "Core/Snapshot.hpp"
+#include "TestMain.hpp"
+#include <cstring>
+
+using Test::check;
+
+// Saves a small world into a binary snapshot, restores it into another
+// entity manager and checks that entities, components and references
+// between entities come back unchanged
+namespace
+{
+    struct Position : public Core::Component
+    {
+        sf::Vector2f value;
+        float angle = 0.f;
+
+        void save(Core::SnapshotWriter &writer) const
+        {
+            writer.write("value", value);
+            writer.write("angle", angle);
+        }
+
+        void load(Core::SnapshotReader &reader)
+        {
+            reader.read(value);
+            reader.read(angle);
+        }
+    };
+
+    struct Follower : public Core::Component
+    {
+        Core::EntityHandle target;
+        std::string label;
+        std::int32_t priority = 0;
+        bool active = false;
+
+        void save(Core::SnapshotWriter &writer) const
+        {
+            writer.write("target", target);
+            writer.write("label", label);
+            writer.write("priority", priority);
+            writer.write("active", active);
+        }
+
+        void load(Core::SnapshotReader &reader)
+        {
+            reader.read(target);
+            reader.read(label);
+            reader.read(priority);
+            reader.read(active);
+        }
+    };
+
+    std::uint32_t readU32(const std::vector<std::uint8_t> &data, std::size_t offset)
+    {
+        std::uint32_t value = 0;
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        return value;
+    }
+
+    // Offset of the data of the last chunk of a snapshot, after its tag and size
+    std::size_t lastChunkOffset(const std::vector<std::uint8_t> &data)
+    {
+        std::uint32_t chunkCount = readU32(data, 8);
+        std::size_t offset = 12;
+        for (std::uint32_t i = 1; i < chunkCount; ++i)
+        {
+            offset += 8 + readU32(data, offset + 4);
+        }
+        return offset + 8;
+    }
+
+    Core::Entity *findByName(Core::EntityManager &entityManager, const std::string &name)
+    {
+        std::vector<Core::Entity *> entities = entityManager.getEntitiesByName(name);
+        return entities.size() == 1 ? entities.front() : nullptr;
+    }
+}
+
+int main()
+{
+    Core::SnapshotSerializer serializer;
+    serializer.registerComponent<Position>("Position");
+    serializer.registerComponent<Follower>("Follower");
+
+    // Build the world to save; a removed entity leaves a hole in the slots
+    Core::EntityManager source;
+    Core::Entity *leader = source.createEntity("leader");
+    source.removeEntity(source.createEntity("removed")->getHandle());
+    Core::Entity *follower = source.createEntity("follower");
+    Core::Entity *loner = source.createEntity("loner");
+
+    Position &leaderPosition = leader->addComponent<Position>();
+    leaderPosition.value = sf::Vector2f(12.5f, -3.f);
+    leaderPosition.angle = 90.f;
+
+    follower->addComponent<Position>().value = sf::Vector2f(4.f, 8.f);
+    Follower &following = follower->addComponent<Follower>();
+    following.target = leader->getHandle();
+    following.label = "escort";
+    following.priority = -7;
+    following.active = true;
+
+    loner->addComponent<Follower>().label = "alone";
+
+    std::vector<std::uint8_t> data = serializer.save(source);
+    check(!data.empty(), "The world is saved");
+
+    // Restore into a manager whose slots are already partly used, so that
+    // the restored entities get other handles than the saved ones
+    Core::EntityManager target;
+    target.createEntity("existing");
+    check(serializer.load(target, data.data(), data.size()), "The snapshot is restored");
+    check(target.getEntityCount() == 4, "Every saved entity is restored");
+
+    Core::Entity *restoredLeader = findByName(target, "leader");
+    Core::Entity *restoredFollower = findByName(target, "follower");
+    Core::Entity *restoredLoner = findByName(target, "loner");
+    check(restoredLeader && restoredFollower && restoredLoner, "The entities keep their names");
+    check(findByName(target, "removed") == nullptr, "Removed entities are not saved");
+    if (!restoredLeader || !restoredFollower || !restoredLoner)
+    {
+        return 1;
+    }
+
+    const Position *position = restoredLeader->getComponent<Position>();
+    check(position && position->value == sf::Vector2f(12.5f, -3.f) && position->angle == 90.f,
+          "Component fields are restored");
+    check(restoredLeader->getComponent<Follower>() == nullptr, "No component is added to an entity that had none");
+
+    const Follower *restoredFollowing = restoredFollower->getComponent<Follower>();
+    check(restoredFollowing && restoredFollowing->label == "escort" && restoredFollowing->priority == -7 &&
+              restoredFollowing->active,
+          "Strings, integers and booleans are restored");
+    check(restoredFollowing && restoredFollowing->target == restoredLeader->getHandle(),
+          "Entity references are remapped to the restored entities");
+
+    const Follower *lonerFollowing = restoredLoner->getComponent<Follower>();
+    check(lonerFollowing && !lonerFollowing->target.isValid() && restoredLoner->getComponent<Position>() == nullptr,
+          "Invalid references stay invalid");
+
+    // Entity ids are part of the snapshot, so the restored world only saves
+    // identically once restored into a manager laid out the same way
+    Core::EntityManager copy;
+    serializer.load(copy, data.data(), data.size());
+    std::vector<std::uint8_t> copyData = serializer.save(copy);
+    Core::EntityManager secondCopy;
+    serializer.load(secondCopy, copyData.data(), copyData.size());
+    check(serializer.save(secondCopy) == copyData, "A restored world saves to the same snapshot");
+
+    // Truncated data is refused rather than read past its end
+    Core::EntityManager truncated;
+    check(!serializer.load(truncated, data.data(), data.size() / 2), "A truncated snapshot is refused");
+
+    // A component chunk failing after the entities and the other components
+    // were restored: point the first Follower at an entity that does not
+    // exist. Nothing of the snapshot is kept
+    std::vector<std::uint8_t> corrupted = data;
+    std::size_t followers = lastChunkOffset(corrupted);
+    std::size_t owners = followers + sizeof(std::uint32_t) + readU32(corrupted, followers) + sizeof(std::uint32_t);
+    std::uint32_t badOwner = 0xFFFFFFFFu;
+    std::memcpy(corrupted.data() + owners, &badOwner, sizeof(badOwner));
+
+    Core::EntityManager untouched;
+    Core::Entity *existing = untouched.createEntity("existing");
+    existing->addComponent<Position>().value = sf::Vector2f(1.f, 2.f);
+    check(!serializer.load(untouched, corrupted.data(), corrupted.size()), "A corrupted component chunk is refused");
+    check(untouched.getEntityCount() == 1 && untouched.getAllEntities().front() == existing,
+          "A refused snapshot leaves the entity count unchanged");
+    check(untouched.getComponentPool<Position>().size() == 1 && existing->getComponent<Position>()->value == sf::Vector2f(1.f, 2.f),
+          "A refused snapshot leaves no component behind");
+
+    return Test::result();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <iostream>
+
+/**
+ * @brief Checks shared by the standalone tests
+ *
+ * Each test is a main() calling check() for every expectation and
+ * returning result(), non-zero when a check failed, so that ctest
+ * reports it.
+ */
+namespace Test
+{
+    inline int failures = 0;
+
+    /**
+     * @brief Print the result of a check and count it if it failed
+     * @param condition Whether the check passed
+     * @param description What was checked
+     */
+    inline void check(bool condition, const char *description)
+    {
+        std::cout << (condition ? "[ OK ] " : "[FAIL] ") << description << std::endl;
+        if (!condition)
+        {
+            ++failures;
+        }
+    }
+
+    /**
+     * @brief Print the overall result
+     * @return Exit status of the test, 0 when every check passed
+     */
+    inline int result()
+    {
+        std::cout << (failures == 0 ? "All checks passed" : "Some checks failed") << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+}
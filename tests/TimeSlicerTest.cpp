@@ -0,0 +1,171 @@
+#include "Core/EntityManager.hpp"
+#include "Core/TimeSlicer.hpp"
+#include "Core/TransformComponent.hpp"
+#include "Core/TransformSystem.hpp"
+#include "TestMain.hpp"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+using Test::check;
+
+// Checks how the time slicer spreads the updates of far entities over
+// frames: each gets its turn with the time it missed, near entities are
+// updated every frame, and creating or removing entities skips no one
+namespace
+{
+    // Updates received by each entity during one frame
+    struct Frame
+    {
+        std::unordered_map<Core::EntityId, int> updates;
+        std::unordered_map<Core::EntityId, float> elapsed;
+    };
+
+    Frame runFrame(Core::TimeSlicer &slicer, const std::vector<Core::Entity *> &entities, float deltaTime)
+    {
+        Frame frame;
+        slicer.update(entities, deltaTime, [&frame](Core::Entity &entity, float elapsed)
+                      {
+            ++frame.updates[entity.getId()];
+            frame.elapsed[entity.getId()] = elapsed; });
+        return frame;
+    }
+}
+
+int main()
+{
+    const float deltaTime = 1.f / 60.f;
+    Core::EntityManager entityManager;
+
+    // Ten far entities, without a position, and one at the focus
+    std::vector<Core::Entity *> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        entities.push_back(entityManager.createEntity());
+    }
+    Core::Entity *nearEntity = entityManager.createEntity("near");
+    nearEntity->addComponent<Core::TransformComponent>();
+    entities.push_back(nearEntity);
+
+    Core::UpdatePolicy policy;
+    policy.maxEntities = 4;
+    policy.nearRadius = 100.f;
+
+    Core::TimeSlicer slicer;
+    slicer.setPolicy(policy);
+    slicer.setFocus(sf::Vector2f(0.f, 0.f));
+
+    // Four far entities per frame, in turn: five frames make two full
+    // rotations over the ten far entities
+    std::unordered_map<Core::EntityId, int> turns;
+    std::unordered_map<Core::EntityId, int> lastFrame;
+    bool nearEveryFrame = true;
+    bool limitKept = true;
+    bool elapsedRight = true;
+    for (int frameIndex = 0; frameIndex < 5; ++frameIndex)
+    {
+        Frame frame = runFrame(slicer, entities, deltaTime);
+        nearEveryFrame = nearEveryFrame && frame.updates[nearEntity->getId()] == 1;
+        limitKept = limitKept && slicer.getUpdatedCount() == 5 && slicer.getDeferredCount() == 6;
+        for (const auto &[id, count] : frame.updates)
+        {
+            if (id != nearEntity->getId())
+            {
+                turns[id] += count;
+
+                // The time since the entity's own last update, the first frame included
+                int previous = lastFrame.count(id) ? lastFrame[id] : -1;
+                float expected = deltaTime * static_cast<float>(frameIndex - previous);
+                elapsedRight = elapsedRight && std::abs(frame.elapsed[id] - expected) < 1e-5f;
+                lastFrame[id] = frameIndex;
+            }
+        }
+    }
+    check(nearEveryFrame, "Near entities are updated every frame");
+    check(limitKept, "Each frame updates the entity limit of far entities and defers the others");
+    bool twiceEach = turns.size() == 10;
+    for (const auto &[id, count] : turns)
+    {
+        twiceEach = twiceEach && count == 2;
+    }
+    check(twiceEach, "The far entities are updated in turn, each once per rotation");
+    check(elapsedRight, "Each entity receives the time elapsed since its own last update");
+
+    // Entities created between two frames must not shift the turn: with a
+    // fresh rotation, the first frame updates the first four far entities,
+    // and the next frame the following four, whatever was created meanwhile
+    Core::TimeSlicer rotating;
+    rotating.setPolicy(policy);
+    std::vector<Core::Entity *> farEntities(entities.begin(), entities.begin() + 10);
+    runFrame(rotating, farEntities, deltaTime);
+    for (int i = 0; i < 4; ++i)
+    {
+        farEntities.insert(farEntities.begin(), entityManager.createEntity());
+    }
+    Frame afterCreation = runFrame(rotating, farEntities, deltaTime);
+    bool resumed = afterCreation.updates.size() == 4;
+    for (int i = 4; i < 8; ++i)
+    {
+        resumed = resumed && afterCreation.updates.count(entities[i]->getId()) == 1;
+    }
+    check(resumed, "Creating entities does not shift the turn of the others");
+
+    // Removing the next entities in turn moves the turn on to the ones after them
+    for (int i = 0; i < 2; ++i)
+    {
+        Core::Entity *removed = entities[8 + i];
+        farEntities.erase(std::find(farEntities.begin(), farEntities.end(), removed));
+        entityManager.removeEntity(removed->getHandle());
+    }
+    Frame afterRemoval = runFrame(rotating, farEntities, deltaTime);
+    bool newcomersNext = afterRemoval.updates.size() == 4;
+    for (int i = 0; i < 4; ++i)
+    {
+        newcomersNext = newcomersNext && afterRemoval.updates.count(farEntities[i]->getId()) == 1;
+    }
+    check(newcomersNext, "Removing entities skips no one");
+    entities.erase(entities.begin() + 8, entities.begin() + 10);
+
+    // Moving the focus: the entity it reaches is updated at once if new,
+    // the entity it leaves waits for its turns again, and the one it comes
+    // back to is near again after at most one rotation
+    Core::TransformSystem transformSystem(entityManager);
+    Core::Entity *distant = entityManager.createEntity("distant");
+    distant->addComponent<Core::TransformComponent>(sf::Vector2f(1000.f, 0.f));
+    transformSystem.propagate();
+    entities.push_back(distant);
+
+    Core::TimeSlicer following;
+    following.setPolicy(policy);
+    following.setFocus(sf::Vector2f(1000.f, 0.f));
+    Frame atDistant = runFrame(following, entities, deltaTime);
+    check(atDistant.updates[distant->getId()] == 1 && following.getUpdatedCount() == 5 &&
+              following.getDeferredCount() == entities.size() - 5,
+          "A new entity near the focus is updated at once");
+
+    following.setFocus(sf::Vector2f(0.f, 0.f));
+    for (int frameIndex = 0; frameIndex < 3; ++frameIndex)
+    {
+        runFrame(following, entities, deltaTime);
+    }
+    bool backNear = true;
+    int distantUpdates = 0;
+    for (int frameIndex = 0; frameIndex < 3; ++frameIndex)
+    {
+        Frame frame = runFrame(following, entities, deltaTime);
+        backNear = backNear && frame.updates[nearEntity->getId()] == 1 && following.getUpdatedCount() == 5 &&
+                   following.getDeferredCount() == entities.size() - 5;
+        distantUpdates += frame.updates[distant->getId()];
+    }
+    check(backNear, "A far entity the focus reaches is near again within one rotation");
+    check(distantUpdates > 0 && distantUpdates < 3, "A near entity the focus leaves waits for its turns");
+
+    // Without a budget nor a limit, everything is updated every frame
+    slicer.setPolicy(Core::UpdatePolicy());
+    runFrame(slicer, entities, deltaTime);
+    check(slicer.getUpdatedCount() == entities.size() && slicer.getDeferredCount() == 0,
+          "Without limits, every entity is updated");
+
+    return Test::result();
+}